@@ -0,0 +1,630 @@
+/**
+ * @file enigma/batch.c
+ *
+ * This file implements encoding one buffer under many Enigma machine configurations at once.
+ *
+ * Three engines are available, see enigma_batch_set_engine():
+ *
+ * - AVX2: up to ENIGMA_BATCH_LANES configurations are packed into a group, with the wiring of
+ *   every rotor, the reflector, and the plugboard of each configuration copied into a per-lane
+ *   lookup table. Each step of the encoding is then done for the whole group with vector
+ *   instructions, the lookups being gathers into the lane tables.
+ * - SSE4.1: SSE has no gathers, so lanes cannot have tables of their own. Each configuration is
+ *   encoded on its own instead, 16 letters at a time: the rotor positions of the 16 letters are
+ *   stepped first, then every lookup is two byte shuffles into the 26-entry wiring table.
+ * - Scalar: each configuration is encoded with enigma_encode_indices_unchecked(), which uses
+ *   the rotor-order kernels of kernel.c when they are built.
+ *
+ * The rotor-order kernels are faster than either vector engine, so by default configurations
+ * that have one are encoded with it, and the vector engines take the others, such as machines
+ * with custom rotors. Choosing an engine explicitly sends every configuration to it.
+ */
+#include "batch.h"
+
+#include "common.h"
+#include "enigma.h"
+#include "io.h"
+#include "kernel.h"
+#include "rotor.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(ENIGMA_NO_SIMD)
+#define ENIGMA_BATCH_AVX2
+#define ENIGMA_BATCH_SSE41
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Number of letters encoded together by the SSE4.1 engine.
+ */
+#define ENIGMA_BATCH_SSE41_BLOCK 16
+
+/**
+ * @brief Offset of a rotor's forward wiring in a lane table.
+ */
+#define ENIGMA_BATCH_FWD(r) ((r) * 2 * ENIGMA_ALPHA_SIZE)
+
+/**
+ * @brief Offset of a rotor's reverse wiring in a lane table.
+ */
+#define ENIGMA_BATCH_REV(r) (ENIGMA_BATCH_FWD(r) + ENIGMA_ALPHA_SIZE)
+
+/**
+ * @brief Offset of the reflector wiring in a lane table.
+ */
+#define ENIGMA_BATCH_REFLECTOR ENIGMA_BATCH_FWD(ENIGMA_MAX_ROTOR_COUNT)
+
+/**
+ * @brief Offset of the plugboard permutation in a lane table.
+ */
+#define ENIGMA_BATCH_PLUGBOARD (ENIGMA_BATCH_REFLECTOR + ENIGMA_ALPHA_SIZE)
+
+/**
+ * @brief Number of entries in a lane table.
+ */
+#define ENIGMA_BATCH_TABLE_SIZE (ENIGMA_BATCH_PLUGBOARD + ENIGMA_ALPHA_SIZE)
+
+/**
+ * @brief A group of configurations laid out one per lane.
+ *
+ * Rotors that a configuration does not use are filled with identity wiring, so that
+ * three- and four-rotor configurations can share a group. Rotors are tracked by ring offset
+ * (position minus ring setting), with turnover masks to match, so that ring settings need no
+ * work per character.
+ */
+typedef struct {
+    int32_t tables[ENIGMA_BATCH_LANES * ENIGMA_BATCH_TABLE_SIZE]; //!< Lookup table of each lane.
+    int32_t positions[ENIGMA_MAX_ROTOR_COUNT][ENIGMA_BATCH_LANES]; //!< Ring offsets per lane.
+    int32_t turnovers[2][ENIGMA_BATCH_LANES]; //!< Ring turnover masks of rotors 0 and 1 per lane.
+    int     indices[ENIGMA_BATCH_LANES]; //!< Index of each lane's configuration in the batch.
+    int     rotor_count; //!< Largest rotor count in the group.
+} EnigmaBatchGroup;
+
+static int         enigma_batch_engine = ENIGMA_BATCH_ENGINE_AUTO;
+
+ENIGMA_STATIC int  enigma_batch_engine_supported(int);
+ENIGMA_STATIC void enigma_batch_group_init(EnigmaBatchGroup*, const Enigma*, const int*, int);
+
+#ifdef ENIGMA_BATCH_AVX2
+ENIGMA_STATIC void enigma_batch_encode_avx2(EnigmaBatchGroup*, int, const uint8_t*, uint8_t*, int);
+ENIGMA_STATIC void
+enigma_batch_encode_group(Enigma*, const int*, int, const uint8_t*, uint8_t*, int);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE __m256i
+enigma_batch_lookup(const int32_t*, __m256i, int, __m256i);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE __m256i
+enigma_batch_pass(const int32_t*, __m256i, int, __m256i, __m256i);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE __m256i enigma_batch_wrap(__m256i);
+#endif
+
+#ifdef ENIGMA_BATCH_SSE41
+ENIGMA_STATIC void enigma_batch_encode_sse41(Enigma*, const uint8_t*, uint8_t*, int);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE __m128i enigma_batch_lookup_sse41(const __m128i*, __m128i);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE __m128i
+enigma_batch_pass_sse41(const __m128i*, __m128i, __m128i);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE __m128i enigma_batch_wrap_sse41(__m128i);
+#endif
+
+/**
+ * @brief Encode a buffer of letter indices under several configurations at once.
+ *
+ * Every configuration encodes the same input, as if enigma_encode_indices() were called on each
+ * of them in turn, and is left in the state it would have after that call. The result for
+ * `enigmas[n]` is stored at `output[n * length]`.
+ *
+ * @param enigmas The configurations to encode with.
+ * @param count The number of configurations.
+ * @param input The letter indices to encode.
+ * @param output The buffer to store the encoded indices (at least `count * length` entries).
+ * @param length The number of indices to encode.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_batch_encode_indices(
+    Enigma* enigmas, int count, const uint8_t* input, uint8_t* output, int length) {
+    if (!enigmas || count <= 0 || !input || !output || length <= 0) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    for (int n = 0; n < count; n++) {
+        const Enigma* enigma = &enigmas[n];
+        if (enigma->rotor_count < 3 || enigma->rotor_count > ENIGMA_MAX_ROTOR_COUNT
+            || !enigma->reflector) {
+            return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        }
+        for (int r = 0; r < enigma->rotor_count; r++) {
+            if (!enigma->rotors[r]) {
+                return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+            }
+        }
+    }
+
+    for (int i = 0; i < length; i++) {
+        if (input[i] >= ENIGMA_ALPHA_SIZE) {
+            return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        }
+    }
+
+    return enigma_batch_encode_indices_unchecked(enigmas, count, input, output, length);
+}
+
+/**
+ * @brief Encode a buffer of letter indices under several configurations without validating them.
+ *
+ * This is the inner loop of enigma_batch_encode_indices(). The arguments are not checked, so the
+ * caller must make sure that every configuration is complete and that every entry of `input` is
+ * a letter index (0-25).
+ *
+ * @param enigmas The configurations to encode with.
+ * @param count The number of configurations.
+ * @param input The letter indices to encode.
+ * @param output The buffer to store the encoded indices (at least `count * length` entries).
+ * @param length The number of indices to encode.
+ * @return ENIGMA_SUCCESS
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_batch_encode_indices_unchecked(
+    Enigma* enigmas, int count, const uint8_t* input, uint8_t* output, int length) {
+    int engine  = enigma_batch_get_engine();
+    int kernels = enigma_batch_engine == ENIGMA_BATCH_ENGINE_AUTO && enigma_kernel_count() > 0;
+    int pending[ENIGMA_BATCH_LANES];
+    int lanes = 0;
+
+    for (int n = 0; n < count; n++) {
+        uint8_t* out = output + (size_t) n * length;
+
+        // The rotor-order kernels are faster than either vector engine
+        if (engine == ENIGMA_BATCH_ENGINE_SCALAR
+            || (kernels
+                && enigma_kernel_encode_indices(&enigmas[n], input, out, length)
+                       == ENIGMA_SUCCESS)) {
+            if (engine == ENIGMA_BATCH_ENGINE_SCALAR) {
+                enigma_encode_indices_unchecked(&enigmas[n], input, out, length);
+            }
+            continue;
+        }
+
+#ifdef ENIGMA_BATCH_SSE41
+        if (engine == ENIGMA_BATCH_ENGINE_SSE41) {
+            enigma_batch_encode_sse41(&enigmas[n], input, out, length);
+            continue;
+        }
+#endif
+
+#ifdef ENIGMA_BATCH_AVX2
+        pending[lanes++] = n;
+        if (lanes == ENIGMA_BATCH_LANES) {
+            enigma_batch_encode_group(enigmas, pending, lanes, input, output, length);
+            lanes = 0;
+        }
+#endif
+    }
+
+#ifdef ENIGMA_BATCH_AVX2
+    // A lone configuration is faster on the scalar path
+    if (lanes > 1) {
+        enigma_batch_encode_group(enigmas, pending, lanes, input, output, length);
+    } else if (lanes == 1) {
+        enigma_encode_indices_unchecked(
+            &enigmas[pending[0]], input, output + (size_t) pending[0] * length, length);
+    }
+#endif
+
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Get the engine enigma_batch_encode_indices() uses.
+ *
+ * With ENIGMA_BATCH_ENGINE_AUTO, this is the engine used for configurations without a
+ * rotor-order kernel.
+ *
+ * @return The ENIGMA_BATCH_ENGINE_ constant of the engine in use, never
+ * ENIGMA_BATCH_ENGINE_AUTO.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_batch_get_engine(void) {
+    if (enigma_batch_engine != ENIGMA_BATCH_ENGINE_AUTO) {
+        return enigma_batch_engine;
+    }
+    if (enigma_batch_engine_supported(ENIGMA_BATCH_ENGINE_AVX2)) {
+        return ENIGMA_BATCH_ENGINE_AVX2;
+    }
+    if (enigma_batch_engine_supported(ENIGMA_BATCH_ENGINE_SSE41)) {
+        return ENIGMA_BATCH_ENGINE_SSE41;
+    }
+    return ENIGMA_BATCH_ENGINE_SCALAR;
+}
+
+/**
+ * @brief Choose the engine enigma_batch_encode_indices() uses.
+ *
+ * Every engine gives the same results, so this is only useful to compare or test them. With
+ * ENIGMA_BATCH_ENGINE_AUTO, the default, configurations that have a rotor-order kernel are
+ * encoded with it, and the others with the fastest engine the CPU supports; any other engine
+ * encodes every configuration. The engine is global and not synchronized: only change it while
+ * no encoding is in progress.
+ *
+ * @param engine An ENIGMA_BATCH_ENGINE_ constant.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE if the engine is not supported by the CPU or
+ * the build.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_batch_set_engine(int engine) {
+    if (engine != ENIGMA_BATCH_ENGINE_AUTO && !enigma_batch_engine_supported(engine)) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    enigma_batch_engine = engine;
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Get the number of configurations enigma_batch_encode_indices() encodes together.
+ *
+ * @return ENIGMA_BATCH_LANES with the AVX2 engine, 1 otherwise.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_batch_width(void) {
+    return enigma_batch_get_engine() == ENIGMA_BATCH_ENGINE_AVX2 ? ENIGMA_BATCH_LANES : 1;
+}
+
+/**
+ * @brief Check whether an engine can be used.
+ *
+ * @param engine An ENIGMA_BATCH_ENGINE_ constant other than ENIGMA_BATCH_ENGINE_AUTO.
+ * @return 1 if the engine is built and supported by the CPU, 0 otherwise.
+ */
+ENIGMA_STATIC int enigma_batch_engine_supported(int engine) {
+    switch (engine) {
+    case ENIGMA_BATCH_ENGINE_SCALAR:
+        return 1;
+#ifdef ENIGMA_BATCH_SSE41
+    case ENIGMA_BATCH_ENGINE_SSE41:
+        return __builtin_cpu_supports("sse4.1") ? 1 : 0;
+#endif
+#ifdef ENIGMA_BATCH_AVX2
+    case ENIGMA_BATCH_ENGINE_AVX2:
+        return __builtin_cpu_supports("avx2") ? 1 : 0;
+#endif
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Lay out a group of configurations one per lane.
+ *
+ * Lanes past `count` are filled with the last configuration so that every lane does valid
+ * lookups; their results are ignored.
+ *
+ * @param group The group to fill.
+ * @param enigmas The configurations of the batch.
+ * @param indices The index in `enigmas` of each configuration of the group.
+ * @param count The number of configurations (1 to ENIGMA_BATCH_LANES).
+ */
+ENIGMA_STATIC void enigma_batch_group_init(EnigmaBatchGroup* group,
+                                           const Enigma*     enigmas,
+                                           const int*        indices,
+                                           int               count) {
+    group->rotor_count = 3;
+
+    for (int l = 0; l < ENIGMA_BATCH_LANES; l++) {
+        group->indices[l]    = indices[l < count ? l : count - 1];
+        const Enigma* enigma = &enigmas[group->indices[l]];
+        int32_t*      table  = group->tables + l * ENIGMA_BATCH_TABLE_SIZE;
+
+        for (int r = 0; r < ENIGMA_MAX_ROTOR_COUNT; r++) {
+            const EnigmaRotor* rotor = r < enigma->rotor_count ? enigma->rotors[r] : NULL;
+            for (int i = 0; i < ENIGMA_ALPHA_SIZE; i++) {
+                table[ENIGMA_BATCH_FWD(r) + i] = rotor ? rotor->fwd_indices[i] : i;
+                table[ENIGMA_BATCH_REV(r) + i] = rotor ? rotor->rev_indices[i] : i;
+            }
+            group->positions[r][l]
+                = rotor ? (enigma->rotor_indices[r] - enigma->ring_settings[r] + ENIGMA_ALPHA_SIZE)
+                              % ENIGMA_ALPHA_SIZE
+                        : 0;
+        }
+
+        for (int i = 0; i < ENIGMA_ALPHA_SIZE; i++) {
+            table[ENIGMA_BATCH_REFLECTOR + i] = enigma->reflector->indices[i];
+            table[ENIGMA_BATCH_PLUGBOARD + i] = i + enigma->plugboard_offsets[i];
+        }
+
+        group->turnovers[0][l]
+            = enigma_rotor_get_ring_turnovers(enigma->rotors[0], enigma->ring_settings[0]);
+        group->turnovers[1][l]
+            = enigma_rotor_get_ring_turnovers(enigma->rotors[1], enigma->ring_settings[1]);
+        if (enigma->rotor_count > group->rotor_count) {
+            group->rotor_count = enigma->rotor_count;
+        }
+    }
+}
+
+#ifdef ENIGMA_BATCH_AVX2
+
+/**
+ * @brief Encode a group of configurations of a batch with AVX2 and update their rotor positions.
+ *
+ * @param enigmas The configurations of the batch.
+ * @param indices The index in `enigmas` of each configuration of the group.
+ * @param lanes The number of configurations in the group (1 to ENIGMA_BATCH_LANES).
+ * @param input The letter indices to encode.
+ * @param output The output buffer of the batch.
+ * @param length The number of indices to encode.
+ */
+ENIGMA_STATIC void enigma_batch_encode_group(Enigma*        enigmas,
+                                             const int*     indices,
+                                             int            lanes,
+                                             const uint8_t* input,
+                                             uint8_t*       output,
+                                             int            length) {
+    EnigmaBatchGroup group;
+
+    enigma_batch_group_init(&group, enigmas, indices, lanes);
+    enigma_batch_encode_avx2(&group, lanes, input, output, length);
+
+    for (int l = 0; l < lanes; l++) {
+        Enigma* enigma = &enigmas[indices[l]];
+        for (int r = 0; r < 3; r++) {
+            enigma->rotor_indices[r]
+                = (group.positions[r][l] + enigma->ring_settings[r]) % ENIGMA_ALPHA_SIZE;
+        }
+    }
+}
+
+/**
+ * @brief Reduce each lane of a vector holding values from -26 to 51 to 0-25.
+ *
+ * @param v The vector to reduce.
+ * @return The reduced vector.
+ */
+__attribute__((target("avx2"))) ENIGMA_STATIC ENIGMA_ALWAYS_INLINE __m256i
+enigma_batch_wrap(__m256i v) {
+    const __m256i alpha = _mm256_set1_epi32(ENIGMA_ALPHA_SIZE);
+    __m256i       over  = _mm256_cmpgt_epi32(v, _mm256_set1_epi32(ENIGMA_ALPHA_SIZE - 1));
+    __m256i       under = _mm256_cmpgt_epi32(_mm256_setzero_si256(), v);
+    v                   = _mm256_sub_epi32(v, _mm256_and_si256(over, alpha));
+    return _mm256_add_epi32(v, _mm256_and_si256(under, alpha));
+}
+
+/**
+ * @brief Look up each lane of a vector in its lane table.
+ *
+ * @param tables The lane tables of the group.
+ * @param base The offset of each lane's table.
+ * @param offset The offset of the wiring to look up in the lane tables.
+ * @param v The letter index of each lane.
+ * @return The looked up value of each lane.
+ */
+__attribute__((target("avx2"))) ENIGMA_STATIC ENIGMA_ALWAYS_INLINE __m256i
+enigma_batch_lookup(const int32_t* tables, __m256i base, int offset, __m256i v) {
+    v = _mm256_add_epi32(_mm256_add_epi32(base, v), _mm256_set1_epi32(offset));
+    return _mm256_i32gather_epi32((const int*) tables, v, 4);
+}
+
+/**
+ * @brief Pass each lane of a vector through a rotor at the lane's rotor position.
+ *
+ * @param tables The lane tables of the group.
+ * @param base The offset of each lane's table.
+ * @param offset The offset of the rotor wiring in the lane tables.
+ * @param pos The rotor position of each lane.
+ * @param v The letter index of each lane.
+ * @return The letter index of each lane after passing through the rotor.
+ */
+__attribute__((target("avx2"))) ENIGMA_STATIC ENIGMA_ALWAYS_INLINE __m256i
+enigma_batch_pass(const int32_t* tables, __m256i base, int offset, __m256i pos, __m256i v) {
+    v = enigma_batch_wrap(_mm256_add_epi32(v, pos));
+    v = enigma_batch_lookup(tables, base, offset, v);
+    return enigma_batch_wrap(_mm256_sub_epi32(v, pos));
+}
+
+/**
+ * @brief Encode a buffer of letter indices under a group of configurations with AVX2.
+ *
+ * This follows enigma_encode_idx() step by step, with one configuration per lane. The final
+ * rotor positions are stored back into the group.
+ *
+ * @param group The group of configurations.
+ * @param lanes The number of lanes holding a configuration whose result is wanted.
+ * @param input The letter indices to encode.
+ * @param output The output buffer of the batch; each lane's `length` encoded indices are stored
+ * at the offset of its configuration.
+ * @param length The number of indices to encode.
+ */
+__attribute__((target("avx2"))) ENIGMA_STATIC void enigma_batch_encode_avx2(
+    EnigmaBatchGroup* group, int lanes, const uint8_t* input, uint8_t* output, int length) {
+    const int32_t* tables = group->tables;
+    const __m256i  one    = _mm256_set1_epi32(1);
+    const __m256i  base   = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                            _mm256_set1_epi32(ENIGMA_BATCH_TABLE_SIZE));
+    const __m256i  turnovers0 = _mm256_loadu_si256((const __m256i*) group->turnovers[0]);
+    const __m256i  turnovers1 = _mm256_loadu_si256((const __m256i*) group->turnovers[1]);
+    const int      fourRotors = group->rotor_count == 4;
+
+    __m256i pos0 = _mm256_loadu_si256((const __m256i*) group->positions[0]);
+    __m256i pos1 = _mm256_loadu_si256((const __m256i*) group->positions[1]);
+    __m256i pos2 = _mm256_loadu_si256((const __m256i*) group->positions[2]);
+    __m256i pos3 = _mm256_loadu_si256((const __m256i*) group->positions[3]);
+    int32_t result[ENIGMA_BATCH_LANES];
+
+    for (int i = 0; i < length; i++) {
+        // Step: rotor 1 at its turnover double steps, otherwise rotor 0 at its turnover steps it
+        __m256i doubleStep = _mm256_and_si256(_mm256_srlv_epi32(turnovers1, pos1), one);
+        __m256i step       = _mm256_and_si256(_mm256_srlv_epi32(turnovers0, pos0), one);
+        pos2               = enigma_batch_wrap(_mm256_add_epi32(pos2, doubleStep));
+        pos1 = enigma_batch_wrap(_mm256_add_epi32(pos1, _mm256_or_si256(doubleStep, step)));
+        pos0 = enigma_batch_wrap(_mm256_add_epi32(pos0, one));
+
+        __m256i c = _mm256_set1_epi32(input[i]);
+        c         = enigma_batch_lookup(tables, base, ENIGMA_BATCH_PLUGBOARD, c);
+        c         = enigma_batch_pass(tables, base, ENIGMA_BATCH_FWD(0), pos0, c);
+        c         = enigma_batch_pass(tables, base, ENIGMA_BATCH_FWD(1), pos1, c);
+        c         = enigma_batch_pass(tables, base, ENIGMA_BATCH_FWD(2), pos2, c);
+        if (fourRotors) {
+            c = enigma_batch_pass(tables, base, ENIGMA_BATCH_FWD(3), pos3, c);
+        }
+        c = enigma_batch_lookup(tables, base, ENIGMA_BATCH_REFLECTOR, c);
+        if (fourRotors) {
+            c = enigma_batch_pass(tables, base, ENIGMA_BATCH_REV(3), pos3, c);
+        }
+        c = enigma_batch_pass(tables, base, ENIGMA_BATCH_REV(2), pos2, c);
+        c = enigma_batch_pass(tables, base, ENIGMA_BATCH_REV(1), pos1, c);
+        c = enigma_batch_pass(tables, base, ENIGMA_BATCH_REV(0), pos0, c);
+        c = enigma_batch_lookup(tables, base, ENIGMA_BATCH_PLUGBOARD, c);
+
+        _mm256_storeu_si256((__m256i*) result, c);
+        for (int l = 0; l < lanes; l++) {
+            output[(size_t) group->indices[l] * length + i] = result[l];
+        }
+    }
+
+    _mm256_storeu_si256((__m256i*) group->positions[0], pos0);
+    _mm256_storeu_si256((__m256i*) group->positions[1], pos1);
+    _mm256_storeu_si256((__m256i*) group->positions[2], pos2);
+}
+
+#endif
+
+#ifdef ENIGMA_BATCH_SSE41
+
+/**
+ * @brief Reduce each byte of a vector holding values from -26 to 51 to 0-25.
+ *
+ * @param v The vector to reduce.
+ * @return The reduced vector.
+ */
+__attribute__((target("sse4.1"))) ENIGMA_STATIC ENIGMA_ALWAYS_INLINE __m128i
+enigma_batch_wrap_sse41(__m128i v) {
+    const __m128i alpha = _mm_set1_epi8(ENIGMA_ALPHA_SIZE);
+    __m128i       over  = _mm_cmpgt_epi8(v, _mm_set1_epi8(ENIGMA_ALPHA_SIZE - 1));
+    __m128i       under = _mm_cmpgt_epi8(_mm_setzero_si128(), v);
+    v                   = _mm_sub_epi8(v, _mm_and_si128(over, alpha));
+    return _mm_add_epi8(v, _mm_and_si128(under, alpha));
+}
+
+/**
+ * @brief Look up each byte of a vector in a 26-entry table.
+ *
+ * @param table The table, as two vectors holding entries 0-15 and 16-31.
+ * @param v The letter index of each byte.
+ * @return The looked up value of each byte.
+ */
+__attribute__((target("sse4.1"))) ENIGMA_STATIC ENIGMA_ALWAYS_INLINE __m128i
+enigma_batch_lookup_sse41(const __m128i* table, __m128i v) {
+    __m128i low  = _mm_shuffle_epi8(table[0], v);
+    __m128i high = _mm_shuffle_epi8(table[1], _mm_sub_epi8(v, _mm_set1_epi8(16)));
+    return _mm_blendv_epi8(low, high, _mm_cmpgt_epi8(v, _mm_set1_epi8(15)));
+}
+
+/**
+ * @brief Pass each byte of a vector through a rotor at the byte's rotor position.
+ *
+ * @param table The rotor wiring, as for enigma_batch_lookup_sse41().
+ * @param pos The rotor position of each byte.
+ * @param v The letter index of each byte.
+ * @return The letter index of each byte after passing through the rotor.
+ */
+__attribute__((target("sse4.1"))) ENIGMA_STATIC ENIGMA_ALWAYS_INLINE __m128i
+enigma_batch_pass_sse41(const __m128i* table, __m128i pos, __m128i v) {
+    v = enigma_batch_wrap_sse41(_mm_add_epi8(v, pos));
+    v = enigma_batch_lookup_sse41(table, v);
+    return enigma_batch_wrap_sse41(_mm_sub_epi8(v, pos));
+}
+
+/**
+ * @brief Encode a buffer of letter indices under one configuration with SSE4.1.
+ *
+ * The rotors are stepped for a block of letters first, as in enigma_batch_encode_avx2(), and
+ * every letter of the block is then encoded at its own rotor positions at once. The final rotor
+ * positions are stored back into `enigma`.
+ *
+ * @param enigma The configuration.
+ * @param input The letter indices to encode.
+ * @param output The buffer to store the encoded indices (`length` entries).
+ * @param length The number of indices to encode.
+ */
+__attribute__((target("sse4.1"))) ENIGMA_STATIC void
+enigma_batch_encode_sse41(Enigma* enigma, const uint8_t* input, uint8_t* output, int length) {
+    uint8_t tables[ENIGMA_BATCH_TABLE_SIZE / ENIGMA_ALPHA_SIZE][32] = { { 0 } };
+    __m128i wiring[ENIGMA_BATCH_TABLE_SIZE / ENIGMA_ALPHA_SIZE][2];
+    int     offsets[ENIGMA_MAX_ROTOR_COUNT] = { 0 };
+    int     rotorCount                      = enigma->rotor_count;
+
+    // Lay the wiring out as in a lane table of the AVX2 engine, one table per row
+    for (int r = 0; r < rotorCount; r++) {
+        for (int i = 0; i < ENIGMA_ALPHA_SIZE; i++) {
+            tables[ENIGMA_BATCH_FWD(r) / ENIGMA_ALPHA_SIZE][i] = enigma->rotors[r]->fwd_indices[i];
+            tables[ENIGMA_BATCH_REV(r) / ENIGMA_ALPHA_SIZE][i] = enigma->rotors[r]->rev_indices[i];
+        }
+        offsets[r] = (enigma->rotor_indices[r] - enigma->ring_settings[r] + ENIGMA_ALPHA_SIZE)
+                   % ENIGMA_ALPHA_SIZE;
+    }
+    for (int i = 0; i < ENIGMA_ALPHA_SIZE; i++) {
+        tables[ENIGMA_BATCH_REFLECTOR / ENIGMA_ALPHA_SIZE][i] = enigma->reflector->indices[i];
+        tables[ENIGMA_BATCH_PLUGBOARD / ENIGMA_ALPHA_SIZE][i] = i + enigma->plugboard_offsets[i];
+    }
+    for (size_t t = 0; t < sizeof(tables) / sizeof(tables[0]); t++) {
+        wiring[t][0] = _mm_loadu_si128((const __m128i*) tables[t]);
+        wiring[t][1] = _mm_loadu_si128((const __m128i*) (tables[t] + 16));
+    }
+
+    const __m128i* plugboard  = wiring[ENIGMA_BATCH_PLUGBOARD / ENIGMA_ALPHA_SIZE];
+    const __m128i* reflector  = wiring[ENIGMA_BATCH_REFLECTOR / ENIGMA_ALPHA_SIZE];
+    const __m128i  pos3       = _mm_set1_epi8(offsets[3]);
+    uint32_t       turnovers0 = enigma_rotor_get_ring_turnovers(enigma->rotors[0],
+                                                          enigma->ring_settings[0]);
+    uint32_t       turnovers1 = enigma_rotor_get_ring_turnovers(enigma->rotors[1],
+                                                          enigma->ring_settings[1]);
+
+    for (int start = 0; start < length; start += ENIGMA_BATCH_SSE41_BLOCK) {
+        uint8_t positions[3][ENIGMA_BATCH_SSE41_BLOCK] = { { 0 } };
+        uint8_t block[ENIGMA_BATCH_SSE41_BLOCK]        = { 0 };
+        int     count                                  = length - start;
+        if (count > ENIGMA_BATCH_SSE41_BLOCK) {
+            count = ENIGMA_BATCH_SSE41_BLOCK;
+        }
+
+        // Step: rotor 1 at its turnover double steps, otherwise rotor 0 at its turnover steps it
+        for (int i = 0; i < count; i++) {
+            int doubleStep = turnovers1 >> offsets[1] & 1;
+            int step       = turnovers0 >> offsets[0] & 1;
+            offsets[2]     = (offsets[2] + doubleStep) % ENIGMA_ALPHA_SIZE;
+            offsets[1]     = (offsets[1] + (doubleStep | step)) % ENIGMA_ALPHA_SIZE;
+            offsets[0]     = (offsets[0] + 1) % ENIGMA_ALPHA_SIZE;
+            for (int r = 0; r < 3; r++) {
+                positions[r][i] = offsets[r];
+            }
+            block[i] = input[start + i];
+        }
+
+        __m128i pos0 = _mm_loadu_si128((const __m128i*) positions[0]);
+        __m128i pos1 = _mm_loadu_si128((const __m128i*) positions[1]);
+        __m128i pos2 = _mm_loadu_si128((const __m128i*) positions[2]);
+        __m128i c    = _mm_loadu_si128((const __m128i*) block);
+
+        c = enigma_batch_lookup_sse41(plugboard, c);
+        c = enigma_batch_pass_sse41(wiring[ENIGMA_BATCH_FWD(0) / ENIGMA_ALPHA_SIZE], pos0, c);
+        c = enigma_batch_pass_sse41(wiring[ENIGMA_BATCH_FWD(1) / ENIGMA_ALPHA_SIZE], pos1, c);
+        c = enigma_batch_pass_sse41(wiring[ENIGMA_BATCH_FWD(2) / ENIGMA_ALPHA_SIZE], pos2, c);
+        if (rotorCount == 4) {
+            c = enigma_batch_pass_sse41(wiring[ENIGMA_BATCH_FWD(3) / ENIGMA_ALPHA_SIZE], pos3, c);
+        }
+        c = enigma_batch_lookup_sse41(reflector, c);
+        if (rotorCount == 4) {
+            c = enigma_batch_pass_sse41(wiring[ENIGMA_BATCH_REV(3) / ENIGMA_ALPHA_SIZE], pos3, c);
+        }
+        c = enigma_batch_pass_sse41(wiring[ENIGMA_BATCH_REV(2) / ENIGMA_ALPHA_SIZE], pos2, c);
+        c = enigma_batch_pass_sse41(wiring[ENIGMA_BATCH_REV(1) / ENIGMA_ALPHA_SIZE], pos1, c);
+        c = enigma_batch_pass_sse41(wiring[ENIGMA_BATCH_REV(0) / ENIGMA_ALPHA_SIZE], pos0, c);
+        c = enigma_batch_lookup_sse41(plugboard, c);
+
+        _mm_storeu_si128((__m128i*) block, c);
+        for (int i = 0; i < count; i++) {
+            output[start + i] = block[i];
+        }
+    }
+
+    for (int r = 0; r < 3; r++) {
+        enigma->rotor_indices[r] = (offsets[r] + enigma->ring_settings[r]) % ENIGMA_ALPHA_SIZE;
+    }
+}
+
+#endif
@@ -0,0 +1,48 @@
+/**
+ * @file enigma/batch.h
+ *
+ * This file declares functions for encoding one buffer under many Enigma machine
+ * configurations at once, with each configuration mapped to a SIMD lane where supported.
+ */
+#ifndef ENIGMA_BATCH_H
+#define ENIGMA_BATCH_H
+
+#include "enigma.h"
+
+#include <stdint.h>
+
+/**
+ * @brief Number of configurations encoded together by the vector kernel.
+ *
+ * This is the number of 32-bit lanes in an AVX2 register.
+ */
+#define ENIGMA_BATCH_LANES 8
+
+/**
+ * @brief Use the rotor-order kernels where they exist, and the fastest engine the CPU supports
+ * elsewhere.
+ */
+#define ENIGMA_BATCH_ENGINE_AUTO 0
+
+/**
+ * @brief Encode each configuration on its own with enigma_encode_indices_unchecked().
+ */
+#define ENIGMA_BATCH_ENGINE_SCALAR 1
+
+/**
+ * @brief Encode each configuration on its own, 16 letters at a time with SSE4.1 shuffles.
+ */
+#define ENIGMA_BATCH_ENGINE_SSE41 2
+
+/**
+ * @brief Encode ENIGMA_BATCH_LANES configurations together with AVX2 gathers.
+ */
+#define ENIGMA_BATCH_ENGINE_AVX2 3
+
+int enigma_batch_encode_indices(Enigma*, int, const uint8_t*, uint8_t*, int);
+int enigma_batch_encode_indices_unchecked(Enigma*, int, const uint8_t*, uint8_t*, int);
+int enigma_batch_get_engine(void);
+int enigma_batch_set_engine(int);
+int enigma_batch_width(void);
+
+#endif
@@ -19,3 +19,39 @@
 EMSCRIPTEN_KEEPALIVE float enigma_brute_score(const EnigmaCrackParams* cfg, const char* text) {
     return (float) enigma_dict_match(cfg, text);
 }
+
+/**
+ * @brief Calculate the brute force dictionary score of letter indices.
+ *
+ * This is the index-domain counterpart of enigma_brute_score().
+ *
+ * @param cfg The configuration parameters for the Enigma machine.
+ * @param text The letter indices to be scored.
+ * @return The score of the text. It will be 1.0 if two dictionary words exist in the plaintext,
+ *         and 0.0 otherwise.
+ */
+EMSCRIPTEN_KEEPALIVE float enigma_brute_score_indices(const EnigmaCrackParams* cfg,
+                                                      const uint8_t*           text) {
+    return (float) enigma_dict_match_indices(cfg, text);
+}
+
+/**
+ * @brief Calculate the brute force dictionary score of several candidates' letter indices.
+ *
+ * This is the batch counterpart of enigma_brute_score_indices().
+ *
+ * @param cfg The configuration parameters for the Enigma machine.
+ * @param texts The letter indices of each candidate, `ciphertext_length` apart.
+ * @param count The number of candidates.
+ * @param scores Set to the score of each candidate.
+ */
+EMSCRIPTEN_KEEPALIVE void enigma_brute_score_batch(const EnigmaCrackParams* cfg,
+                                                   const uint8_t*           texts,
+                                                   int                      count,
+                                                   float*                   scores) {
+    size_t len = cfg->ciphertext_length;
+
+    for (int i = 0; i < count; i++) {
+        scores[i] = (float) enigma_dict_match_indices(cfg, texts + i * len);
+    }
+}
@@ -10,5 +10,7 @@
 #include "crack.h"
 
 float enigma_brute_score(const EnigmaCrackParams*, const char*);
+float enigma_brute_score_indices(const EnigmaCrackParams*, const uint8_t*);
+void  enigma_brute_score_batch(const EnigmaCrackParams*, const uint8_t*, int, float*);
 
 #endif
@@ -0,0 +1,398 @@
+/**
+ * @file enigma/checkpoint.c
+ *
+ * This file implements checkpoints for crack function calls.
+ *
+ * A checkpoint file holds a header, one byte per range of the search (1 if it was completed),
+ * and the scores of the completed ranges. It is written to a temporary file that is then renamed
+ * over the previous checkpoint, so a process killed while saving leaves the previous checkpoint
+ * intact.
+ *
+ * Every field is written in native byte order. A file saved on a machine of the other byte order
+ * reads back with a byte-swapped version, so it is rejected instead of being misread.
+ */
+#include "checkpoint.h"
+
+#include "common.h"
+#include "enigma.h"
+#include "io.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Header of a checkpoint file.
+ */
+typedef struct {
+    char     magic[8]; //!< ENIGMA_CHECKPOINT_MAGIC, without its terminator.
+    uint32_t version; //!< ENIGMA_CHECKPOINT_VERSION.
+    int32_t  top_k; //!< top_k of the saved scores.
+    uint64_t fingerprint; //!< Identifies the search.
+    uint64_t size; //!< Number of candidates of the search.
+    uint64_t range_size; //!< Number of candidates per range.
+    uint64_t score_count; //!< Number of saved scores.
+} EnigmaCheckpointHeader;
+
+/**
+ * @brief A score as saved in a checkpoint file.
+ */
+typedef struct {
+    EnigmaKey key; //!< The scored configuration.
+    float     score; //!< The score.
+    int32_t   flags; //!< The score flags.
+} EnigmaCheckpointScore;
+
+ENIGMA_STATIC int enigma_checkpoint_read(EnigmaCheckpoint*, FILE*);
+ENIGMA_STATIC int enigma_checkpoint_write(EnigmaCheckpoint*);
+
+/**
+ * @brief Create an empty checkpoint.
+ *
+ * @param path The file to save the checkpoint to.
+ * @param interval The minimum number of seconds between saves (0 to save after every range).
+ * @return Pointer to the new checkpoint, or NULL on failure.
+ */
+EMSCRIPTEN_KEEPALIVE EnigmaCheckpoint* enigma_checkpoint_new(const char* path, int interval) {
+    if (!path || interval < 0) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return NULL;
+    }
+
+    EnigmaCheckpoint* checkpoint = calloc(1, sizeof(EnigmaCheckpoint));
+    if (!checkpoint) {
+        ENIGMA_ERROR("%s", "Failed to allocate checkpoint");
+        return NULL;
+    }
+
+    checkpoint->path = malloc(strlen(path) + 1);
+    if (!checkpoint->path) {
+        free(checkpoint);
+        ENIGMA_ERROR("%s", "Failed to allocate checkpoint");
+        return NULL;
+    }
+    strcpy(checkpoint->path, path);
+    checkpoint->interval = interval;
+    checkpoint->saved_at = time(NULL);
+    pthread_mutex_init(&checkpoint->mutex, NULL);
+    return checkpoint;
+}
+
+/**
+ * @brief Load a checkpoint saved by an interrupted search.
+ *
+ * The checkpoint is saved back to the same file as the search goes on.
+ *
+ * @param path The file to load the checkpoint from.
+ * @param interval The minimum number of seconds between saves (0 to save after every range).
+ * @return Pointer to the loaded checkpoint, or NULL on failure.
+ */
+EMSCRIPTEN_KEEPALIVE EnigmaCheckpoint* enigma_checkpoint_load(const char* path, int interval) {
+    EnigmaCheckpoint* checkpoint = enigma_checkpoint_new(path, interval);
+    if (!checkpoint) {
+        return NULL;
+    }
+
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        enigma_checkpoint_free(checkpoint);
+        ENIGMA_ERROR("Failed to open checkpoint: %s", path);
+        return NULL;
+    }
+
+    int ret = enigma_checkpoint_read(checkpoint, file);
+    fclose(file);
+    if (ret) {
+        enigma_checkpoint_free(checkpoint);
+        ENIGMA_ERROR("Invalid checkpoint: %s", path);
+        return NULL;
+    }
+    return checkpoint;
+}
+
+/**
+ * @brief Free a checkpoint. The checkpoint file is left in place.
+ *
+ * @param checkpoint The checkpoint to free.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_checkpoint_free(EnigmaCheckpoint* checkpoint) {
+    if (!checkpoint) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    pthread_mutex_destroy(&checkpoint->mutex);
+    free(checkpoint->path);
+    free(checkpoint->done);
+    free(checkpoint->scores.scores);
+    free(checkpoint);
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Start or resume a search with a checkpoint.
+ *
+ * An empty checkpoint is set up for the search. A loaded checkpoint must come from a search
+ * with the same candidates, i.e. the same crack function and parameters: the fingerprint, size
+ * and range size must match those it was saved with.
+ *
+ * @param checkpoint The checkpoint.
+ * @param fingerprint A hash of everything that decides the candidates and scores of the search.
+ * @param size The number of candidates of the search.
+ * @param rangeSize The number of candidates per range (at least 1).
+ * @param topK The number of best scores to keep, or 0 to keep every score.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int
+enigma_checkpoint_begin(EnigmaCheckpoint* checkpoint,
+                        uint64_t          fingerprint,
+                        size_t            size,
+                        size_t            rangeSize,
+                        int               topK) {
+    if (!checkpoint || rangeSize < 1 || topK < 0) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    if (checkpoint->done) {
+        if (checkpoint->fingerprint != fingerprint || checkpoint->size != size
+            || checkpoint->range_size != rangeSize) {
+            return ENIGMA_ERROR("%s", "Checkpoint does not match this search");
+        }
+        return enigma_score_list_set_top_k(&checkpoint->scores, topK);
+    }
+
+    checkpoint->fingerprint = fingerprint;
+    checkpoint->size        = size;
+    checkpoint->range_size  = rangeSize;
+    checkpoint->range_count = (size + rangeSize - 1) / rangeSize;
+    checkpoint->done_count  = 0;
+    checkpoint->done        = calloc(checkpoint->range_count ? checkpoint->range_count : 1, 1);
+    if (!checkpoint->done) {
+        return ENIGMA_ERROR("%s", "Failed to allocate checkpoint");
+    }
+    checkpoint->scores.top_k = topK;
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Record the scores of a range, and save the checkpoint if it is due.
+ *
+ * This is safe to call from several threads at once.
+ *
+ * @param checkpoint The checkpoint.
+ * @param range The index of the range.
+ * @param scores The scores found in the range. They are moved to the checkpoint, leaving the
+ * list empty.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int
+enigma_checkpoint_complete(EnigmaCheckpoint* checkpoint, size_t range, EnigmaScoreList* scores) {
+    if (!checkpoint || !checkpoint->done || !scores || range >= checkpoint->range_count) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    int ret = ENIGMA_SUCCESS;
+    pthread_mutex_lock(&checkpoint->mutex);
+    for (int i = 0; i < scores->score_count && ret == ENIGMA_SUCCESS; i++) {
+        ret = enigma_score_list_push(&checkpoint->scores, &scores->scores[i]);
+    }
+    scores->score_count = 0;
+
+    if (!checkpoint->done[range]) {
+        checkpoint->done[range] = 1;
+        checkpoint->done_count++;
+    }
+    if (ret == ENIGMA_SUCCESS && time(NULL) - checkpoint->saved_at >= checkpoint->interval) {
+        ret = enigma_checkpoint_write(checkpoint);
+    }
+    pthread_mutex_unlock(&checkpoint->mutex);
+    return ret;
+}
+
+/**
+ * @brief Check whether a range was completed.
+ *
+ * Ranges are only marked as completed by the worker that ran them, so this can be called
+ * without a lock for a range that the caller is about to run.
+ *
+ * @param checkpoint The checkpoint.
+ * @param range The index of the range.
+ * @return 1 if the range was completed, 0 if not, or ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_checkpoint_is_done(const EnigmaCheckpoint* checkpoint,
+                                                   size_t                  range) {
+    if (!checkpoint || !checkpoint->done || range >= checkpoint->range_count) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    return checkpoint->done[range];
+}
+
+/**
+ * @brief Save a checkpoint to its file now.
+ *
+ * @param checkpoint The checkpoint.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_checkpoint_save(EnigmaCheckpoint* checkpoint) {
+    if (!checkpoint || !checkpoint->done) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    pthread_mutex_lock(&checkpoint->mutex);
+    int ret = enigma_checkpoint_write(checkpoint);
+    pthread_mutex_unlock(&checkpoint->mutex);
+    return ret;
+}
+
+/**
+ * @brief Get the number of completed ranges of a checkpoint.
+ *
+ * @param checkpoint The checkpoint.
+ * @return The number of completed ranges, or 0 if checkpoint is NULL.
+ */
+EMSCRIPTEN_KEEPALIVE size_t enigma_checkpoint_get_done_count(const EnigmaCheckpoint* checkpoint) {
+    if (!checkpoint) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return 0;
+    }
+
+    return checkpoint->done_count;
+}
+
+/**
+ * @brief Get the number of ranges of the search of a checkpoint.
+ *
+ * @param checkpoint The checkpoint.
+ * @return The number of ranges (0 before the search starts), or 0 if checkpoint is NULL.
+ */
+EMSCRIPTEN_KEEPALIVE size_t enigma_checkpoint_get_range_count(const EnigmaCheckpoint* checkpoint) {
+    if (!checkpoint) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return 0;
+    }
+
+    return checkpoint->range_count;
+}
+
+/**
+ * @brief Get the scores of the completed ranges of a checkpoint.
+ *
+ * @param checkpoint The checkpoint.
+ * @return The scores, or NULL if checkpoint is NULL.
+ */
+EMSCRIPTEN_KEEPALIVE const EnigmaScoreList*
+enigma_checkpoint_get_scores(const EnigmaCheckpoint* checkpoint) {
+    if (!checkpoint) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return NULL;
+    }
+
+    return &checkpoint->scores;
+}
+
+/**
+ * @brief Read the ranges and scores of a checkpoint file into an empty checkpoint.
+ *
+ * @param checkpoint The checkpoint to fill.
+ * @param file The checkpoint file.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE if the file is not a valid checkpoint.
+ */
+ENIGMA_STATIC int enigma_checkpoint_read(EnigmaCheckpoint* checkpoint, FILE* file) {
+    EnigmaCheckpointHeader header;
+    EnigmaCheckpointScore  saved;
+    EnigmaScore            score;
+
+    if (fread(&header, sizeof(header), 1, file) != 1
+        || memcmp(header.magic, ENIGMA_CHECKPOINT_MAGIC, sizeof(header.magic))
+        || header.version != ENIGMA_CHECKPOINT_VERSION || header.range_size < 1
+        || header.top_k < 0) {
+        return ENIGMA_FAILURE;
+    }
+
+    checkpoint->fingerprint = header.fingerprint;
+    checkpoint->size        = header.size;
+    checkpoint->range_size  = header.range_size;
+    checkpoint->range_count = (header.size + header.range_size - 1) / header.range_size;
+    checkpoint->done        = calloc(checkpoint->range_count ? checkpoint->range_count : 1, 1);
+    if (!checkpoint->done
+        || fread(checkpoint->done, 1, checkpoint->range_count, file) != checkpoint->range_count) {
+        return ENIGMA_FAILURE;
+    }
+    for (size_t i = 0; i < checkpoint->range_count; i++) {
+        checkpoint->done_count += checkpoint->done[i] != 0;
+    }
+
+    checkpoint->scores.top_k = header.top_k;
+    for (uint64_t i = 0; i < header.score_count; i++) {
+        if (fread(&saved, sizeof(saved), 1, file) != 1
+            || enigma_key_to_enigma(&saved.key, &score.enigma)) {
+            return ENIGMA_FAILURE;
+        }
+        score.score = saved.score;
+        score.flags = saved.flags;
+        if (enigma_score_list_push(&checkpoint->scores, &score)) {
+            return ENIGMA_FAILURE;
+        }
+    }
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Write a checkpoint to a temporary file and move it over the checkpoint file.
+ *
+ * The caller must hold the checkpoint's mutex.
+ *
+ * @param checkpoint The checkpoint.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+ENIGMA_STATIC int enigma_checkpoint_write(EnigmaCheckpoint* checkpoint) {
+    EnigmaCheckpointHeader header;
+    EnigmaCheckpointScore  saved;
+    size_t                 length = strlen(checkpoint->path);
+    char*                  tmp    = malloc(length + 5);
+    if (!tmp) {
+        return ENIGMA_ERROR("%s", "Failed to allocate checkpoint path");
+    }
+    memcpy(tmp, checkpoint->path, length);
+    memcpy(tmp + length, ".tmp", 5);
+
+    FILE* file = fopen(tmp, "wb");
+    if (!file) {
+        free(tmp);
+        return ENIGMA_ERROR("Failed to open checkpoint: %s", checkpoint->path);
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, ENIGMA_CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version     = ENIGMA_CHECKPOINT_VERSION;
+    header.top_k       = checkpoint->scores.top_k;
+    header.fingerprint = checkpoint->fingerprint;
+    header.size        = checkpoint->size;
+    header.range_size  = checkpoint->range_size;
+    header.score_count = checkpoint->scores.score_count;
+
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1
+          && fwrite(checkpoint->done, 1, checkpoint->range_count, file)
+                 == checkpoint->range_count;
+    for (int i = 0; ok && i < checkpoint->scores.score_count; i++) {
+        const EnigmaScore* score = &checkpoint->scores.scores[i];
+        memset(&saved, 0, sizeof(saved));
+        saved.score = score->score;
+        saved.flags = score->flags;
+        ok          = !enigma_key_from_enigma(&saved.key, &score->enigma)
+           && fwrite(&saved, sizeof(saved), 1, file) == 1;
+    }
+
+    ok = !fclose(file) && ok && !rename(tmp, checkpoint->path);
+    if (!ok) {
+        remove(tmp);
+    }
+    free(tmp);
+    if (!ok) {
+        return ENIGMA_ERROR("Failed to save checkpoint: %s", checkpoint->path);
+    }
+
+    checkpoint->saved_at = time(NULL);
+    return ENIGMA_SUCCESS;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file enigma/checkpoint.h
+ *
+ * This file declares checkpoints, which save the progress of a crack function call to a file so
+ * that an interrupted search can be resumed.
+ */
+#ifndef ENIGMA_CHECKPOINT_H
+#define ENIGMA_CHECKPOINT_H
+
+#include "score.h"
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * @brief Identifies a checkpoint file.
+ */
+#define ENIGMA_CHECKPOINT_MAGIC "ENIGMACP"
+
+/**
+ * @brief Version of the checkpoint file format.
+ */
+#define ENIGMA_CHECKPOINT_VERSION 2
+
+/**
+ * @struct EnigmaCheckpoint
+ * @brief The keyspace ranges a search has completed, and the scores found in them.
+ *
+ * A checkpoint belongs to one crack function call. Calling the same crack function again with
+ * the same parameters and a checkpoint loaded with enigma_checkpoint_load() skips the ranges
+ * that were completed and keeps their scores. The call is identified by a fingerprint of its
+ * parameters, so a checkpoint is not resumed by a different search of the same size.
+ *
+ * Scores are saved as EnigmaKey, so only standard rotors and reflectors can be checkpointed.
+ * The file is written in the byte order of the machine saving it and is not portable between
+ * machines of different byte order; such a file fails to load as an invalid checkpoint.
+ */
+typedef struct {
+    char*           path; //!< File the checkpoint is saved to.
+    int             interval; //!< Minimum number of seconds between saves.
+    time_t          saved_at; //!< When the checkpoint was last saved.
+    uint64_t        fingerprint; //!< Identifies the search (see enigma_checkpoint_begin()).
+    size_t          size; //!< Number of candidates of the search.
+    size_t          range_size; //!< Number of candidates per range.
+    size_t          range_count; //!< Number of ranges of the search.
+    size_t          done_count; //!< Number of completed ranges.
+    uint8_t*        done; //!< 1 for each completed range, or NULL before the search starts.
+    EnigmaScoreList scores; //!< Scores of the completed ranges.
+    pthread_mutex_t mutex; //!< Serializes completions from the workers of an executor.
+} EnigmaCheckpoint;
+
+EnigmaCheckpoint* enigma_checkpoint_new(const char*, int);
+EnigmaCheckpoint* enigma_checkpoint_load(const char*, int);
+int               enigma_checkpoint_free(EnigmaCheckpoint*);
+int               enigma_checkpoint_begin(EnigmaCheckpoint*, uint64_t, size_t, size_t, int);
+int               enigma_checkpoint_complete(EnigmaCheckpoint*, size_t, EnigmaScoreList*);
+int               enigma_checkpoint_is_done(const EnigmaCheckpoint*, size_t);
+int               enigma_checkpoint_save(EnigmaCheckpoint*);
+
+/* --- EnigmaCheckpoint getters --- */
+size_t                 enigma_checkpoint_get_done_count(const EnigmaCheckpoint*);
+size_t                 enigma_checkpoint_get_range_count(const EnigmaCheckpoint*);
+const EnigmaScoreList* enigma_checkpoint_get_scores(const EnigmaCheckpoint*);
+
+#endif
@@ -14,9 +14,17 @@
 #define _POSIX_C_SOURCE 200809L
 #endif
 
+#include "batch.h"
+#include "brute.h"
 #include "common.h"
 #include "enigma.h"
+#include "executor.h"
 #include "io.h"
+#include "ioc.h"
+#include "keyspace.h"
+#include "ngram.h"
+#include "plugboard.h"
+#include "progress.h"
 #include "rotor.h"
 
 #include <ctype.h>
@@ -24,18 +32,149 @@
 #include <stdlib.h>
 #include <string.h>
 
+/**
+ * @brief Flags checked by enigma_score_flags() that need the decoded text.
+ */
+#define ENIGMA_TEXT_SCORE_FLAGS                                                                    \
+    (ENIGMA_FLAG_DICTIONARY_MATCH | ENIGMA_FLAG_FREQUENCY | ENIGMA_FLAG_KNOWN_PLAINTEXT)
+
+/**
+ * @brief Buffers and scoring state shared by the candidates of one crack function call.
+ *
+ * Unless a scrambler cache is used, candidates are queued and decoded `batch_width` at a time
+ * with enigma_batch_encode_indices_unchecked(), then scored together and appended in the order
+ * they were queued.
+ */
+typedef struct {
+    float (*score)(const EnigmaCrackParams*, const char*); //!< Text scoring function.
+    EnigmaBatchScoreFunc   batch_score; //!< Batch scoring function, or NULL to score text.
+    const EnigmaScrambler* scrambler; //!< Scrambler cache for the candidates, or NULL.
+    uint8_t*               ciphertext; //!< Validated ciphertext as letter indices.
+    uint8_t*               plaintext; //!< Decoded letter indices of each queued candidate.
+    char*                  text; //!< Decoded text.
+    Enigma                 batch[ENIGMA_BATCH_LANES]; //!< Candidates waiting to be decoded.
+    float                  scores[ENIGMA_BATCH_LANES]; //!< Scores of the decoded candidates.
+    int                    batch_count; //!< Number of queued candidates.
+    int                    batch_width; //!< Number of candidates decoded together.
+    int*                   stop; //!< Set once a candidate reaches the target score, or NULL.
+} EnigmaCrackContext;
+
+/**
+ * @brief The share of a crack function call run by one worker of an executor.
+ */
+typedef struct {
+    EnigmaCrackParams  params; //!< Copy of the crack parameters, appending to `scores`.
+    EnigmaScoreList    scores; //!< Scores of the worker's candidates, in candidate order.
+    EnigmaCrackContext ctx; //!< The worker's decoding buffers.
+} EnigmaCrackWorker;
+
+/**
+ * @brief Where the scores of one keyspace range were stored by the worker that ran it.
+ */
+typedef struct {
+    int worker; //!< Index of the worker that ran the range.
+    int offset; //!< Index of the range's first score in the worker's score list.
+    int count; //!< Number of scores of the range.
+} EnigmaCrackRange;
+
+/**
+ * @brief The candidates of one crack function call, numbered from 0 to `size - 1`.
+ *
+ * Numbering the candidates lets a call be split into ranges of `range_size` for the workers of
+ * an executor; `candidate` turns an index back into a configuration.
+ */
+typedef struct EnigmaCrackSearch_s {
+    Enigma enigma; //!< Configuration the candidates are derived from.
+    size_t size; //!< Number of candidate indices.
+    size_t range_size; //!< Number of candidates handed to a worker at a time.
+    int    slot; //!< Rotor slot being cracked, or number of plugboard pairs already set.
+    int    remaining[ENIGMA_ALPHA_SIZE]; //!< Letters that are not on the plugboard yet.
+    int (*candidate)(const struct EnigmaCrackSearch_s*,
+                     size_t,
+                     Enigma*); //!< Updates a candidate to an index, returns 0 to skip the index.
+    const EnigmaScrambler* scrambler; //!< Scrambler cache shared by the workers, or NULL.
+    EnigmaKeyspace         keyspace; //!< Ranges left to run when run on an executor.
+    EnigmaCrackRange*      ranges; //!< Where the scores of each range were stored.
+    EnigmaCrackWorker*     workers; //!< Per-worker state when run on an executor.
+    EnigmaCheckpoint*      checkpoint; //!< Records completed ranges, or NULL.
+    EnigmaProgress*        progress; //!< Counts completed ranges and may cancel, or NULL.
+    int                    worker_count; //!< Number of workers with candidates to run.
+    int                    stop; //!< Set once a candidate reaches the target score.
+} EnigmaCrackSearch;
+
+/**
+ * @brief Initial capacity of each worker's score list.
+ */
+#define ENIGMA_CRACK_WORKER_SCORES 64
+
+ENIGMA_STATIC int  enigma_crack_auto_plugboard(const EnigmaCrackParams*,
+                                               float (*)(const EnigmaCrackParams*, const char*),
+                                               EnigmaScoreList*);
+ENIGMA_STATIC int  enigma_crack_auto_rescore(const EnigmaCrackParams*,
+                                             float (*)(const EnigmaCrackParams*, const char*),
+                                             EnigmaScoreList*);
+ENIGMA_STATIC int  enigma_crack_auto_setup(const EnigmaCrackParams*, int, EnigmaScoreList*);
+ENIGMA_STATIC int  enigma_crack_beam_push(EnigmaScoreList*, const EnigmaScore*);
+ENIGMA_STATIC int  enigma_crack_append(EnigmaCrackParams*,
+                                       EnigmaCrackContext*,
+                                       Enigma*,
+                                       const uint8_t*,
+                                       float);
+ENIGMA_STATIC int  enigma_crack_candidate(EnigmaCrackParams*, EnigmaCrackContext*, Enigma*);
+ENIGMA_STATIC int  enigma_crack_context_finish(EnigmaCrackParams*, EnigmaCrackContext*);
+ENIGMA_STATIC void enigma_crack_context_free(EnigmaCrackContext*);
+ENIGMA_STATIC int  enigma_crack_context_init(EnigmaCrackContext*,
+                                             const EnigmaCrackParams*,
+                                             float (*)(const EnigmaCrackParams*, const char*));
+ENIGMA_STATIC uint64_t enigma_crack_fingerprint(const EnigmaCrackParams*,
+                                                const EnigmaCrackSearch*,
+                                                float (*)(const EnigmaCrackParams*, const char*));
+ENIGMA_STATIC int      enigma_crack_flush(EnigmaCrackParams*, EnigmaCrackContext*);
+ENIGMA_STATIC uint64_t enigma_crack_hash(uint64_t, const void*, size_t);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE int enigma_crack_in_bounds(const EnigmaCrackParams*, float);
+ENIGMA_STATIC int  enigma_crack_keep(const EnigmaCrackParams*, EnigmaCrackContext*, float);
+ENIGMA_STATIC void enigma_crack_score(const EnigmaCrackParams*, EnigmaCrackContext*, int);
+ENIGMA_STATIC int  enigma_crack_merge(EnigmaScoreList*, const EnigmaScore*, int);
+ENIGMA_STATIC int  enigma_crack_plugboard_candidate(const EnigmaCrackSearch*, size_t, Enigma*);
+ENIGMA_STATIC size_t enigma_crack_range(EnigmaCrackSearch*,
+                                        EnigmaCrackParams*,
+                                        EnigmaCrackContext*,
+                                        size_t,
+                                        size_t);
+ENIGMA_STATIC int  enigma_crack_reflector_candidate(const EnigmaCrackSearch*, size_t, Enigma*);
+ENIGMA_STATIC int  enigma_crack_ring_settings_candidate(const EnigmaCrackSearch*, size_t, Enigma*);
+ENIGMA_STATIC int  enigma_crack_rotor_candidate(const EnigmaCrackSearch*, size_t, Enigma*);
+ENIGMA_STATIC int  enigma_crack_rotor_position_candidate(const EnigmaCrackSearch*, size_t, Enigma*);
+ENIGMA_STATIC int  enigma_crack_rotor_positions_candidate(const EnigmaCrackSearch*,
+                                                          size_t,
+                                                          Enigma*);
+ENIGMA_STATIC int  enigma_crack_rotors_candidate(const EnigmaCrackSearch*, size_t, Enigma*);
+ENIGMA_STATIC int  enigma_crack_search(EnigmaCrackParams*,
+                                       EnigmaCrackSearch*,
+                                       float (*)(const EnigmaCrackParams*, const char*));
+ENIGMA_STATIC void enigma_crack_search_init(EnigmaCrackSearch*,
+                                            const Enigma*,
+                                            size_t,
+                                            int (*)(const EnigmaCrackSearch*, size_t, Enigma*));
+ENIGMA_STATIC void enigma_crack_search_job(void*, int);
+ENIGMA_STATIC int  enigma_crack_search_merge(EnigmaScoreList*, const EnigmaCrackSearch*, size_t);
+ENIGMA_STATIC int  enigma_crack_search_restore(EnigmaCrackParams*, const EnigmaCrackSearch*);
+ENIGMA_STATIC int  enigma_crack_search_shard(const EnigmaCrackParams*, EnigmaCrackSearch*);
+ENIGMA_STATIC size_t enigma_crack_search_total(const EnigmaCrackSearch*);
 ENIGMA_STATIC int  enigma_dict_match_word(const EnigmaCrackParams*, char*);
+ENIGMA_STATIC int  enigma_dict_match_word_indices(const EnigmaCrackParams*, const uint8_t*, size_t);
 ENIGMA_STATIC void enigma_free_dictionary_node(EnigmaTrie*);
 
 /**
  * @brief Create a new EnigmaCrackParams structure.
  *
- * This function allocates memory for a new EnigmaCrackParams structure.
+ * This function allocates memory for a new EnigmaCrackParams structure, with every field
+ * zeroed.
  *
  * @return Pointer to the newly created EnigmaCrackParams structure, or NULL on failure.
  */
 EMSCRIPTEN_KEEPALIVE EnigmaCrackParams* enigma_crack_params_new(void) {
-    EnigmaCrackParams* params = malloc(sizeof(EnigmaCrackParams));
+    EnigmaCrackParams* params = calloc(1, sizeof(EnigmaCrackParams));
     if (!params) {
         return NULL;
     }
@@ -122,6 +261,138 @@ EMSCRIPTEN_KEEPALIVE int enigma_crack_params_validate(const EnigmaCrackParams* c
     return flags;
 }
 
+/**
+ * @brief Crack a ciphertext from scratch, running every stage whose settings are not defined.
+ *
+ * The stages are beam search steps (see enigma_crack_beam()), each one only searching around
+ * the best `width` candidates of the previous one:
+ * 1. The rotor order, rotor positions and reflector are searched jointly by Index of
+ *    Coincidence, which the plugboard barely affects.
+ * 2. The plugboard of each candidate is recovered by enigma_crack_plugboard_climb(), which runs
+ *    on the calling thread. Plugboards are scored by n-grams if `cfg->ngrams` are set (see
+ *    ENIGMA_N_GRAMS_EXIST), by Index of Coincidence otherwise.
+ *
+ * Settings flagged in `defined` are taken from `cfg->enigma` and not searched, so a stage
+ * whose settings are all defined is skipped; with ENIGMA_PLUGBOARD_DEFINED, the plugboard of
+ * `cfg->enigma` is kept, otherwise it is the plugboard the second stage starts from.
+ *
+ * The best `width` configurations of the last stage are appended to `cfg->score_list`, or
+ * written to `cfg->sink`, with the scores of that stage. The score bounds and target score are
+ * not used, since the stages score on different scales. The first stage runs on
+ * `cfg->executor`, and both update `cfg->progress`; once the progress is cancelled, the
+ * configurations found so far are returned.
+ *
+ * @param cfg The EnigmaCrackParams struct instance. It must not have a checkpoint or a shard,
+ * which belong to a single crack function call.
+ * @param defined A combination of ENIGMA_ROTORS_DEFINED, ENIGMA_ROTOR_POSITIONS_DEFINED,
+ * ENIGMA_REFLECTOR_DEFINED and ENIGMA_PLUGBOARD_DEFINED.
+ * @param width The number of candidates carried from one stage to the next (at least 1, see
+ * ENIGMA_CRACK_BEAM_WIDTH).
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_crack_auto(EnigmaCrackParams* cfg, int defined, int width) {
+    if (!cfg || (!cfg->score_list && !cfg->sink) || cfg->checkpoint || cfg->shard_count > 1
+        || width < 1) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    float (*plugboardFunc)(const EnigmaCrackParams*, const char*) = enigma_ioc_score;
+    if (enigma_crack_params_validate(cfg) & ENIGMA_N_GRAMS_EXIST) {
+        plugboardFunc = cfg->n == 2   ? enigma_bigram_score
+                        : cfg->n == 3 ? enigma_trigram_score
+                                      : enigma_quadgram_score;
+    }
+
+    EnigmaScoreList list = { 0 };
+    int             ret  = enigma_score_list_set_top_k(&list, width);
+    if (ret == ENIGMA_SUCCESS) {
+        ret = enigma_crack_auto_setup(cfg, defined, &list);
+    }
+    if (ret == ENIGMA_SUCCESS && !(defined & ENIGMA_PLUGBOARD_DEFINED)) {
+        ret = enigma_crack_auto_plugboard(cfg, plugboardFunc, &list);
+    }
+
+    enigma_score_list_sort(&list);
+    for (int i = 0; ret == ENIGMA_SUCCESS && i < list.score_count; i++) {
+        if (cfg->sink) {
+            ret = enigma_sink_write(cfg->sink, &list.scores[i]);
+        } else {
+            ret = enigma_score_list_push(cfg->score_list, &list.scores[i]);
+        }
+    }
+
+    free(list.scores);
+    return ret;
+}
+
+/**
+ * @brief Run a crack stage from each of several seed configurations, keeping the best overall.
+ *
+ * Instead of searching around the single configuration of `cfg->enigma`, the stage is run once
+ * with each seed as `cfg->enigma`, typically the best configurations of the previous stage, so
+ * that a wrong choice in an early stage can still be recovered in a later one. Each run uses
+ * every worker of `cfg->executor`, and keeps its best `width` candidates; those of all the
+ * seeds are merged, keeping the best `width` distinct configurations, since seeds that differ
+ * only in the settings the stage searches find the same candidates.
+ *
+ * The beam is appended to `cfg->score_list`, or written to `cfg->sink`, from the best score
+ * down. The score bounds apply to each run, and once a run keeps a score at or above the target
+ * score, or `cfg->progress` is cancelled, the remaining seeds are skipped.
+ *
+ * @param cfg The EnigmaCrackParams struct instance. It must not have a checkpoint or a shard,
+ * which belong to a single crack function call.
+ * @param seeds The configurations to run the stage from. Their scores are not used.
+ * @param width The number of configurations to keep (at least 1, see ENIGMA_CRACK_BEAM_WIDTH).
+ * @param stage The crack function to run from each seed, e.g. enigma_crack_rotor_positions().
+ * @param scoreFunc The scoring function passed to `stage`.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_crack_beam(EnigmaCrackParams*     cfg,
+                                           const EnigmaScoreList* seeds,
+                                           int                    width,
+                                           EnigmaCrackStage       stage,
+                                           float (*scoreFunc)(const EnigmaCrackParams*,
+                                                              const char*)) {
+    if (!cfg || !seeds || !stage || !scoreFunc || (!cfg->score_list && !cfg->sink)
+        || cfg->checkpoint || cfg->shard_count > 1 || width < 1) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    EnigmaCrackParams params = *cfg;
+    params.sink              = NULL;
+
+    EnigmaScoreList beam     = { 0 };
+    int             ret      = enigma_score_list_set_top_k(&beam, width);
+    int             done     = 0;
+    for (int i = 0; ret == ENIGMA_SUCCESS && !done && i < seeds->score_count; i++) {
+        EnigmaScoreList found = { 0 };
+        params.enigma         = seeds->scores[i].enigma;
+        params.score_list     = &found;
+        ret                   = enigma_score_list_set_top_k(&found, width);
+        if (ret == ENIGMA_SUCCESS) {
+            ret = stage(&params, scoreFunc);
+        }
+        for (int j = 0; ret == ENIGMA_SUCCESS && j < found.score_count; j++) {
+            done |= cfg->target_score > 0.0f && found.scores[j].score >= cfg->target_score;
+            ret = enigma_crack_beam_push(&beam, &found.scores[j]);
+        }
+        free(found.scores);
+        done |= cfg->progress && enigma_progress_is_cancelled(cfg->progress);
+    }
+
+    enigma_score_list_sort(&beam);
+    for (int i = 0; ret == ENIGMA_SUCCESS && i < beam.score_count; i++) {
+        if (cfg->sink) {
+            ret = enigma_sink_write(cfg->sink, &beam.scores[i]);
+        } else {
+            ret = enigma_score_list_push(cfg->score_list, &beam.scores[i]);
+        }
+    }
+
+    free(beam.scores);
+    return ret;
+}
+
 /**
  * @brief Crack the plugboard using a scoring function.
  *
@@ -141,43 +412,36 @@ EMSCRIPTEN_KEEPALIVE int enigma_crack_plugboard(EnigmaCrackParams* cfg,
         return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
     }
 
-    Enigma enigma = cfg->enigma;
-    Enigma enigmaTmp;
-    int    curSettings   = strlen(cfg->enigma.plugboard) / 2;
-
-    char*  plaintext     = malloc((cfg->ciphertext_length + 1) * sizeof(char));
-    int    remaining[26] = { 0 };
+    Enigma enigma      = cfg->enigma;
+    int    curSettings = strlen(cfg->enigma.plugboard) / 2;
 
-    memset(remaining, 1, sizeof(remaining));
     for (int i = 0; i < curSettings * 2; i++) {
         if (enigma.plugboard[i] < 'A' || enigma.plugboard[i] > 'Z') {
             return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
         }
-        remaining[toupper(enigma.plugboard[i]) - 'A'] = 0;
     }
 
-    for (char a = 'A'; a < 'Z'; a++) {
-        if (!remaining[a - 'A']) {
-            continue;
-        }
-        for (char b = 'A'; b <= 'Z'; b++) {
-            if (a == b || !remaining[b - 'A']) {
-                continue;
-            }
-
-            enigma.plugboard[curSettings * 2]     = a;
-            enigma.plugboard[curSettings * 2 + 1] = b;
-            enigma.plugboard[curSettings * 2 + 2] = '\0';
-            enigmaTmp                             = enigma;
-
-            enigma_encode_string(&enigmaTmp, cfg->ciphertext, plaintext, cfg->ciphertext_length);
-            enigma_score_append(cfg, &enigma, plaintext, scoreFunc(cfg, plaintext));
-        }
+    // Rebuild the permutation table in case the plugboard string was written directly
+    if (enigma_set_plugboard(&enigma, cfg->enigma.plugboard)) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
     }
 
-    free(plaintext);
+    // Candidate index a * 26 + b plugs letter a into letter b, for every a but 'Z'
+    EnigmaCrackSearch search;
+    enigma_crack_search_init(&search,
+                             &enigma,
+                             (ENIGMA_ALPHA_SIZE - 1) * ENIGMA_ALPHA_SIZE,
+                             enigma_crack_plugboard_candidate);
+    search.range_size = ENIGMA_ALPHA_SIZE;
+    search.slot       = curSettings;
+    for (int i = 0; i < ENIGMA_ALPHA_SIZE; i++) {
+        search.remaining[i] = 1;
+    }
+    for (int i = 0; i < curSettings * 2; i++) {
+        search.remaining[toupper(enigma.plugboard[i]) - 'A'] = 0;
+    }
 
-    return ENIGMA_SUCCESS;
+    return enigma_crack_search(cfg, &search, scoreFunc);
 }
 
 /**
@@ -199,22 +463,80 @@ EMSCRIPTEN_KEEPALIVE int enigma_crack_reflector(EnigmaCrackParams* cfg,
         return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
     }
 
-    Enigma enigma;
-    Enigma enigmaTmp;
-    char*  plaintext = malloc((cfg->ciphertext_length + 1) * sizeof(char));
+    EnigmaCrackSearch search;
+    enigma_crack_search_init(
+        &search, &cfg->enigma, ENIGMA_REFLECTOR_COUNT, enigma_crack_reflector_candidate);
+    return enigma_crack_search(cfg, &search, scoreFunc);
+}
+
+/**
+ * @brief Crack the ring settings using a scoring function.
+ *
+ * A ring setting turns a rotor's wiring against its notches, so for the wiring, only the ring
+ * offset (position minus ring setting) of each rotor matters. The rings only matter on their
+ * own through the turnovers: the fast ring decides when the middle rotor steps, and the middle
+ * ring when the left rotor steps. The ring of the left rotor (and of the fourth rotor) is
+ * therefore folded into its position, and only the rings of rotors 0 and 1 are searched.
+ *
+ * The search starts from `cfg->enigma`, e.g. a configuration found by
+ * enigma_crack_rotor_positions() with every ring at 'A'. A wrong fast ring decodes every
+ * letter with the right fast rotor offset, so such a search finds it, but it may match the
+ * middle and left rotors on either side of one of their steps. The ring offset of rotor 0 is
+ * therefore kept, and the offsets of rotors 1 and 2 are searched along with the two rings.
+ * The offset of a fourth rotor is kept as well.
+ *
+ * This searches 26^4 candidates (two rings times two offsets), where searching every ring
+ * setting and position of three rotors would take 26^6.
+ *
+ * @param cfg Pointer to the cracking configuration structure.
+ * @param scoreFunc Function pointer to the scoring function to use.
+ *
+ * @return `ENIGMA_SUCCESS` on success, `ENIGMA_FAILURE` on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_crack_ring_settings(EnigmaCrackParams* cfg,
+                                                    float (*scoreFunc)(const EnigmaCrackParams*,
+                                                                       const char*)) {
+    if (!cfg || !scoreFunc || cfg->enigma.rotor_count < 3
+        || cfg->enigma.rotor_count > ENIGMA_MAX_ROTOR_COUNT) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
 
-    enigma           = cfg->enigma;
-    for (int i = 0; i < ENIGMA_REFLECTOR_COUNT; i++) {
-        enigma.reflector = enigma_reflectors[i];
-        enigmaTmp        = enigma;
+    for (int i = 0; i < cfg->enigma.rotor_count; i++) {
+        if (cfg->enigma.rotor_indices[i] < 0 || cfg->enigma.rotor_indices[i] >= ENIGMA_ALPHA_SIZE
+            || cfg->enigma.ring_settings[i] < 0
+            || cfg->enigma.ring_settings[i] >= ENIGMA_ALPHA_SIZE) {
+            return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        }
+    }
 
-        enigma_encode_string(&enigmaTmp, cfg->ciphertext, plaintext, cfg->ciphertext_length);
-        enigma_score_append(cfg, &enigma, plaintext, scoreFunc(cfg, plaintext));
+    // Start from ring offsets, with the rings that do not affect stepping folded in
+    Enigma start = cfg->enigma;
+    for (int i = 0; i < start.rotor_count; i++) {
+        int offset             = start.rotor_indices[i] - start.ring_settings[i];
+        start.rotor_indices[i] = (offset + ENIGMA_ALPHA_SIZE) % ENIGMA_ALPHA_SIZE;
+        start.ring_settings[i] = 0;
     }
 
-    free(plaintext);
+    // Candidate index ((r0 * 26 + r1) * 26 + o1) * 26 + o2 sets the rings of rotors 0 and 1 to
+    // r0 and r1 and the offsets of rotors 1 and 2 to o1 and o2; one range per pair of rings
+    size_t size = ENIGMA_ALPHA_SIZE * ENIGMA_ALPHA_SIZE;
 
-    return ENIGMA_SUCCESS;
+    EnigmaCrackSearch search;
+    enigma_crack_search_init(&search, &start, size * size, enigma_crack_ring_settings_candidate);
+    search.range_size = size;
+
+    // The scrambler cache is indexed by ring offset, so it is shared by every candidate
+    EnigmaScrambler scrambler;
+    if (cfg->ciphertext_length > ENIGMA_ALPHA_SIZE
+        && enigma_scrambler_init(&scrambler, &start) == ENIGMA_SUCCESS) {
+        search.scrambler = &scrambler;
+    }
+
+    int ret = enigma_crack_search(cfg, &search, scoreFunc);
+    if (search.scrambler) {
+        enigma_scrambler_free(&scrambler);
+    }
+    return ret;
 }
 
 /**
@@ -238,21 +560,11 @@ EMSCRIPTEN_KEEPALIVE int enigma_crack_rotor(EnigmaCrackParams* cfg,
         return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
     }
 
-    Enigma enigma;
-    Enigma enigmaTmp;
-    char*  plaintext = malloc((cfg->ciphertext_length + 1) * sizeof(char));
-
-    enigma           = cfg->enigma;
-    for (int i = 0; i < ENIGMA_ROTOR_COUNT; i++) {
-        enigma.rotors[targetRotor] = enigma_rotors[i];
-        enigmaTmp                  = enigma;
-        enigma_encode_string(&enigmaTmp, cfg->ciphertext, plaintext, cfg->ciphertext_length);
-        enigma_score_append(cfg, &enigma, plaintext, scoreFunc(cfg, plaintext));
-    }
-
-    free(plaintext);
-
-    return ENIGMA_SUCCESS;
+    EnigmaCrackSearch search;
+    enigma_crack_search_init(
+        &search, &cfg->enigma, ENIGMA_ROTOR_COUNT, enigma_crack_rotor_candidate);
+    search.slot = targetRotor;
+    return enigma_crack_search(cfg, &search, scoreFunc);
 }
 
 /**
@@ -274,54 +586,17 @@ EMSCRIPTEN_KEEPALIVE int enigma_crack_rotors(EnigmaCrackParams* cfg,
         return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
     }
 
-    Enigma enigma;
-    Enigma enigmaTmp;
-    char*  plaintext = malloc((cfg->ciphertext_length + 1) * sizeof(char));
-
-    enigma           = cfg->enigma;
-    for (int i = 0; i < ENIGMA_ROTOR_COUNT; i++) {
-        for (int j = 0; j < ENIGMA_ROTOR_COUNT; j++) {
-            if (i == j)
-                continue;
-            for (int k = 0; k < ENIGMA_ROTOR_COUNT; k++) {
-                if (j == k || i == k)
-                    continue;
-
-                if (enigma.rotor_count == 4) {
-                    for (int l = 0; l < ENIGMA_ROTOR_COUNT; l++) {
-                        if (i == l || j == l || k == l)
-                            continue;
-
-                        enigma.rotors[0] = enigma_rotors[i];
-                        enigma.rotors[1] = enigma_rotors[j];
-                        enigma.rotors[2] = enigma_rotors[k];
-                        enigma.rotors[3] = enigma_rotors[l];
-                        enigmaTmp        = enigma;
-
-                        enigma_encode_string(&enigmaTmp,
-                                             cfg->ciphertext,
-                                             plaintext,
-                                             cfg->ciphertext_length);
-                        enigma_score_append(cfg, &enigma, plaintext, scoreFunc(cfg, plaintext));
-                    }
-                } else {
-                    enigma.rotors[0] = enigma_rotors[i];
-                    enigma.rotors[1] = enigma_rotors[j];
-                    enigma.rotors[2] = enigma_rotors[k];
-                    enigmaTmp        = enigma;
-
-                    enigma_encode_string(&enigmaTmp,
-                                         cfg->ciphertext,
-                                         plaintext,
-                                         cfg->ciphertext_length);
-                    enigma_score_append(cfg, &enigma, plaintext, scoreFunc(cfg, plaintext));
-                }
-            }
-        }
+    // Candidate index i * 8^(n-1) + j * 8^(n-2) + ... puts rotor i in the first slot, and so on
+    size_t size = 1;
+    for (int i = 0; i < cfg->enigma.rotor_count; i++) {
+        size *= ENIGMA_ROTOR_COUNT;
     }
 
-    free(plaintext);
-    return ENIGMA_SUCCESS;
+    // One range per order of the first two rotors
+    EnigmaCrackSearch search;
+    enigma_crack_search_init(&search, &cfg->enigma, size, enigma_crack_rotors_candidate);
+    search.range_size = size / (ENIGMA_ROTOR_COUNT * ENIGMA_ROTOR_COUNT);
+    return enigma_crack_search(cfg, &search, scoreFunc);
 }
 
 /**
@@ -342,21 +617,11 @@ EMSCRIPTEN_KEEPALIVE int enigma_crack_rotor_position(
         return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
     }
 
-    Enigma enigma;
-    Enigma enigmaTmp;
-    char*  plaintext = malloc((cfg->ciphertext_length + 1) * sizeof(char));
-
-    for (int i = 0; i < ENIGMA_ALPHA_SIZE; i++) {
-        enigma                      = cfg->enigma;
-        enigma.rotor_indices[rotor] = i;
-        enigmaTmp                   = enigma;
-
-        enigma_encode_string(&enigmaTmp, cfg->ciphertext, plaintext, cfg->ciphertext_length);
-        enigma_score_append(cfg, &enigma, plaintext, scoreFunc(cfg, plaintext));
-    }
-
-    free(plaintext);
-    return ENIGMA_SUCCESS;
+    EnigmaCrackSearch search;
+    enigma_crack_search_init(
+        &search, &cfg->enigma, ENIGMA_ALPHA_SIZE, enigma_crack_rotor_position_candidate);
+    search.slot = rotor;
+    return enigma_crack_search(cfg, &search, scoreFunc);
 }
 /**
  * @brief Crack the rotor positions using a scoring function.
@@ -377,47 +642,31 @@ EMSCRIPTEN_KEEPALIVE int enigma_crack_rotor_positions(EnigmaCrackParams* cfg,
         return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
     }
 
-    Enigma enigma;
-    Enigma enigmaTmp;
-    char*  plaintext = malloc((cfg->ciphertext_length + 1) * sizeof(char));
+    // Candidate index i * 26^(n-1) + j * 26^(n-2) + ... sets the first rotor to i, and so on
+    size_t size = 1;
+    for (int i = 0; i < cfg->enigma.rotor_count; i++) {
+        size *= ENIGMA_ALPHA_SIZE;
+    }
+
+    // One range per position of the first two rotors
+    EnigmaCrackSearch search;
+    enigma_crack_search_init(&search, &cfg->enigma, size, enigma_crack_rotor_positions_candidate);
+    search.range_size = size / (ENIGMA_ALPHA_SIZE * ENIGMA_ALPHA_SIZE);
 
-    for (int i = 0; i < ENIGMA_ALPHA_SIZE; i++) {
-        for (int j = 0; j < ENIGMA_ALPHA_SIZE; j++) {
-            for (int k = 0; k < ENIGMA_ALPHA_SIZE; k++) {
-                if (cfg->enigma.rotor_count == 4) {
-                    for (int l = 0; l < ENIGMA_ALPHA_SIZE; l++) {
-                        enigma                  = cfg->enigma;
-                        enigma.rotor_indices[0] = i;
-                        enigma.rotor_indices[1] = j;
-                        enigma.rotor_indices[2] = k;
-                        enigma.rotor_indices[3] = l;
-                        enigmaTmp               = enigma;
-
-                        enigma_encode_string(&enigmaTmp,
-                                             cfg->ciphertext,
-                                             plaintext,
-                                             cfg->ciphertext_length);
-                        enigma_score_append(cfg, &enigma, plaintext, scoreFunc(cfg, plaintext));
-                    }
-                } else {
-                    enigma                  = cfg->enigma;
-                    enigma.rotor_indices[0] = i;
-                    enigma.rotor_indices[1] = j;
-                    enigma.rotor_indices[2] = k;
-                    enigmaTmp               = enigma;
-
-                    enigma_encode_string(&enigmaTmp,
-                                         cfg->ciphertext,
-                                         plaintext,
-                                         cfg->ciphertext_length);
-                    enigma_score_append(cfg, &enigma, plaintext, scoreFunc(cfg, plaintext));
-                }
-            }
-        }
+    // Building the scrambler cache costs one pass per letter per rotor state, so it only pays
+    // off once the ciphertext is longer than the alphabet. The cache is read-only, so all
+    // workers share it.
+    EnigmaScrambler scrambler;
+    if (cfg->ciphertext_length > ENIGMA_ALPHA_SIZE
+        && enigma_scrambler_init(&scrambler, &cfg->enigma) == ENIGMA_SUCCESS) {
+        search.scrambler = &scrambler;
     }
 
-    free(plaintext);
-    return ENIGMA_SUCCESS;
+    int ret = enigma_crack_search(cfg, &search, scoreFunc);
+    if (search.scrambler) {
+        enigma_scrambler_free(&scrambler);
+    }
+    return ret;
 }
 
 /**
@@ -489,6 +738,66 @@ EMSCRIPTEN_KEEPALIVE int enigma_dict_match(const EnigmaCrackParams* cfg, const c
     return 0;
 }
 
+/**
+ * @brief Checks if multiple words from the dictionary are present in the
+ * decoded letter indices.
+ *
+ * This is the index-domain counterpart of enigma_dict_match(). `plaintext` must hold
+ * `cfg->ciphertext_length` letter indices (0-25).
+ *
+ * @param cfg The EnigmaCrackParams struct containing the dictionary and its size
+ * @param plaintext The letter indices to check
+ * @return 1 if multiple words are found, 0 if not, or `ENIGMA_FAILURE` on error.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_dict_match_indices(const EnigmaCrackParams* cfg,
+                                                   const uint8_t*           plaintext) {
+    if (!cfg || !plaintext || !cfg->dictionary) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    int    matchCount   = 0;
+    size_t plaintextLen = cfg->ciphertext_length;
+
+    if (cfg->flags & ENIGMA_FLAG_X_SEPARATED) {
+        const uint8_t* separator = memchr(plaintext, 'X' - 'A', plaintextLen);
+        if (!separator) {
+            return 0;
+        }
+
+        // Check every X-separated word, including the one after the last X
+        size_t wordStart = 0;
+        for (size_t i = 0; i <= plaintextLen; i++) {
+            if (i < plaintextLen && plaintext[i] != 'X' - 'A') {
+                continue;
+            }
+
+            matchCount += enigma_dict_match_word_indices(cfg, &plaintext[wordStart], i - wordStart);
+            if (matchCount > 1) {
+                return 1;
+            }
+            wordStart = i + 1;
+        }
+    } else {
+        // Run through dictionary for each character in plaintext
+        for (size_t i = 0; i < plaintextLen; i++) {
+            EnigmaTrie* node = cfg->dictionary;
+            for (size_t j = i; j < plaintextLen; j++) {
+                if (!node->children[plaintext[j]]) {
+                    break;
+                }
+                node = node->children[plaintext[j]];
+                if (node->value == 1) {
+                    matchCount++;
+                    if (matchCount > 1) {
+                        return 1;
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
+
 /**
  * @brief Finds potential indices in the ciphertext where the known plaintext
  * may exist.
@@ -613,7 +922,10 @@ EMSCRIPTEN_KEEPALIVE int enigma_letter_freq(const EnigmaCrackParams* cfg, const
 /**
  * @brief Append a score to an EnigmaScoreList.
  *
- * If the scores array is full, it will be resized to double its current size.
+ * If the scores array is full, it will be resized to double its current size. If the list
+ * keeps only its best scores (see enigma_score_list_set_top_k()), a score below the lowest one
+ * kept is dropped before its flags are computed. If `cfg->sink` is set, the score is written to
+ * the sink instead (see enigma_crack_set_sink()).
  *
  * @param cfg Pointer to the cracking configuration structure.
  * @param enigma Pointer to the Enigma structure representing the scored
@@ -628,19 +940,19 @@ enigma_score_append(EnigmaCrackParams* cfg, Enigma* enigma, const char* plaintex
         return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
     }
 
-    if (cfg->score_list->score_count >= cfg->score_list->max_scores) {
-        cfg->score_list->max_scores *= 2;
-        cfg->score_list->scores
-            = realloc(cfg->score_list->scores, cfg->score_list->max_scores * sizeof(EnigmaScore));
+    if (!enigma_crack_in_bounds(cfg, score)
+        || (!cfg->sink && !enigma_score_list_accepts(cfg->score_list, score))) {
+        return ENIGMA_SUCCESS;
     }
 
-    cfg->score_list->scores[cfg->score_list->score_count].enigma = *enigma;
-    cfg->score_list->scores[cfg->score_list->score_count].score  = score;
-    cfg->score_list->scores[cfg->score_list->score_count].flags
-        = enigma_score_flags(cfg, plaintext);
-    cfg->score_list->score_count++;
-
-    return ENIGMA_SUCCESS;
+    EnigmaScore entry;
+    entry.enigma = *enigma;
+    entry.score  = score;
+    entry.flags  = enigma_score_flags(cfg, plaintext);
+    if (cfg->sink) {
+        return enigma_sink_write(cfg->sink, &entry);
+    }
+    return enigma_score_list_push(cfg->score_list, &entry);
 }
 
 /**
@@ -695,6 +1007,58 @@ EMSCRIPTEN_KEEPALIVE int enigma_score_flags(const EnigmaCrackParams* cfg, const
     return ret;
 }
 
+/**
+ * @brief Get the index-domain counterpart of a scoring function.
+ *
+ * The crack functions use this to decode and score candidates as letter indices instead of
+ * text when the given scoring function is one of the library's own.
+ *
+ * @param scoreFunc A text scoring function, such as enigma_quadgram_score().
+ * @return The matching index scoring function, such as enigma_quadgram_score_indices(), or
+ * NULL if there is none.
+ */
+EMSCRIPTEN_KEEPALIVE EnigmaIndexScoreFunc
+enigma_index_score_function(float (*scoreFunc)(const EnigmaCrackParams*, const char*)) {
+    if (scoreFunc == enigma_bigram_score) {
+        return enigma_bigram_score_indices;
+    } else if (scoreFunc == enigma_trigram_score) {
+        return enigma_trigram_score_indices;
+    } else if (scoreFunc == enigma_quadgram_score) {
+        return enigma_quadgram_score_indices;
+    } else if (scoreFunc == enigma_ioc_score) {
+        return enigma_ioc_score_indices;
+    } else if (scoreFunc == enigma_brute_score) {
+        return enigma_brute_score_indices;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Get the batch counterpart of a scoring function.
+ *
+ * The crack functions use this to score all the candidates decoded together in one call when
+ * the given scoring function is one of the library's own.
+ *
+ * @param scoreFunc A text scoring function, such as enigma_quadgram_score().
+ * @return The matching batch scoring function, such as enigma_quadgram_score_batch(), or NULL
+ * if there is none.
+ */
+EMSCRIPTEN_KEEPALIVE EnigmaBatchScoreFunc
+enigma_batch_score_function(float (*scoreFunc)(const EnigmaCrackParams*, const char*)) {
+    if (scoreFunc == enigma_bigram_score) {
+        return enigma_bigram_score_batch;
+    } else if (scoreFunc == enigma_trigram_score) {
+        return enigma_trigram_score_batch;
+    } else if (scoreFunc == enigma_quadgram_score) {
+        return enigma_quadgram_score_batch;
+    } else if (scoreFunc == enigma_ioc_score) {
+        return enigma_ioc_score_batch;
+    } else if (scoreFunc == enigma_brute_score) {
+        return enigma_brute_score_batch;
+    }
+    return NULL;
+}
+
 /**
  * @brief Get the enigma field in the given EnigmaCrackParams struct
  *
@@ -1004,7 +1368,8 @@ EMSCRIPTEN_KEEPALIVE int enigma_crack_set_n(EnigmaCrackParams* cfg, int n) {
  * @brief Set the ciphertext field in the given EnigmaCrackParams struct
  *
  * @param cfg The EnigmaCrackParams struct instance
- * @param ciphertext The ciphertext string
+ * @param ciphertext The ciphertext string (ASCII letters of either case; the crack functions fail
+ * on any other character)
  * @param length The length of the ciphertext string
  * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
  */
@@ -1121,22 +1486,1270 @@ EMSCRIPTEN_KEEPALIVE int enigma_crack_set_known_plaintext(EnigmaCrackParams* cfg
 }
 
 /**
- * @brief Match a word in the dictionary with the given plaintext
+ * @brief Get the executor field in the given EnigmaCrackParams struct
  *
- * cfg->dictionary must be initialized and valid.
+ * @param cfg The EnigmaCrackParams struct instance
+ * @return The executor field, or NULL if cfg is NULL or the crack functions run on the calling
+ * thread.
+ */
+EMSCRIPTEN_KEEPALIVE EnigmaExecutor* enigma_crack_get_executor(const EnigmaCrackParams* cfg) {
+    if (!cfg) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return NULL;
+    }
+
+    return cfg->executor;
+}
+
+/**
+ * @brief Set the executor field in the given EnigmaCrackParams struct
+ *
+ * The crack functions split their candidates between the workers of the executor. Each worker
+ * decodes into its own buffers and appends to its own score list, and the lists are appended to
+ * `cfg->score_list` in candidate order once every worker is done, so the results are the same
+ * as on a single thread. The scoring function must be safe to call from several threads.
  *
  * @param cfg The EnigmaCrackParams struct instance
- * @param plaintext The plaintext string to match
- * @return 1 on success, 0 on failure
+ * @param executor The executor to run on, or NULL to run on the calling thread
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
  */
-ENIGMA_STATIC int enigma_dict_match_word(const EnigmaCrackParams* cfg, char* plaintext) {
-    EnigmaTrie* node = cfg->dictionary;
-    for (int i = 0; plaintext[i] != '\0'; i++) {
-        int childIdx = plaintext[i] - 'A';
-        if (node->children[childIdx] == NULL) {
-            return 0;
-        }
-        node = node->children[childIdx];
+EMSCRIPTEN_KEEPALIVE int enigma_crack_set_executor(EnigmaCrackParams* cfg,
+                                                   EnigmaExecutor*    executor) {
+    if (!cfg) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    cfg->executor = executor;
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Get the sink field in the given EnigmaCrackParams struct
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @return The sink field, or NULL if cfg is NULL or scores are appended to the score list.
+ */
+EMSCRIPTEN_KEEPALIVE EnigmaSink* enigma_crack_get_sink(const EnigmaCrackParams* cfg) {
+    if (!cfg) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return NULL;
+    }
+
+    return cfg->sink;
+}
+
+/**
+ * @brief Set the sink field in the given EnigmaCrackParams struct
+ *
+ * With a sink, the crack functions write each kept score to the sink as soon as it is found,
+ * and `score_list` is not used. With an executor, scores arrive in no particular order.
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param sink The sink to write to, or NULL to append to the score list
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_crack_set_sink(EnigmaCrackParams* cfg, EnigmaSink* sink) {
+    if (!cfg) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    cfg->sink = sink;
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Get the checkpoint field in the given EnigmaCrackParams struct
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @return The checkpoint field, or NULL if cfg is NULL or no checkpoint is used.
+ */
+EMSCRIPTEN_KEEPALIVE EnigmaCheckpoint* enigma_crack_get_checkpoint(const EnigmaCrackParams* cfg) {
+    if (!cfg) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return NULL;
+    }
+
+    return cfg->checkpoint;
+}
+
+/**
+ * @brief Set the checkpoint field in the given EnigmaCrackParams struct
+ *
+ * With a checkpoint, the crack functions record each completed range of candidates and its
+ * scores in the checkpoint, and save it to its file every `interval` seconds and when they
+ * return. To resume an interrupted search, call the same crack function with the same
+ * parameters and a checkpoint loaded with enigma_checkpoint_load(): completed ranges are
+ * skipped and their scores are appended along with the new ones. Scores are appended in the
+ * order their ranges completed rather than in candidate order.
+ *
+ * A checkpoint belongs to a single crack function call.
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param checkpoint The checkpoint to use, or NULL to not save progress
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_crack_set_checkpoint(EnigmaCrackParams* cfg,
+                                                     EnigmaCheckpoint*  checkpoint) {
+    if (!cfg) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    cfg->checkpoint = checkpoint;
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Get the shard field in the given EnigmaCrackParams struct
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @return The shard field, or ENIGMA_FAILURE if cfg is NULL
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_crack_get_shard(const EnigmaCrackParams* cfg) {
+    if (!cfg) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    return cfg->shard;
+}
+
+/**
+ * @brief Get the shard_count field in the given EnigmaCrackParams struct
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @return The shard_count field, or ENIGMA_FAILURE if cfg is NULL
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_crack_get_shard_count(const EnigmaCrackParams* cfg) {
+    if (!cfg) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    return cfg->shard_count;
+}
+
+/**
+ * @brief Set the shard and shard_count fields in the given EnigmaCrackParams struct
+ *
+ * With `count` shards, the crack functions only search one of `count` contiguous shares of
+ * their candidates, so a search can be split between machines: run the same crack function
+ * with the same parameters and each shard from 0 to `count - 1`, then merge the scores. The
+ * shares are balanced by the number of candidates actually decoded (e.g. rotor orders that
+ * reuse a rotor are not), and only depend on the crack function and its parameters, so
+ * every machine computes the same split.
+ *
+ * A checkpoint (see enigma_crack_set_checkpoint()) belongs to one shard.
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param shard The index of the shard to search (0 to `count - 1`)
+ * @param count The number of shards (1 to search every candidate)
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_crack_set_shard(EnigmaCrackParams* cfg, int shard, int count) {
+    if (!cfg || count < 1 || shard < 0 || shard >= count) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    cfg->shard       = shard;
+    cfg->shard_count = count;
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Get the progress field in the given EnigmaCrackParams struct
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @return The progress field, or NULL if cfg is NULL or no progress is used.
+ */
+EMSCRIPTEN_KEEPALIVE EnigmaProgress* enigma_crack_get_progress(const EnigmaCrackParams* cfg) {
+    if (!cfg) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return NULL;
+    }
+
+    return cfg->progress;
+}
+
+/**
+ * @brief Set the progress field in the given EnigmaCrackParams struct
+ *
+ * With a progress, the crack functions add each range of candidates they complete to its
+ * counters, which another thread may poll (see EnigmaProgress), and stop at the next range
+ * boundary once enigma_progress_cancel() is called. A cancelled crack function call returns
+ * ENIGMA_SUCCESS with the scores of the ranges it ran, and a checkpoint resumes it from there.
+ *
+ * The progress is shared by the workers of an executor. Worker processes (see
+ * enigma_process_crack()) only update it if it is in memory shared with the caller.
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param progress The progress to update, or NULL to not report progress
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_crack_set_progress(EnigmaCrackParams* cfg,
+                                                   EnigmaProgress*    progress) {
+    if (!cfg) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    cfg->progress = progress;
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Recover the plugboards of the survivors of enigma_crack_auto() by hill climbing
+ *
+ * This is a beam search step running enigma_crack_plugboard_climb() from each survivor. The
+ * climb never ends below the score it starts from, so the survivors need no rescoring.
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param scoreFunc The plugboard scoring function
+ * @param list The survivors of the previous stage, replaced by the best plugboards found
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+ENIGMA_STATIC int enigma_crack_auto_plugboard(const EnigmaCrackParams* cfg,
+                                              float (*scoreFunc)(const EnigmaCrackParams*,
+                                                                 const char*),
+                                              EnigmaScoreList* list) {
+    EnigmaCrackParams params = *cfg;
+    EnigmaScoreList   next   = { 0 };
+    params.sink              = NULL;
+    params.score_list        = &next;
+    params.min_score         = 0.0f;
+    params.max_score         = 0.0f;
+    params.target_score      = 0.0f;
+
+    if (enigma_crack_beam(&params, list, list->top_k, enigma_crack_plugboard_climb, scoreFunc)) {
+        free(next.scores);
+        return ENIGMA_FAILURE;
+    }
+
+    enigma_score_list_set_top_k(&next, list->top_k);
+    free(list->scores);
+    *list = next;
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Score the survivors of a stage of enigma_crack_auto() with another scoring function
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param scoreFunc The scoring function of the next stage
+ * @param list The survivors to score
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+ENIGMA_STATIC int enigma_crack_auto_rescore(const EnigmaCrackParams* cfg,
+                                            float (*scoreFunc)(const EnigmaCrackParams*,
+                                                               const char*),
+                                            EnigmaScoreList* list) {
+    char* text = malloc(cfg->ciphertext_length + 1);
+    if (!text) {
+        return ENIGMA_ERROR("%s", "Failed to allocate plaintext");
+    }
+
+    for (int i = 0; i < list->score_count; i++) {
+        Enigma enigma = list->scores[i].enigma;
+        if (enigma_encode_string(&enigma, cfg->ciphertext, text, cfg->ciphertext_length)) {
+            free(text);
+            return ENIGMA_FAILURE;
+        }
+        text[cfg->ciphertext_length] = '\0';
+        list->scores[i].score        = scoreFunc(cfg, text);
+    }
+
+    // The scores changed, so the top-K heap is rebuilt
+    EnigmaScoreList rescored = { 0 };
+    int             ret      = enigma_score_list_set_top_k(&rescored, list->top_k);
+    for (int i = 0; ret == ENIGMA_SUCCESS && i < list->score_count; i++) {
+        ret = enigma_score_list_push(&rescored, &list->scores[i]);
+    }
+    free(text);
+    free(list->scores);
+    *list = rescored;
+    return ret;
+}
+
+/**
+ * @brief Search the rotor order, rotor positions and reflector for enigma_crack_auto()
+ *
+ * The undefined settings are searched jointly by Index of Coincidence, as a beam search step
+ * whose seeds are every combination of the settings that no crack function searches together:
+ * the rotor positions are searched for every rotor order, and either for every reflector. With
+ * every setting defined, the configuration of `cfg->enigma` is the only survivor.
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param defined The settings that are not searched
+ * @param list The top-K list to add the survivors to
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+ENIGMA_STATIC int
+enigma_crack_auto_setup(const EnigmaCrackParams* cfg, int defined, EnigmaScoreList* list) {
+    EnigmaCrackParams params = *cfg;
+    params.score_list        = list;
+    params.sink              = NULL;
+    params.min_score         = 0.0f;
+    params.max_score         = 0.0f;
+    params.target_score      = 0.0f;
+
+    int rotors     = defined & ENIGMA_ROTORS_DEFINED;
+    int positions  = defined & ENIGMA_ROTOR_POSITIONS_DEFINED;
+    int reflectors = defined & ENIGMA_REFLECTOR_DEFINED ? 1 : ENIGMA_REFLECTOR_COUNT;
+
+    if (rotors && positions && reflectors == 1) {
+        EnigmaScore score = { .enigma = cfg->enigma };
+        if (enigma_score_list_push(list, &score)) {
+            return ENIGMA_FAILURE;
+        }
+        return enigma_crack_auto_rescore(cfg, enigma_ioc_score, list);
+    }
+
+    // Rotor orders are numbered as in enigma_crack_rotors()
+    size_t orders = 1;
+    for (int i = 0; !rotors && !positions && i < cfg->enigma.rotor_count; i++) {
+        orders *= ENIGMA_ROTOR_COUNT;
+    }
+
+    EnigmaScoreList seeds = { 0 };
+    EnigmaScore     seed  = { .enigma = cfg->enigma };
+    int             ret   = ENIGMA_SUCCESS;
+    for (int r = 0; ret == ENIGMA_SUCCESS && r < reflectors; r++) {
+        if (reflectors > 1 && !(rotors && positions)) {
+            seed.enigma.reflector = enigma_reflectors[r];
+        }
+        for (size_t order = 0; ret == ENIGMA_SUCCESS && order < orders; order++) {
+            if (orders == 1 || enigma_crack_rotors_candidate(NULL, order, &seed.enigma)) {
+                ret = enigma_score_list_push(&seeds, &seed);
+            }
+        }
+        if (rotors && positions) {
+            break;
+        }
+    }
+
+    EnigmaCrackStage stage = rotors && positions ? enigma_crack_reflector
+                             : positions         ? enigma_crack_rotors
+                                                 : enigma_crack_rotor_positions;
+    if (ret == ENIGMA_SUCCESS) {
+        ret = enigma_crack_beam(&params, &seeds, list->top_k, stage, enigma_ioc_score);
+    }
+    free(seeds.scores);
+    return ret;
+}
+
+/**
+ * @brief Add a candidate to a beam, unless it is already in it
+ *
+ * @param list The beam
+ * @param score The candidate
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+ENIGMA_STATIC int enigma_crack_beam_push(EnigmaScoreList* list, const EnigmaScore* score) {
+    EnigmaKey key;
+    EnigmaKey other;
+
+    // Configurations without a key (non-standard rotors) are never considered duplicates
+    if (enigma_key_from_enigma(&key, &score->enigma) == ENIGMA_SUCCESS) {
+        for (int i = 0; i < list->score_count; i++) {
+            if (enigma_key_from_enigma(&other, &list->scores[i].enigma) == ENIGMA_SUCCESS
+                && !enigma_key_compare(&key, &other)) {
+                return ENIGMA_SUCCESS;
+            }
+        }
+    }
+    return enigma_score_list_push(list, score);
+}
+
+/**
+ * @brief Prepare the buffers and scoring function for a crack function call
+ *
+ * The ciphertext is validated and converted to letter indices once here, so that the
+ * candidates can be decoded with the unchecked encode functions. Lowercase letters are read as
+ * uppercase; any other character fails the call. If `scoreFunc` has a batch
+ * counterpart (see enigma_batch_score_function()), the candidates are also scored as letter
+ * indices, all the candidates decoded together in one call.
+ *
+ * @param ctx The context to initialize
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param scoreFunc The text scoring function passed to the crack function
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+ENIGMA_STATIC int enigma_crack_context_init(EnigmaCrackContext*      ctx,
+                                            const EnigmaCrackParams* cfg,
+                                            float (*scoreFunc)(const EnigmaCrackParams*,
+                                                               const char*)) {
+    size_t length = cfg->ciphertext_length;
+
+    ctx->score       = scoreFunc;
+    ctx->batch_score = enigma_batch_score_function(scoreFunc);
+    ctx->scrambler   = NULL;
+    ctx->batch_count = 0;
+    ctx->batch_width = enigma_batch_width();
+    ctx->stop        = NULL;
+    ctx->ciphertext  = malloc(length + 1);
+    ctx->plaintext   = malloc(ctx->batch_width * length + 1);
+    ctx->text        = malloc((length + 1) * sizeof(char));
+    if (!ctx->ciphertext || !ctx->plaintext || !ctx->text) {
+        enigma_crack_context_free(ctx);
+        return ENIGMA_ERROR("%s", "Failed to allocate plaintext buffers");
+    }
+
+    if (!cfg->ciphertext || enigma_text_to_indices(cfg->ciphertext, ctx->ciphertext, length)) {
+        enigma_crack_context_free(ctx);
+        return ENIGMA_ERROR("%s", "Ciphertext must only contain letters");
+    }
+
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Free the buffers of a crack context
+ * @param ctx The context to free
+ */
+ENIGMA_STATIC void enigma_crack_context_free(EnigmaCrackContext* ctx) {
+    free(ctx->ciphertext);
+    free(ctx->plaintext);
+    free(ctx->text);
+}
+
+/**
+ * @brief Flush the queued candidates and free the buffers of a crack context
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param ctx The context to finish
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+ENIGMA_STATIC int enigma_crack_context_finish(EnigmaCrackParams* cfg, EnigmaCrackContext* ctx) {
+    int ret = enigma_crack_flush(cfg, ctx);
+    enigma_crack_context_free(ctx);
+    return ret;
+}
+
+/**
+ * @brief Decode the ciphertext with a candidate configuration, score it, and append the score
+ *
+ * Without a scrambler cache, the candidate is queued and only decoded and scored once
+ * `batch_width` candidates are queued, or when the context is finished.
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param ctx The context of the current crack function call
+ * @param enigma The candidate Enigma machine (left unchanged)
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+ENIGMA_STATIC int
+enigma_crack_candidate(EnigmaCrackParams* cfg, EnigmaCrackContext* ctx, Enigma* enigma) {
+    if (ctx->scrambler) {
+        int positions[ENIGMA_MAX_ROTOR_COUNT];
+        memcpy(positions, enigma->rotor_indices, sizeof(positions));
+        enigma_scrambler_encode_indices_unchecked(
+            ctx->scrambler, enigma, ctx->ciphertext, ctx->plaintext, cfg->ciphertext_length);
+        memcpy(enigma->rotor_indices, positions, sizeof(positions));
+        enigma_crack_score(cfg, ctx, 1);
+        return enigma_crack_append(cfg, ctx, enigma, ctx->plaintext, ctx->scores[0]);
+    }
+
+    ctx->batch[ctx->batch_count++] = *enigma;
+    if (ctx->batch_count < ctx->batch_width) {
+        return ENIGMA_SUCCESS;
+    }
+    return enigma_crack_flush(cfg, ctx);
+}
+
+/**
+ * @brief Decode and score the queued candidates of a crack context
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param ctx The context of the current crack function call
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+ENIGMA_STATIC int enigma_crack_flush(EnigmaCrackParams* cfg, EnigmaCrackContext* ctx) {
+    int positions[ENIGMA_BATCH_LANES][ENIGMA_MAX_ROTOR_COUNT];
+    int length = cfg->ciphertext_length;
+    int ret    = ENIGMA_SUCCESS;
+
+    if (ctx->batch_count == 0) {
+        return ENIGMA_SUCCESS;
+    }
+
+    // Decoding only moves the rotors, so the candidates are decoded in place and only their
+    // starting positions are copied to restore them for the scores
+    for (int i = 0; i < ctx->batch_count; i++) {
+        memcpy(positions[i], ctx->batch[i].rotor_indices, sizeof(positions[i]));
+    }
+    enigma_batch_encode_indices_unchecked(
+        ctx->batch, ctx->batch_count, ctx->ciphertext, ctx->plaintext, length);
+    enigma_crack_score(cfg, ctx, ctx->batch_count);
+
+    for (int i = 0; i < ctx->batch_count; i++) {
+        const uint8_t* plaintext = ctx->plaintext + (size_t) i * length;
+        memcpy(ctx->batch[i].rotor_indices, positions[i], sizeof(positions[i]));
+        if (enigma_crack_append(cfg, ctx, &ctx->batch[i], plaintext, ctx->scores[i])) {
+            ret = ENIGMA_FAILURE;
+        }
+    }
+
+    ctx->batch_count = 0;
+    return ret;
+}
+
+/**
+ * @brief Score the decoded candidates of a crack context
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param ctx The context of the current crack function call
+ * @param count The number of candidates decoded to `plaintext`, whose scores are set in
+ * `scores`
+ */
+ENIGMA_STATIC void
+enigma_crack_score(const EnigmaCrackParams* cfg, EnigmaCrackContext* ctx, int count) {
+    int length = cfg->ciphertext_length;
+
+    if (ctx->batch_score) {
+        ctx->batch_score(cfg, ctx->plaintext, count, ctx->scores);
+        return;
+    }
+
+    for (int i = 0; i < count; i++) {
+        enigma_indices_to_text(ctx->plaintext + (size_t) i * length, ctx->text, length);
+        ctx->scores[i] = ctx->score(cfg, ctx->text);
+    }
+}
+
+/**
+ * @brief Append the score of a decoded candidate
+ *
+ * The plaintext is only converted back to text if the score is kept and the score flags need
+ * it.
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param ctx The context of the current crack function call
+ * @param enigma The candidate Enigma machine, at its starting position
+ * @param plaintext The letter indices decoded by the candidate
+ * @param score The candidate's score
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+ENIGMA_STATIC int enigma_crack_append(EnigmaCrackParams*  cfg,
+                                      EnigmaCrackContext* ctx,
+                                      Enigma*             enigma,
+                                      const uint8_t*      plaintext,
+                                      float               score) {
+    const char* text = "";
+
+    if (!enigma_crack_keep(cfg, ctx, score)) {
+        return ENIGMA_SUCCESS;
+    }
+    if (cfg->flags & ENIGMA_TEXT_SCORE_FLAGS) {
+        enigma_indices_to_text(plaintext, ctx->text, cfg->ciphertext_length);
+        text = ctx->text;
+    }
+    return enigma_score_append(cfg, enigma, text, score);
+}
+
+/**
+ * @brief Check whether a score is within the score bounds of a crack function call
+ *
+ * The bounds are only applied if `max_score` is greater than `min_score`.
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param score The score to check
+ * @return 1 if the score is within the bounds or there are none, 0 otherwise
+ */
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE int enigma_crack_in_bounds(const EnigmaCrackParams* cfg,
+                                                              float                    score) {
+    return cfg->max_score <= cfg->min_score
+        || (score >= cfg->min_score && score <= cfg->max_score);
+}
+
+/**
+ * @brief Check whether a candidate's score should be appended, and stop at the target score
+ *
+ * Scores outside the score bounds are dropped before anything is stored. A kept score that
+ * reaches a nonzero `target_score` stops the search on every worker.
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param ctx The context of the current crack function call
+ * @param score The candidate's score
+ * @return 1 if the score should be appended, 0 if it is dropped
+ */
+ENIGMA_STATIC int
+enigma_crack_keep(const EnigmaCrackParams* cfg, EnigmaCrackContext* ctx, float score) {
+    if (!enigma_crack_in_bounds(cfg, score)) {
+        return 0;
+    }
+    if (cfg->target_score != 0.0f && score >= cfg->target_score && ctx->stop) {
+        __atomic_store_n(ctx->stop, 1, __ATOMIC_RELAXED);
+    }
+    return cfg->sink || enigma_score_list_accepts(cfg->score_list, score);
+}
+
+/**
+ * @brief Hash bytes into a running 64-bit FNV-1a hash
+ *
+ * @param hash The hash so far
+ * @param data The bytes to add
+ * @param size The number of bytes
+ * @return The updated hash
+ */
+ENIGMA_STATIC uint64_t enigma_crack_hash(uint64_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Fingerprint a search for its checkpoint
+ *
+ * The fingerprint covers what decides which candidates a search runs and how they score: the
+ * crack function, the configuration the candidates are derived from, the ciphertext, the
+ * scoring function and its parameters, and the shard. Function pointers differ from run to
+ * run, so the crack function is identified by its candidate function's place in a table, and
+ * the scoring function by its place among the library's own (custom ones all hash alike).
+ * Rotors and reflectors are hashed by their wiring, for the same reason.
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param search The candidates of the search
+ * @param scoreFunc The text scoring function passed to the crack function
+ * @return The fingerprint
+ */
+ENIGMA_STATIC uint64_t enigma_crack_fingerprint(const EnigmaCrackParams* cfg,
+                                                const EnigmaCrackSearch* search,
+                                                float (*scoreFunc)(const EnigmaCrackParams*,
+                                                                   const char*)) {
+    int (*const candidates[])(const EnigmaCrackSearch*, size_t, Enigma*) = {
+        enigma_crack_plugboard_candidate,      enigma_crack_reflector_candidate,
+        enigma_crack_ring_settings_candidate,  enigma_crack_rotor_candidate,
+        enigma_crack_rotor_position_candidate, enigma_crack_rotor_positions_candidate,
+        enigma_crack_rotors_candidate,
+    };
+    float (*const scorers[])(const EnigmaCrackParams*, const char*) = {
+        enigma_bigram_score, enigma_trigram_score, enigma_quadgram_score,
+        enigma_ioc_score,    enigma_brute_score,
+    };
+    const Enigma* enigma = &search->enigma;
+    uint64_t      hash   = 0xcbf29ce484222325ULL;
+    int32_t       id     = -1;
+
+    for (int i = 0; i < (int) (sizeof(candidates) / sizeof(candidates[0])); i++) {
+        id = candidates[i] == search->candidate ? i : id;
+    }
+    hash = enigma_crack_hash(hash, &id, sizeof(id));
+    hash = enigma_crack_hash(hash, &search->slot, sizeof(search->slot));
+
+    // Configuration the candidates are derived from
+    hash = enigma_crack_hash(hash, &enigma->rotor_count, sizeof(enigma->rotor_count));
+    for (int i = 0; i < enigma->rotor_count && i < ENIGMA_MAX_ROTOR_COUNT; i++) {
+        if (enigma->rotors[i]) {
+            hash = enigma_crack_hash(
+                hash, enigma->rotors[i]->fwd_indices, sizeof(enigma->rotors[i]->fwd_indices));
+            hash = enigma_crack_hash(
+                hash, &enigma->rotors[i]->turnovers, sizeof(enigma->rotors[i]->turnovers));
+        }
+        hash = enigma_crack_hash(hash, &enigma->rotor_indices[i], sizeof(int));
+        hash = enigma_crack_hash(hash, &enigma->ring_settings[i], sizeof(int));
+    }
+    if (enigma->reflector) {
+        hash = enigma_crack_hash(
+            hash, enigma->reflector->indices, sizeof(enigma->reflector->indices));
+    }
+    hash = enigma_crack_hash(hash, enigma->plugboard, strlen(enigma->plugboard));
+
+    // Ciphertext, scoring function and the parameters that decide which scores are kept
+    hash = enigma_crack_hash(hash, cfg->ciphertext, cfg->ciphertext ? cfg->ciphertext_length : 0);
+    id   = -1;
+    for (int i = 0; i < (int) (sizeof(scorers) / sizeof(scorers[0])); i++) {
+        id = scorers[i] == scoreFunc ? i : id;
+    }
+    hash = enigma_crack_hash(hash, &id, sizeof(id));
+    hash = enigma_crack_hash(hash, &cfg->n, sizeof(cfg->n));
+    hash = enigma_crack_hash(
+        hash, cfg->ngrams, cfg->ngrams ? cfg->ngrams_length * sizeof(float) : 0);
+    hash = enigma_crack_hash(hash, &cfg->flags, sizeof(cfg->flags));
+    hash = enigma_crack_hash(hash, &cfg->min_score, sizeof(cfg->min_score));
+    hash = enigma_crack_hash(hash, &cfg->max_score, sizeof(cfg->max_score));
+    hash = enigma_crack_hash(hash, cfg->frequency_targets, sizeof(cfg->frequency_targets));
+    hash = enigma_crack_hash(hash,
+                             cfg->known_plaintext,
+                             cfg->known_plaintext ? (size_t) cfg->known_plaintext_length : 0);
+
+    // Shard of the keyspace
+    int32_t shard[2] = { cfg->shard_count > 1 ? cfg->shard : 0,
+                         cfg->shard_count > 1 ? cfg->shard_count : 1 };
+    return enigma_crack_hash(hash, shard, sizeof(shard));
+}
+
+/**
+ * @brief Prepare the candidates of a crack function call
+ *
+ * @param search The search to initialize
+ * @param enigma The configuration the candidates are derived from
+ * @param size The number of candidate indices
+ * @param candidate The function updating a candidate to an index
+ */
+ENIGMA_STATIC void enigma_crack_search_init(EnigmaCrackSearch* search,
+                                            const Enigma*      enigma,
+                                            size_t             size,
+                                            int (*candidate)(const EnigmaCrackSearch*,
+                                                             size_t,
+                                                             Enigma*)) {
+    memset(search, 0, sizeof(EnigmaCrackSearch));
+    search->enigma     = *enigma;
+    search->size       = size;
+    search->range_size = 1;
+    search->candidate  = candidate;
+}
+
+/**
+ * @brief Decode and score every candidate of a search
+ *
+ * Without an executor, the candidates are run on the calling thread and appended straight to
+ * `cfg->score_list`. With one, the candidates are split into ranges of `search->range_size`
+ * and handed out by a work-stealing scheduler (see EnigmaKeyspace), so that workers that
+ * finish early take over the ranges of slower ones. Each worker appends to its own score list,
+ * and the scores are merged range by range, which is candidate order.
+ *
+ * With a checkpoint, the search is always run range by range, even on the calling thread.
+ * Completed ranges are skipped, and the scores of each range are moved to the checkpoint as it
+ * completes, then appended to `cfg->score_list` once the search is done. A sharded search is
+ * also run range by range, over the ranges of its shard only.
+ *
+ * With a progress, the search is run range by range as well: each completed range is added to
+ * the progress, and no range is started once the progress is cancelled.
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param search The candidates to run
+ * @param scoreFunc The text scoring function passed to the crack function
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+ENIGMA_STATIC int enigma_crack_search(EnigmaCrackParams* cfg,
+                                      EnigmaCrackSearch* search,
+                                      float (*scoreFunc)(const EnigmaCrackParams*, const char*)) {
+    if (search->range_size < 1) {
+        search->range_size = 1;
+    }
+
+    size_t ranges = (search->size + search->range_size - 1) / search->range_size;
+    size_t count  = cfg->executor ? enigma_executor_get_thread_count(cfg->executor) : 1;
+    if (count > ranges) {
+        count = ranges;
+    }
+
+    search->checkpoint = cfg->checkpoint;
+    if (search->checkpoint
+        && enigma_checkpoint_begin(search->checkpoint,
+                                   enigma_crack_fingerprint(cfg, search, scoreFunc),
+                                   search->size,
+                                   search->range_size,
+                                   cfg->sink ? 0 : cfg->score_list->top_k)) {
+        return ENIGMA_FAILURE;
+    }
+
+    if (count <= 1 && !search->checkpoint && cfg->shard_count < 2 && !cfg->progress) {
+        EnigmaCrackContext ctx;
+        if (enigma_crack_context_init(&ctx, cfg, scoreFunc)) {
+            return ENIGMA_FAILURE;
+        }
+        enigma_crack_range(search, cfg, &ctx, 0, search->size);
+        enigma_crack_context_finish(cfg, &ctx);
+        return ENIGMA_SUCCESS;
+    }
+
+    if (enigma_keyspace_init(&search->keyspace, search->size, search->range_size, count)) {
+        return ENIGMA_FAILURE;
+    }
+    if (cfg->shard_count > 1 && enigma_crack_search_shard(cfg, search)) {
+        enigma_keyspace_free(&search->keyspace);
+        return ENIGMA_FAILURE;
+    }
+    search->progress = cfg->progress;
+    if (search->progress) {
+        enigma_progress_add_total(search->progress, enigma_crack_search_total(search));
+    }
+    search->ranges       = calloc(ranges, sizeof(EnigmaCrackRange));
+    search->workers      = calloc(count, sizeof(EnigmaCrackWorker));
+    search->worker_count = count;
+    if (!search->ranges || !search->workers) {
+        free(search->ranges);
+        free(search->workers);
+        enigma_keyspace_free(&search->keyspace);
+        return ENIGMA_ERROR("%s", "Failed to allocate worker state");
+    }
+
+    // Buffers are set up here rather than in the workers, so that errors are only reported once
+    size_t ready = 0;
+    int    ret   = ENIGMA_SUCCESS;
+    for (; ready < count; ready++) {
+        EnigmaCrackWorker* worker = &search->workers[ready];
+        worker->params            = *cfg;
+        worker->params.score_list = &worker->scores;
+        worker->scores.max_scores = ENIGMA_CRACK_WORKER_SCORES;
+        worker->scores.top_k      = cfg->sink || search->checkpoint ? 0 : cfg->score_list->top_k;
+        worker->scores.scores     = malloc(ENIGMA_CRACK_WORKER_SCORES * sizeof(EnigmaScore));
+        if (!worker->scores.scores) {
+            ret = ENIGMA_ERROR("%s", "Failed to allocate worker state");
+            break;
+        }
+        if (enigma_crack_context_init(&worker->ctx, &worker->params, scoreFunc)) {
+            free(worker->scores.scores);
+            ret = ENIGMA_FAILURE;
+            break;
+        }
+    }
+
+    if (ret == ENIGMA_SUCCESS) {
+        // With a sink, the workers wrote their scores as they went and their lists are empty
+        if (count > 1) {
+            enigma_executor_run(cfg->executor, enigma_crack_search_job, search);
+        } else {
+            enigma_crack_search_job(search, 0);
+        }
+        if (search->checkpoint) {
+            ret = enigma_crack_search_restore(cfg, search);
+        } else if (!cfg->sink) {
+            ret = enigma_crack_search_merge(cfg->score_list, search, ranges);
+        }
+    } else {
+        for (size_t i = 0; i < ready; i++) {
+            enigma_crack_context_free(&search->workers[i].ctx);
+        }
+    }
+
+    for (size_t i = 0; i < ready; i++) {
+        free(search->workers[i].scores.scores);
+    }
+    free(search->ranges);
+    free(search->workers);
+    enigma_keyspace_free(&search->keyspace);
+    return ret;
+}
+
+/**
+ * @brief Merge the workers' scores of a search into a score list
+ *
+ * Scores are merged range by range, so they are appended in candidate order. A top-K list
+ * keeps the best scores of all workers, whose own lists are top-K heaps of the same size.
+ *
+ * @param list The list to merge into
+ * @param search The search that was run
+ * @param ranges The number of ranges of the search
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+ENIGMA_STATIC int
+enigma_crack_search_merge(EnigmaScoreList* list, const EnigmaCrackSearch* search, size_t ranges) {
+    if (list->top_k > 0) {
+        for (int i = 0; i < search->worker_count; i++) {
+            const EnigmaScoreList* scores = &search->workers[i].scores;
+            for (int j = 0; j < scores->score_count; j++) {
+                if (enigma_score_list_push(list, &scores->scores[j])) {
+                    return ENIGMA_FAILURE;
+                }
+            }
+        }
+        return ENIGMA_SUCCESS;
+    }
+
+    for (size_t i = 0; i < ranges; i++) {
+        const EnigmaCrackRange* range  = &search->ranges[i];
+        const EnigmaScoreList*  scores = &search->workers[range->worker].scores;
+        if (enigma_crack_merge(list, scores->scores + range->offset, range->count)) {
+            return ENIGMA_ERROR("%s", "Failed to merge worker scores");
+        }
+    }
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Save the checkpoint of a finished search and append its scores to a score list
+ *
+ * The scores of the completed ranges are in the checkpoint, and those of ranges cut short by
+ * the target score are still in the workers' lists.
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param search The search that was run
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+ENIGMA_STATIC int
+enigma_crack_search_restore(EnigmaCrackParams* cfg, const EnigmaCrackSearch* search) {
+    const EnigmaScoreList* saved = enigma_checkpoint_get_scores(search->checkpoint);
+
+    if (enigma_checkpoint_save(search->checkpoint)) {
+        return ENIGMA_FAILURE;
+    }
+    if (cfg->sink) {
+        return ENIGMA_SUCCESS;
+    }
+
+    for (int i = 0; i < saved->score_count; i++) {
+        if (enigma_score_list_push(cfg->score_list, &saved->scores[i])) {
+            return ENIGMA_FAILURE;
+        }
+    }
+    for (int i = 0; i < search->worker_count; i++) {
+        const EnigmaScoreList* scores = &search->workers[i].scores;
+        for (int j = 0; j < scores->score_count; j++) {
+            if (enigma_score_list_push(cfg->score_list, &scores->scores[j])) {
+                return ENIGMA_FAILURE;
+            }
+        }
+    }
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Restrict the keyspace of a search to the shard set in the crack parameters
+ *
+ * The shards are balanced by the number of candidates of each range that are actually decoded,
+ * which takes one pass over the candidate indices without decoding anything.
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param search The search, whose keyspace is initialized
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+ENIGMA_STATIC int enigma_crack_search_shard(const EnigmaCrackParams* cfg,
+                                            EnigmaCrackSearch*       search) {
+    size_t  ranges = enigma_keyspace_get_range_count(&search->keyspace);
+    size_t* work   = calloc(ranges ? ranges : 1, sizeof(size_t));
+    if (!work) {
+        return ENIGMA_ERROR("%s", "Failed to allocate shard work");
+    }
+
+    Enigma enigma = search->enigma;
+    size_t first;
+    size_t last;
+    for (size_t i = 0; i < ranges; i++) {
+        enigma_keyspace_get_range(&search->keyspace, i, &first, &last);
+        for (size_t j = first; j < last; j++) {
+            work[i] += search->candidate(search, j, &enigma) != 0;
+        }
+    }
+
+    int ret = enigma_keyspace_shard(&search->keyspace, work, cfg->shard, cfg->shard_count);
+    free(work);
+    return ret;
+}
+
+/**
+ * @brief Count the candidate indices of the ranges a search will run
+ *
+ * These are the ranges of its shard, less those a checkpoint has completed.
+ *
+ * @param search The search, whose keyspace is initialized
+ * @return The number of candidate indices
+ */
+ENIGMA_STATIC size_t enigma_crack_search_total(const EnigmaCrackSearch* search) {
+    size_t total = 0;
+    size_t first;
+    size_t last;
+
+    for (int i = 0; i < search->keyspace.queue_count; i++) {
+        const EnigmaKeyspaceQueue* queue = &search->keyspace.queues[i];
+        for (size_t range = queue->first; range < queue->last; range++) {
+            if (search->checkpoint && enigma_checkpoint_is_done(search->checkpoint, range)) {
+                continue;
+            }
+            enigma_keyspace_get_range(&search->keyspace, range, &first, &last);
+            total += last - first;
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Run the ranges taken by one worker of a search
+ *
+ * This is the job passed to enigma_executor_run(). The queued candidates are flushed after
+ * every range, so that the scores of a range are contiguous in the worker's score list.
+ *
+ * @param arg The EnigmaCrackSearch being run
+ * @param index The index of the worker
+ */
+ENIGMA_STATIC void enigma_crack_search_job(void* arg, int index) {
+    EnigmaCrackSearch* search = arg;
+    if (index >= search->worker_count) {
+        // More threads than ranges
+        return;
+    }
+
+    EnigmaCrackWorker* worker = &search->workers[index];
+    size_t             range;
+    size_t             first;
+    size_t             last;
+
+    while (!__atomic_load_n(&search->stop, __ATOMIC_RELAXED)
+           && !(search->progress && enigma_progress_is_cancelled(search->progress))
+           && enigma_keyspace_next(&search->keyspace, index, &range) == 1) {
+        if (search->checkpoint && enigma_checkpoint_is_done(search->checkpoint, range)) {
+            continue;
+        }
+
+        EnigmaCrackRange* scores = &search->ranges[range];
+        scores->worker           = index;
+        scores->offset           = worker->scores.score_count;
+
+        enigma_keyspace_get_range(&search->keyspace, range, &first, &last);
+        size_t decoded = enigma_crack_range(search, &worker->params, &worker->ctx, first, last);
+        enigma_crack_flush(&worker->params, &worker->ctx);
+        scores->count = worker->scores.score_count - scores->offset;
+
+        if (search->progress) {
+            enigma_progress_add(search->progress,
+                                last - first,
+                                decoded,
+                                decoded * worker->params.ciphertext_length);
+        }
+
+        // A range that may have been cut short by the target score is left out of the
+        // checkpoint, so it runs again on resume; its scores stay in the worker's list
+        if (search->checkpoint && !__atomic_load_n(&search->stop, __ATOMIC_RELAXED)) {
+            enigma_checkpoint_complete(search->checkpoint, range, &worker->scores);
+        }
+    }
+    enigma_crack_context_free(&worker->ctx);
+}
+
+/**
+ * @brief Decode and score a range of candidates of a search
+ *
+ * @param search The search the candidates belong to
+ * @param cfg The EnigmaCrackParams to append the scores with
+ * @param ctx The decoding buffers to use
+ * @param first The index of the first candidate
+ * @param last The index past the last candidate
+ * @return The number of candidates decoded
+ */
+ENIGMA_STATIC size_t enigma_crack_range(EnigmaCrackSearch*  search,
+                                        EnigmaCrackParams*  cfg,
+                                        EnigmaCrackContext* ctx,
+                                        size_t              first,
+                                        size_t              last) {
+    Enigma enigma  = search->enigma;
+    size_t decoded = 0;
+    ctx->scrambler = search->scrambler;
+    ctx->stop      = &search->stop;
+
+    for (size_t i = first; i < last; i++) {
+        // Another worker may have reached the target score
+        if (__atomic_load_n(&search->stop, __ATOMIC_RELAXED)) {
+            break;
+        }
+        if (search->candidate(search, i, &enigma)) {
+            enigma_crack_candidate(cfg, ctx, &enigma);
+            decoded++;
+        }
+    }
+    return decoded;
+}
+
+/**
+ * @brief Append scores run by a worker to a score list
+ *
+ * @param list The list to append to
+ * @param scores The scores to append
+ * @param count The number of scores to append
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+ENIGMA_STATIC int enigma_crack_merge(EnigmaScoreList* list, const EnigmaScore* scores, int count) {
+    int needed = list->score_count + count;
+
+    if (needed > list->max_scores) {
+        int max = list->max_scores > 0 ? list->max_scores : 1;
+        while (max < needed) {
+            max *= 2;
+        }
+
+        EnigmaScore* grown = realloc(list->scores, max * sizeof(EnigmaScore));
+        if (!grown) {
+            return ENIGMA_FAILURE;
+        }
+        list->scores     = grown;
+        list->max_scores = max;
+    }
+
+    memcpy(list->scores + list->score_count, scores, count * sizeof(EnigmaScore));
+    list->score_count = needed;
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Update a candidate of enigma_crack_plugboard() to an index
+ *
+ * @param search The search the candidate belongs to
+ * @param index The index of the candidate
+ * @param enigma The candidate to update
+ * @return 1 if the index is a candidate, 0 if it is skipped
+ */
+ENIGMA_STATIC int
+enigma_crack_plugboard_candidate(const EnigmaCrackSearch* search, size_t index, Enigma* enigma) {
+    char* pair = &enigma->plugboard[search->slot * 2];
+    int   a    = index / ENIGMA_ALPHA_SIZE;
+    int   b    = index % ENIGMA_ALPHA_SIZE;
+
+    // Plugging b into a is the same as plugging a into b, so only a < b is tried
+    if (a >= b || !search->remaining[a] || !search->remaining[b]) {
+        return 0;
+    }
+
+    // Unplug the previous candidate's pair
+    if (pair[0]) {
+        enigma->plugboard_offsets[pair[0] - 'A'] = 0;
+        enigma->plugboard_offsets[pair[1] - 'A'] = 0;
+    }
+
+    pair[0]                       = 'A' + a;
+    pair[1]                       = 'A' + b;
+    pair[2]                       = '\0';
+    enigma->plugboard_offsets[a] = b - a;
+    enigma->plugboard_offsets[b] = a - b;
+    return 1;
+}
+
+/**
+ * @brief Update a candidate of enigma_crack_reflector() to an index
+ *
+ * @param search The search the candidate belongs to
+ * @param index The index of the candidate
+ * @param enigma The candidate to update
+ * @return 1
+ */
+ENIGMA_STATIC int
+enigma_crack_reflector_candidate(const EnigmaCrackSearch* search, size_t index, Enigma* enigma) {
+    enigma->reflector = enigma_reflectors[index];
+    return 1;
+}
+
+/**
+ * @brief Update a candidate of enigma_crack_ring_settings() to an index
+ *
+ * @param search The search the candidate belongs to
+ * @param index The index of the candidate
+ * @param enigma The candidate to update
+ * @return 1
+ */
+ENIGMA_STATIC int enigma_crack_ring_settings_candidate(const EnigmaCrackSearch* search,
+                                                       size_t                   index,
+                                                       Enigma*                  enigma) {
+    int digits[4];
+    for (int i = 3; i >= 0; i--) {
+        digits[i] = index % ENIGMA_ALPHA_SIZE;
+        index /= ENIGMA_ALPHA_SIZE;
+    }
+
+    enigma->ring_settings[0] = digits[0];
+    enigma->ring_settings[1] = digits[1];
+    enigma->rotor_indices[0] = (search->enigma.rotor_indices[0] + digits[0]) % ENIGMA_ALPHA_SIZE;
+    enigma->rotor_indices[1] = (digits[2] + digits[1]) % ENIGMA_ALPHA_SIZE;
+    enigma->rotor_indices[2] = digits[3];
+    return 1;
+}
+
+/**
+ * @brief Update a candidate of enigma_crack_rotor() to an index
+ *
+ * @param search The search the candidate belongs to
+ * @param index The index of the candidate
+ * @param enigma The candidate to update
+ * @return 1
+ */
+ENIGMA_STATIC int
+enigma_crack_rotor_candidate(const EnigmaCrackSearch* search, size_t index, Enigma* enigma) {
+    enigma->rotors[search->slot] = enigma_rotors[index];
+    return 1;
+}
+
+/**
+ * @brief Update a candidate of enigma_crack_rotors() to an index
+ *
+ * @param search The search the candidate belongs to
+ * @param index The index of the candidate
+ * @param enigma The candidate to update
+ * @return 1 if the index is a candidate, 0 if it uses a rotor twice
+ */
+ENIGMA_STATIC int
+enigma_crack_rotors_candidate(const EnigmaCrackSearch* search, size_t index, Enigma* enigma) {
+    int used = 0;
+
+    for (int i = enigma->rotor_count - 1; i >= 0; i--) {
+        int id = index % ENIGMA_ROTOR_COUNT;
+        if (used & (1 << id)) {
+            return 0;
+        }
+        used |= 1 << id;
+        enigma->rotors[i] = enigma_rotors[id];
+        index /= ENIGMA_ROTOR_COUNT;
+    }
+    return 1;
+}
+
+/**
+ * @brief Update a candidate of enigma_crack_rotor_position() to an index
+ *
+ * @param search The search the candidate belongs to
+ * @param index The index of the candidate
+ * @param enigma The candidate to update
+ * @return 1
+ */
+ENIGMA_STATIC int enigma_crack_rotor_position_candidate(const EnigmaCrackSearch* search,
+                                                        size_t                   index,
+                                                        Enigma*                  enigma) {
+    enigma->rotor_indices[search->slot] = index;
+    return 1;
+}
+
+/**
+ * @brief Update a candidate of enigma_crack_rotor_positions() to an index
+ *
+ * @param search The search the candidate belongs to
+ * @param index The index of the candidate
+ * @param enigma The candidate to update
+ * @return 1
+ */
+ENIGMA_STATIC int enigma_crack_rotor_positions_candidate(const EnigmaCrackSearch* search,
+                                                         size_t                   index,
+                                                         Enigma*                  enigma) {
+    for (int i = enigma->rotor_count - 1; i >= 0; i--) {
+        enigma->rotor_indices[i] = index % ENIGMA_ALPHA_SIZE;
+        index /= ENIGMA_ALPHA_SIZE;
+    }
+    return 1;
+}
+
+/**
+ * @brief Match a word in the dictionary with the given plaintext
+ *
+ * cfg->dictionary must be initialized and valid.
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param plaintext The plaintext string to match
+ * @return 1 on success, 0 on failure
+ */
+ENIGMA_STATIC int enigma_dict_match_word(const EnigmaCrackParams* cfg, char* plaintext) {
+    EnigmaTrie* node = cfg->dictionary;
+    for (int i = 0; plaintext[i] != '\0'; i++) {
+        int childIdx = plaintext[i] - 'A';
+        if (node->children[childIdx] == NULL) {
+            return 0;
+        }
+        node = node->children[childIdx];
+    }
+
+    return node->value == 1;
+}
+
+/**
+ * @brief Match a word of letter indices in the dictionary
+ *
+ * cfg->dictionary must be initialized and valid.
+ *
+ * @param cfg The EnigmaCrackParams struct instance
+ * @param word The letter indices of the word to match
+ * @param length The length of the word
+ * @return 1 on success, 0 on failure
+ */
+ENIGMA_STATIC int
+enigma_dict_match_word_indices(const EnigmaCrackParams* cfg, const uint8_t* word, size_t length) {
+    EnigmaTrie* node = cfg->dictionary;
+    for (size_t i = 0; i < length; i++) {
+        if (node->children[word[i]] == NULL) {
+            return 0;
+        }
+        node = node->children[word[i]];
     }
 
     return node->value == 1;
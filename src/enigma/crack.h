@@ -6,11 +6,16 @@
 #ifndef ENIGMA_CRACK_H
 #define ENIGMA_CRACK_H
 
+#include "checkpoint.h"
 #include "common.h"
 #include "enigma.h"
+#include "executor.h"
+#include "progress.h"
 #include "score.h"
+#include "sink.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
 #ifndef ENIGMA_FLAG_X_SEPARATED
 /**
@@ -86,6 +91,14 @@
 #define ENIGMA_PLUGBOARD_DEFINED 256
 #endif
 
+#ifndef ENIGMA_CRACK_BEAM_WIDTH
+/**
+ * @brief Default number of candidates carried from one stage to the next by enigma_crack_beam()
+ * and enigma_crack_auto().
+ */
+#define ENIGMA_CRACK_BEAM_WIDTH 10
+#endif
+
 /**
  * @struct EnigmaTrie
  * @brief A structure representing a trie for storing dictionary words, used in enigma_dict_match() for efficient word matching.
@@ -107,23 +120,64 @@ typedef struct {
     float*           ngrams; //!< An array of n-gram frequencies
     int              n; //!< The length of each n-gram
     size_t           ngrams_length; //!< The number of n-grams in the array
-    const char*      ciphertext; //!< The ciphertext to be cracked
+    const char*      ciphertext; //!< The ciphertext to be cracked (letters only, either case)
     size_t           ciphertext_length; //!< The length of the ciphertext
     int              flags; //!< Flags indicating special conditions a scored configuration may meet
     float            frequency_targets[26]; //!< An array of frequency targets for each letter
-    float            min_score; //!< The minimum score for a configuration to be considered
-    float            max_score; //!< The maximum score for a configuration to be considered
-    float            target_score; //!< The target score for a configuration to be considered
+    float            min_score; //!< Scores below this are dropped (if max_score > min_score)
+    float            max_score; //!< Scores above this are dropped (if max_score > min_score)
+    float            target_score; //!< A kept score at or above this ends the search (0 to disable)
     float target_frequency; //!< The target frequency for a configuration to be considered
     float
         frequency_offset; //!< The maximum offset from the target frequency that a scored configuration may have to be considered valid.
     const char*
         known_plaintext; //!< Known plaintext that must exist for a configuration to be considered
     int known_plaintext_length; //!< The length of the known plaintext
+    EnigmaExecutor* executor; //!< Worker pool to run on, or NULL to run on the calling thread
+    EnigmaSink* sink; //!< Where kept scores are written instead of `score_list`, or NULL
+    EnigmaCheckpoint* checkpoint; //!< Where the search's progress is saved, or NULL
+    int shard; //!< Index of the shard of the keyspace to search (see enigma_crack_set_shard())
+    int shard_count; //!< Number of shards the keyspace is split into (0 or 1 to search it all)
+    EnigmaProgress* progress; //!< Counters updated as the search runs, or NULL
 } EnigmaCrackParams;
 
+/**
+ * @brief A scoring function that takes decoded letter indices (0-25) instead of text.
+ *
+ * The indices hold `ciphertext_length` entries and are not null-terminated.
+ */
+typedef float (*EnigmaIndexScoreFunc)(const EnigmaCrackParams*, const uint8_t*);
+
+/**
+ * @brief Number of candidates the library's batch scoring functions interleave at a time.
+ */
+#define ENIGMA_SCORE_BATCH_LANES 8
+
+/**
+ * @brief A scoring function that scores the decoded letter indices of several candidates.
+ *
+ * The indices of candidate `i` start at `texts + i * ciphertext_length`, and its score is
+ * written to `scores[i]`.
+ */
+typedef void (*EnigmaBatchScoreFunc)(const EnigmaCrackParams*, const uint8_t*, int, float*);
+
+/**
+ * @brief A crack function searching around `cfg->enigma`, run from each seed by
+ * enigma_crack_beam().
+ */
+typedef int (*EnigmaCrackStage)(EnigmaCrackParams*,
+                                float (*)(const EnigmaCrackParams*, const char*));
+
 EnigmaCrackParams* enigma_crack_params_new(void);
 int                enigma_crack_params_validate(const EnigmaCrackParams*);
+int                enigma_crack_auto(EnigmaCrackParams*, int, int);
+int                enigma_crack_beam(EnigmaCrackParams*,
+                                     const EnigmaScoreList*,
+                                     int,
+                                     EnigmaCrackStage,
+                                     float (*)(const EnigmaCrackParams*, const char*));
+int   enigma_crack_ring_settings(EnigmaCrackParams*,
+                                 float (*)(const EnigmaCrackParams*, const char*));
 int   enigma_crack_rotor(EnigmaCrackParams*, int, float (*)(const EnigmaCrackParams*, const char*));
 int   enigma_crack_rotors(EnigmaCrackParams*, float (*)(const EnigmaCrackParams*, const char*));
 int   enigma_crack_rotor_position(EnigmaCrackParams*,
@@ -134,12 +188,15 @@ int   enigma_crack_rotor_positions(EnigmaCrackParams*,
 int   enigma_crack_reflector(EnigmaCrackParams*, float (*)(const EnigmaCrackParams*, const char*));
 int   enigma_crack_plugboard(EnigmaCrackParams*, float (*)(const EnigmaCrackParams*, const char*));
 int   enigma_dict_match(const EnigmaCrackParams*, const char*);
+int   enigma_dict_match_indices(const EnigmaCrackParams*, const uint8_t*);
 int   enigma_find_potential_indices(const char*, const char*, int*);
 int   enigma_free_dict(EnigmaCrackParams*);
 float enigma_freq(const char*, int);
 int   enigma_letter_freq(const EnigmaCrackParams*, const char*);
 int   enigma_score_append(EnigmaCrackParams*, Enigma*, const char*, float);
 int   enigma_score_flags(const EnigmaCrackParams*, const char*);
+EnigmaIndexScoreFunc enigma_index_score_function(float (*)(const EnigmaCrackParams*, const char*));
+EnigmaBatchScoreFunc enigma_batch_score_function(float (*)(const EnigmaCrackParams*, const char*));
 
 /* --- EnigmaCrackParams getters and setters --- */
 const Enigma*          enigma_crack_get_enigma(const EnigmaCrackParams*);
@@ -157,6 +214,12 @@ float                  enigma_crack_get_max_score(const EnigmaCrackParams*);
 float                  enigma_crack_get_target_score(const EnigmaCrackParams*);
 const char*            enigma_crack_get_known_plaintext(const EnigmaCrackParams*);
 size_t                 enigma_crack_get_known_plaintext_length(const EnigmaCrackParams*);
+EnigmaExecutor*        enigma_crack_get_executor(const EnigmaCrackParams*);
+EnigmaSink*            enigma_crack_get_sink(const EnigmaCrackParams*);
+EnigmaCheckpoint*      enigma_crack_get_checkpoint(const EnigmaCrackParams*);
+int                    enigma_crack_get_shard(const EnigmaCrackParams*);
+int                    enigma_crack_get_shard_count(const EnigmaCrackParams*);
+EnigmaProgress*        enigma_crack_get_progress(const EnigmaCrackParams*);
 int                    enigma_crack_set_enigma(EnigmaCrackParams*, Enigma*);
 int                    enigma_crack_set_score_list(EnigmaCrackParams*, EnigmaScoreList*);
 int                    enigma_crack_set_dictionary(EnigmaCrackParams*, EnigmaTrie*);
@@ -169,5 +232,10 @@ int                    enigma_crack_set_min_score(EnigmaCrackParams*, float);
 int                    enigma_crack_set_max_score(EnigmaCrackParams*, float);
 int                    enigma_crack_set_target_score(EnigmaCrackParams*, float);
 int                    enigma_crack_set_known_plaintext(EnigmaCrackParams*, const char*, size_t);
+int                    enigma_crack_set_executor(EnigmaCrackParams*, EnigmaExecutor*);
+int                    enigma_crack_set_sink(EnigmaCrackParams*, EnigmaSink*);
+int                    enigma_crack_set_checkpoint(EnigmaCrackParams*, EnigmaCheckpoint*);
+int                    enigma_crack_set_shard(EnigmaCrackParams*, int, int);
+int                    enigma_crack_set_progress(EnigmaCrackParams*, EnigmaProgress*);
 
 #endif
@@ -9,21 +9,51 @@
 
 #include "common.h"
 #include "io.h"
+#include "kernel.h"
 #include "rotor.h"
 
 #include <ctype.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
 #define ALPHA2IDX(c) ((c) - 'A')
 
-ENIGMA_STATIC ENIGMA_ALWAYS_INLINE void enigma_rotate(int*);
-ENIGMA_STATIC ENIGMA_ALWAYS_INLINE void enigma_rotate_rotors(Enigma*);
-ENIGMA_STATIC ENIGMA_ALWAYS_INLINE int  enigma_rotor_pass_forward(const EnigmaRotor*, int, int);
-ENIGMA_STATIC ENIGMA_ALWAYS_INLINE int  enigma_rotor_pass_reverse(const EnigmaRotor*, int, int);
-ENIGMA_STATIC ENIGMA_ALWAYS_INLINE char enigma_substitute(const char*, char);
+/**
+ * @brief A slice of the input encoded by one worker in enigma_encode_string_executor().
+ */
+typedef struct {
+    Enigma      enigma; //!< Machine state at the start of the slice.
+    const char* input; //!< Start of the input slice.
+    char*       output; //!< Start of the output slice.
+    int         length; //!< Number of characters in the slice.
+} EnigmaEncodeChunk;
+
+/**
+ * @brief The slices of one enigma_encode_string_executor() call, one per worker.
+ */
+typedef struct {
+    EnigmaEncodeChunk* chunks; //!< The slices, in input order.
+    int                count; //!< Number of slices.
+} EnigmaEncodeJob;
+
+ENIGMA_STATIC void                        enigma_encode_chunk(void*, int);
+ENIGMA_STATIC uint64_t                    enigma_plugboard_count(int);
+ENIGMA_STATIC uint64_t                    enigma_plugboard_rank(const int8_t*);
+ENIGMA_STATIC int                         enigma_plugboard_unrank(uint64_t, char*);
+ENIGMA_STATIC int                         enigma_validate_text(const char*, int);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE int    enigma_encode_idx(Enigma*, int);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE void   enigma_rotate(int*);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE void   enigma_rotate_rotors(Enigma*);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE int    enigma_rotor_pass_forward(const EnigmaRotor*, int, int);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE int    enigma_rotor_pass_reverse(const EnigmaRotor*, int, int);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE int    enigma_plug(const Enigma*, int);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE int    enigma_ring_offset(const Enigma*, int);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE int    enigma_scramble(const Enigma*, int);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE size_t enigma_scrambler_state(const Enigma*);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE char   enigma_substitute(const char*, char);
 
 #include <stdio.h>
 
@@ -31,10 +61,10 @@ ENIGMA_STATIC ENIGMA_ALWAYS_INLINE char enigma_substitute(const char*, char);
  * @brief Encode a character using the Enigma machine.
  *
  * This function takes an input character, processes it through the Enigma
- * machine's rotors and reflector, and returns the encoded character. It handles
- * both uppercase and lowercase characters.
+ * machine's rotors and reflector, and returns the encoded character.
  *
- * Assumes the input character is an uppercase ASCII letter.
+ * The input character must be an uppercase ASCII letter. To encode more than one character,
+ * prefer enigma_encode_string(), which validates its input once instead of per character.
  *
  * @param enigma Pointer to the Enigma machine structure.
  * @param c The character to encode.
@@ -42,35 +72,133 @@ ENIGMA_STATIC ENIGMA_ALWAYS_INLINE char enigma_substitute(const char*, char);
  */
 EMSCRIPTEN_KEEPALIVE char enigma_encode(Enigma* enigma, int c) {
     if (!enigma || c < 'A' || c > 'Z') {
-        fprintf(stderr, "%d\n", c - 'A');
         return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
     }
 
-    ENIGMA_STATIC const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-    c -= 'A';
+    return enigma_encode_idx(enigma, c - 'A') + 'A';
+}
 
-    enigma_rotate_rotors(enigma);
+/**
+ * @brief Encode a letter index using the Enigma machine.
+ *
+ * This is the same as enigma_encode(), but takes and returns the index of the letter in the
+ * alphabet (0 for 'A' through 25 for 'Z') instead of an ASCII character.
+ *
+ * @param enigma Pointer to the Enigma machine structure.
+ * @param c The index of the letter to encode.
+ * @return The index of the encoded letter, or ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_encode_index(Enigma* enigma, int c) {
+    if (!enigma || c < 0 || c >= ENIGMA_ALPHA_SIZE) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
 
-    // Plugboard
-    c = enigma_substitute(enigma->plugboard, c + 'A') - 'A';
+    return enigma_encode_idx(enigma, c);
+}
 
-    // Rotors
-    for (int i = 0; i < enigma->rotor_count; i++) {
-        c = enigma_rotor_pass_forward(enigma->rotors[i], enigma->rotor_indices[i], c);
+/**
+ * @brief Encode a buffer of letter indices using the Enigma machine.
+ *
+ * This is the same as enigma_encode_string(), but works on letter indices (0-25) instead of
+ * ASCII characters, so no conversion happens between letters. See enigma_text_to_indices()
+ * and enigma_indices_to_text() for converting to and from text.
+ *
+ * @param enigma Pointer to the Enigma machine structure.
+ * @param input The letter indices to encode.
+ * @param output The buffer to store the encoded indices (at least `length` entries).
+ * @param length The number of indices to encode.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int
+enigma_encode_indices(Enigma* enigma, const uint8_t* input, uint8_t* output, int length) {
+    if (!enigma || !input || !output || length <= 0) {
+        return ENIGMA_FAILURE;
     }
 
-    // Reflector
-    c = enigma->reflector->indices[c];
+    for (int i = 0; i < length; i++) {
+        if (input[i] >= ENIGMA_ALPHA_SIZE) {
+            return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        }
+    }
 
-    // Rotors in reverse
-    for (int i = enigma->rotor_count - 1; i >= 0; i--) {
-        c = enigma_rotor_pass_reverse(enigma->rotors[i], enigma->rotor_indices[i], c);
+    return enigma_encode_indices_unchecked(enigma, input, output, length);
+}
+
+/**
+ * @brief Encode a buffer of letter indices without validating it.
+ *
+ * This is the inner loop of enigma_encode_indices(). The arguments are not checked, so the
+ * caller must make sure that every entry of `input` is a letter index (0-25), e.g. by
+ * validating the buffer once before encoding it many times.
+ *
+ * Machines whose first three rotors are standard rotors are encoded with the kernel for their
+ * rotor order, see enigma_kernel_encode_indices().
+ *
+ * @param enigma Pointer to the Enigma machine structure.
+ * @param input The letter indices to encode.
+ * @param output The buffer to store the encoded indices (at least `length` entries).
+ * @param length The number of indices to encode.
+ * @return ENIGMA_SUCCESS
+ */
+EMSCRIPTEN_KEEPALIVE int
+enigma_encode_indices_unchecked(Enigma* enigma, const uint8_t* input, uint8_t* output, int length) {
+    if (enigma_kernel_encode_indices(enigma, input, output, length) == ENIGMA_SUCCESS) {
+        return ENIGMA_SUCCESS;
     }
 
-    // Plugboard again
-    c = enigma_substitute(enigma->plugboard, alphabet[c]);
+    for (int i = 0; i < length; i++) {
+        output[i] = enigma_encode_idx(enigma, input[i]);
+    }
 
-    return c;
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Convert text to letter indices.
+ *
+ * Lowercase letters are converted like uppercase ones, as in enigma_encode_string().
+ *
+ * @param text The text to convert (ASCII letters only).
+ * @param indices The buffer to store the indices (at least `length` entries).
+ * @param length The number of characters to convert.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE if `text` contains anything other than
+ * letters.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_text_to_indices(const char* text, uint8_t* indices, int length) {
+    if (!text || !indices || length < 0) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    for (int i = 0; i < length; i++) {
+        // Clearing bit 5 uppercases an ASCII letter
+        char c = text[i] & ~0x20;
+        if (c < 'A' || c > 'Z') {
+            return ENIGMA_FAILURE;
+        }
+        indices[i] = c - 'A';
+    }
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Convert letter indices to uppercase text.
+ *
+ * @param indices The indices to convert (0-25).
+ * @param text The buffer to store the text (at least `length + 1` characters, the result is
+ * null-terminated).
+ * @param length The number of indices to convert.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_indices_to_text(const uint8_t* indices, char* text, int length) {
+    if (!indices || !text || length < 0) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    for (int i = 0; i < length; i++) {
+        text[i] = indices[i] + 'A';
+    }
+    text[length] = '\0';
+    return ENIGMA_SUCCESS;
 }
 
 /**
@@ -78,13 +206,17 @@ EMSCRIPTEN_KEEPALIVE char enigma_encode(Enigma* enigma, int c) {
  *
  * This function encodes a string of characters using the Enigma machine.
  * It processes each character through the machine and stores the result in the
- * output string. Assumes the input string is uppercase and null-terminated.
+ * output string.
+ *
+ * The input is validated once before encoding: it may contain upper- and lowercase ASCII
+ * letters, and lowercase letters are encoded as their uppercase counterparts. If anything
+ * else is found, nothing is encoded and the rotors are left untouched.
  *
  * @param enigma Pointer to the Enigma machine structure.
  * @param input The input string to encode.
  * @param output The output string to store the encoded result.
  * @param length The length of the input string (the output buffer should be at
- * least the same length).
+ * least one character longer).
  * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
  */
 EMSCRIPTEN_KEEPALIVE int
@@ -93,14 +225,153 @@ enigma_encode_string(Enigma* enigma, const char* input, char* output, int length
         return ENIGMA_FAILURE;
     }
 
+    if (enigma_validate_text(input, length)) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    return enigma_encode_string_unchecked(enigma, input, output, length);
+}
+
+/**
+ * @brief Encode a string without validating it.
+ *
+ * This is the inner loop of enigma_encode_string(). The arguments are not checked, so the
+ * caller must make sure that `input` only contains ASCII letters (either case). The output is
+ * uppercase and null-terminated.
+ *
+ * @param enigma Pointer to the Enigma machine structure.
+ * @param input The input string to encode.
+ * @param output The output string to store the encoded result.
+ * @param length The length of the input string (the output buffer should be at
+ * least one character longer).
+ * @return ENIGMA_SUCCESS
+ */
+EMSCRIPTEN_KEEPALIVE int
+enigma_encode_string_unchecked(Enigma* enigma, const char* input, char* output, int length) {
     for (int i = 0; i < length; i++) {
-        output[i] = enigma_encode(enigma, input[i]);
+        // Clearing bit 5 uppercases an ASCII letter
+        output[i] = enigma_encode_idx(enigma, (input[i] & ~0x20) - 'A') + 'A';
+    }
+    output[length] = '\0';
+
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Encode a string on the workers of an executor.
+ *
+ * The input is split into one contiguous chunk per worker. Each chunk's starting rotor state
+ * is found with enigma_seek(), so the chunks are encoded independently and the output is
+ * identical to enigma_encode_string(). Afterwards, the rotors of `enigma` are left in the same
+ * state as after the serial call.
+ *
+ * Inputs shorter than `ENIGMA_PARALLEL_MIN_CHUNK` characters per worker use fewer workers;
+ * the calling thread is worker 0, so short inputs are encoded without waking the pool.
+ *
+ * @param enigma Pointer to the Enigma machine structure.
+ * @param input The input string to encode (ASCII letters only, see enigma_encode_string()).
+ * @param output The output string to store the encoded result.
+ * @param length The length of the input string (the output buffer should be at
+ * least one character longer).
+ * @param executor The executor to encode on.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_encode_string_executor(
+    Enigma* enigma, const char* input, char* output, int length, EnigmaExecutor* executor) {
+    if (!enigma || !input || !output || length <= 0 || !executor) {
+        return ENIGMA_FAILURE;
+    }
+
+    if (enigma_validate_text(input, length)) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    int chunkCount = length / ENIGMA_PARALLEL_MIN_CHUNK;
+    if (chunkCount > enigma_executor_get_thread_count(executor)) {
+        chunkCount = enigma_executor_get_thread_count(executor);
+    }
+    if (chunkCount <= 1 || enigma->rotor_count < 3) {
+        return enigma_encode_string_unchecked(enigma, input, output, length);
+    }
+
+    EnigmaEncodeChunk* chunks = malloc(chunkCount * sizeof(EnigmaEncodeChunk));
+    if (!chunks) {
+        return enigma_encode_string_unchecked(enigma, input, output, length);
     }
+
+    int offset = 0;
+    for (int i = 0; i < chunkCount; i++) {
+        chunks[i].enigma = *enigma;
+        chunks[i].input  = input + offset;
+        chunks[i].output = output + offset;
+        chunks[i].length = length / chunkCount + (i < length % chunkCount);
+        enigma_seek(&chunks[i].enigma, offset);
+        offset += chunks[i].length;
+    }
+
+    EnigmaEncodeJob job = { chunks, chunkCount };
+    if (enigma_executor_run(executor, enigma_encode_chunk, &job)) {
+        free(chunks);
+        return ENIGMA_FAILURE;
+    }
+
+    memcpy(enigma->rotor_indices,
+           chunks[chunkCount - 1].enigma.rotor_indices,
+           sizeof(enigma->rotor_indices));
     output[length] = '\0';
 
+    free(chunks);
     return ENIGMA_SUCCESS;
 }
 
+/**
+ * @brief Encode a string using several threads.
+ *
+ * This is enigma_encode_string_executor() on an executor created for the call and freed after
+ * it, so its threads are started and joined on every call. Each thread gets at least
+ * `ENIGMA_PARALLEL_MIN_CHUNK` characters, which takes far longer to encode than starting the
+ * thread, so on the large inputs this is meant for the cost does not show. Callers encoding
+ * many strings should create an executor once and call enigma_encode_string_executor().
+ *
+ * If no thread can be started, the input is encoded on the calling thread.
+ *
+ * @param enigma Pointer to the Enigma machine structure.
+ * @param input The input string to encode (ASCII letters only, see enigma_encode_string()).
+ * @param output The output string to store the encoded result.
+ * @param length The length of the input string (the output buffer should be at
+ * least one character longer).
+ * @param threads The maximum number of threads to use.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_encode_string_parallel(
+    Enigma* enigma, const char* input, char* output, int length, int threads) {
+    if (!enigma || !input || !output || length <= 0 || threads <= 0) {
+        return ENIGMA_FAILURE;
+    }
+
+    if (enigma_validate_text(input, length)) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    // Only start the threads that get a chunk
+    int chunkCount = length / ENIGMA_PARALLEL_MIN_CHUNK;
+    if (chunkCount > threads) {
+        chunkCount = threads;
+    }
+    if (chunkCount <= 1 || enigma->rotor_count < 3) {
+        return enigma_encode_string_unchecked(enigma, input, output, length);
+    }
+
+    EnigmaExecutor* executor = enigma_executor_new(chunkCount);
+    if (!executor) {
+        return enigma_encode_string_unchecked(enigma, input, output, length);
+    }
+
+    int ret = enigma_encode_string_executor(enigma, input, output, length, executor);
+    enigma_executor_free(executor);
+    return ret;
+}
+
 /**
  * @brief Initialize the rotors of the Enigma machine.
  *
@@ -131,6 +402,7 @@ EMSCRIPTEN_KEEPALIVE int enigma_init_rotors(Enigma* enigma, const EnigmaRotor* r
  * - Reflector: UKW-B
  * - Rotors: I, II, III
  * - Rotor positions: A, A, A
+ * - Ring settings: A, A, A
  * - Empty plugboard
  *
  * @param enigma Pointer to the `Enigma` to be initialized.
@@ -150,7 +422,9 @@ EMSCRIPTEN_KEEPALIVE int enigma_init_default_config(Enigma* enigma) {
     enigma->rotor_indices[1] = 0;
     enigma->rotor_indices[2] = 0;
     enigma->rotor_flag       = 0;
+    memset(enigma->ring_settings, 0, sizeof(enigma->ring_settings));
     memset(enigma->plugboard, 0, 27);
+    memset(enigma->plugboard_offsets, 0, ENIGMA_ALPHA_SIZE);
     return ENIGMA_SUCCESS;
 }
 
@@ -170,6 +444,7 @@ EMSCRIPTEN_KEEPALIVE int enigma_init_random_config(Enigma* enigma) {
     bool unique = false;
     char c      = '\0';
 
+    memset(enigma->ring_settings, 0, sizeof(enigma->ring_settings));
     if (rand() % 2) {
         enigma->rotor_count = 3;
     } else {
@@ -190,29 +465,31 @@ EMSCRIPTEN_KEEPALIVE int enigma_init_random_config(Enigma* enigma) {
         }
         enigma->rotors[i]        = candidate;
         enigma->rotor_indices[i] = rand() % ENIGMA_ALPHA_SIZE;
+        enigma->ring_settings[i] = rand() % ENIGMA_ALPHA_SIZE;
         unique                   = 0;
     }
 
     enigma->reflector = enigma_reflectors[rand() % ENIGMA_REFLECTOR_COUNT];
 
-    int plugboardSize = rand() % 11;
+    char plugboard[27];
+    int  plugboardSize = rand() % 11;
     for (int i = 0; i < plugboardSize * 2; i++) {
         unique = false;
         while (!unique) {
             unique = true;
             c      = 'A' + (rand() % ENIGMA_ALPHA_SIZE);
             for (int j = 0; j < i; j++) {
-                if (enigma->plugboard[j] == c) {
+                if (plugboard[j] == c) {
                     unique = false;
                     break;
                 }
             }
         }
-        enigma->plugboard[i] = c;
+        plugboard[i] = c;
     }
 
-    enigma->plugboard[plugboardSize * 2] = '\0';
-    return ENIGMA_SUCCESS;
+    plugboard[plugboardSize * 2] = '\0';
+    return enigma_set_plugboard(enigma, plugboard);
 }
 
 /**
@@ -229,6 +506,69 @@ EMSCRIPTEN_KEEPALIVE Enigma* enigma_new(void) {
     return enigma;
 }
 
+/**
+ * @brief Advance the rotors by a number of keypresses without encoding anything.
+ *
+ * After this call the rotor indices are the same as if `n` characters had been passed through
+ * enigma_encode(), so encoding can start at any offset of a message. The cost does not depend
+ * on `n`.
+ *
+ * The fast rotor always returns to its starting position after 26 keypresses, and the middle
+ * rotor's stepping only depends on the fast and middle rotors. The effect of a block of 26
+ * keypresses is therefore determined by the middle rotor's position alone, and the block
+ * sequence repeats within 26 blocks. Blocks are simulated until that repetition is found, the
+ * remaining whole cycles are applied to the left rotor at once, and the rest of the keypresses
+ * are simulated directly.
+ *
+ * @param enigma Pointer to the Enigma machine structure.
+ * @param n The number of keypresses to advance by.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_seek(Enigma* enigma, size_t n) {
+    if (!enigma || enigma->rotor_count < 3 || enigma->rotor_count > ENIGMA_MAX_ROTOR_COUNT
+        || !enigma->rotors[0] || !enigma->rotors[1]) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    size_t blocks = n / ENIGMA_ALPHA_SIZE;
+    size_t seen[ENIGMA_ALPHA_SIZE]; // Block at which each middle rotor position was seen
+    int    leftIndex[ENIGMA_ALPHA_SIZE + 1]; // Left rotor position at the start of each block
+    bool   cycled = false;
+
+    for (int i = 0; i < ENIGMA_ALPHA_SIZE; i++) {
+        seen[i] = SIZE_MAX;
+    }
+
+    for (size_t b = 0; b < blocks; b++) {
+        int middle = enigma->rotor_indices[1];
+        if (!cycled && seen[middle] != SIZE_MAX) {
+            size_t cycleLength = b - seen[middle];
+            size_t cycles      = (blocks - b) / cycleLength;
+            int    cycleSteps  = enigma->rotor_indices[2] - leftIndex[seen[middle]];
+            int    steps       = (cycles % ENIGMA_ALPHA_SIZE) * (cycleSteps + ENIGMA_ALPHA_SIZE);
+
+            enigma->rotor_indices[2] = (enigma->rotor_indices[2] + steps) % ENIGMA_ALPHA_SIZE;
+            b += cycles * cycleLength;
+            cycled = true;
+            if (b == blocks) {
+                break;
+            }
+        } else if (!cycled) {
+            seen[middle] = b;
+            leftIndex[b] = enigma->rotor_indices[2];
+        }
+
+        for (int i = 0; i < ENIGMA_ALPHA_SIZE; i++) {
+            enigma_rotate_rotors(enigma);
+        }
+    }
+
+    for (size_t i = 0; i < n % ENIGMA_ALPHA_SIZE; i++) {
+        enigma_rotate_rotors(enigma);
+    }
+    return ENIGMA_SUCCESS;
+}
+
 /**
  * @brief Get the version of the Enigma library.
  *
@@ -238,6 +578,312 @@ EMSCRIPTEN_KEEPALIVE Enigma* enigma_new(void) {
  */
 EMSCRIPTEN_KEEPALIVE const char* enigma_version(void) { return ENIGMA_VERSION; }
 
+/**
+ * @brief Build the scrambler permutation cache for an Enigma's rotor order and reflector.
+ *
+ * This computes the scrambler permutation for every possible rotor state of the given
+ * machine's rotors and reflector. The rotor positions, ring settings and plugboard of `enigma`
+ * are ignored, so the same cache can be used for every starting position, ring setting and
+ * plugboard setting: states are numbered by ring offset (position minus ring setting), which is
+ * all the wiring depends on.
+ *
+ * The cache must be released with enigma_scrambler_free().
+ *
+ * @param scrambler Pointer to the `EnigmaScrambler` to initialize.
+ * @param enigma Pointer to the Enigma machine providing the rotors and reflector.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_scrambler_init(EnigmaScrambler* scrambler, const Enigma* enigma) {
+    if (!scrambler || !enigma || !enigma->reflector || enigma->rotor_count <= 0
+        || enigma->rotor_count > ENIGMA_MAX_ROTOR_COUNT) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    size_t stateCount = 1;
+    for (int i = 0; i < enigma->rotor_count; i++) {
+        if (!enigma->rotors[i]) {
+            return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        }
+        stateCount *= ENIGMA_ALPHA_SIZE;
+    }
+
+    uint8_t* permutations = malloc(stateCount * ENIGMA_ALPHA_SIZE);
+    if (!permutations) {
+        return ENIGMA_ERROR("%s", "Failed to allocate scrambler permutations");
+    }
+
+    Enigma state = *enigma;
+    memset(state.ring_settings, 0, sizeof(state.ring_settings));
+    for (size_t s = 0; s < stateCount; s++) {
+        size_t digits = s;
+        for (int i = 0; i < state.rotor_count; i++) {
+            state.rotor_indices[i] = digits % ENIGMA_ALPHA_SIZE;
+            digits /= ENIGMA_ALPHA_SIZE;
+        }
+
+        uint8_t* permutation = &permutations[s * ENIGMA_ALPHA_SIZE];
+        for (int c = 0; c < ENIGMA_ALPHA_SIZE; c++) {
+            permutation[c] = enigma_scramble(&state, c);
+        }
+    }
+
+    for (int i = 0; i < ENIGMA_MAX_ROTOR_COUNT; i++) {
+        scrambler->rotors[i] = i < enigma->rotor_count ? enigma->rotors[i] : NULL;
+    }
+    scrambler->rotor_count  = enigma->rotor_count;
+    scrambler->reflector    = enigma->reflector;
+    scrambler->state_count  = stateCount;
+    scrambler->permutations = permutations;
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Free the permutation table of an `EnigmaScrambler`.
+ *
+ * @param scrambler Pointer to the `EnigmaScrambler` to free.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_scrambler_free(EnigmaScrambler* scrambler) {
+    if (!scrambler) {
+        return ENIGMA_FAILURE;
+    }
+    free(scrambler->permutations);
+    scrambler->permutations = NULL;
+    scrambler->state_count  = 0;
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Check whether a scrambler cache was built for an Enigma's rotor order and reflector.
+ *
+ * @param scrambler Pointer to the `EnigmaScrambler`.
+ * @param enigma Pointer to the Enigma machine.
+ * @return 1 if the cache can be used to encode with `enigma`, 0 otherwise.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_scrambler_matches(const EnigmaScrambler* scrambler,
+                                                  const Enigma*          enigma) {
+    if (!scrambler || !enigma || !scrambler->permutations
+        || scrambler->rotor_count != enigma->rotor_count
+        || scrambler->reflector != enigma->reflector) {
+        return 0;
+    }
+
+    for (int i = 0; i < enigma->rotor_count; i++) {
+        if (scrambler->rotors[i] != enigma->rotors[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Encode a string using a precomputed scrambler cache.
+ *
+ * This produces the same output as enigma_encode_string(), but replaces the walk through the
+ * rotors and reflector with a single lookup into the scrambler cache. The rotors of `enigma`
+ * are stepped as usual, and its plugboard is applied on both sides of the scrambler.
+ *
+ * The cache must have been built for the rotor order and reflector of `enigma` (see
+ * enigma_scrambler_matches()). Assumes the input string is uppercase.
+ *
+ * @param scrambler Pointer to the `EnigmaScrambler` built for `enigma`.
+ * @param enigma Pointer to the Enigma machine structure.
+ * @param input The input string to encode.
+ * @param output The output string to store the encoded result.
+ * @param length The length of the input string (the output buffer should be at
+ * least one character longer).
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_scrambler_encode_string(const EnigmaScrambler* scrambler,
+                                                        Enigma*                enigma,
+                                                        const char*            input,
+                                                        char*                  output,
+                                                        int                    length) {
+    if (!enigma_scrambler_matches(scrambler, enigma) || !input || !output || length <= 0) {
+        return ENIGMA_FAILURE;
+    }
+
+    for (int i = 0; i < length; i++) {
+        if (input[i] < 'A' || input[i] > 'Z') {
+            return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        }
+    }
+
+    for (int i = 0; i < length; i++) {
+        enigma_rotate_rotors(enigma);
+
+        const uint8_t* permutation
+            = &scrambler->permutations[enigma_scrambler_state(enigma) * ENIGMA_ALPHA_SIZE];
+        int c     = enigma_plug(enigma, input[i] - 'A');
+        output[i] = enigma_plug(enigma, permutation[c]) + 'A';
+    }
+    output[length] = '\0';
+
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Encode a buffer of letter indices using a precomputed scrambler cache.
+ *
+ * This is the index-domain counterpart of enigma_scrambler_encode_string().
+ *
+ * @param scrambler Pointer to the `EnigmaScrambler` built for `enigma`.
+ * @param enigma Pointer to the Enigma machine structure.
+ * @param input The letter indices to encode.
+ * @param output The buffer to store the encoded indices (at least `length` entries).
+ * @param length The number of indices to encode.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_scrambler_encode_indices(const EnigmaScrambler* scrambler,
+                                                         Enigma*                enigma,
+                                                         const uint8_t*         input,
+                                                         uint8_t*               output,
+                                                         int                    length) {
+    if (!enigma_scrambler_matches(scrambler, enigma) || !input || !output || length <= 0) {
+        return ENIGMA_FAILURE;
+    }
+
+    for (int i = 0; i < length; i++) {
+        if (input[i] >= ENIGMA_ALPHA_SIZE) {
+            return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        }
+    }
+
+    return enigma_scrambler_encode_indices_unchecked(scrambler, enigma, input, output, length);
+}
+
+/**
+ * @brief Encode a buffer of letter indices using a scrambler cache without validating it.
+ *
+ * This is the inner loop of enigma_scrambler_encode_indices(). The arguments are not checked,
+ * so the caller must make sure that the cache matches `enigma` and that every entry of
+ * `input` is a letter index (0-25).
+ *
+ * @param scrambler Pointer to the `EnigmaScrambler` built for `enigma`.
+ * @param enigma Pointer to the Enigma machine structure.
+ * @param input The letter indices to encode.
+ * @param output The buffer to store the encoded indices (at least `length` entries).
+ * @param length The number of indices to encode.
+ * @return ENIGMA_SUCCESS
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_scrambler_encode_indices_unchecked(const EnigmaScrambler* scrambler,
+                                                                   Enigma*                enigma,
+                                                                   const uint8_t*         input,
+                                                                   uint8_t*               output,
+                                                                   int                    length) {
+    for (int i = 0; i < length; i++) {
+        enigma_rotate_rotors(enigma);
+
+        const uint8_t* permutation
+            = &scrambler->permutations[enigma_scrambler_state(enigma) * ENIGMA_ALPHA_SIZE];
+        output[i] = enigma_plug(enigma, permutation[enigma_plug(enigma, input[i])]);
+    }
+
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Compare two keys.
+ *
+ * This gives keys a total order, e.g. for sorting or removing duplicates. Keys compare equal if
+ * and only if they describe the same configuration.
+ *
+ * @param a The first key.
+ * @param b The second key.
+ * @return A negative number, 0, or a positive number if `a` orders before, the same as, or after
+ * `b`.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_key_compare(const EnigmaKey* a, const EnigmaKey* b) {
+    if (a->plugboard != b->plugboard) {
+        return a->plugboard < b->plugboard ? -1 : 1;
+    }
+    return memcmp(a->rotors, b->rotors, sizeof(EnigmaKey) - sizeof(uint64_t));
+}
+
+/**
+ * @brief Pack an Enigma machine configuration into a key.
+ *
+ * The rotors and reflector must be standard ones. They are matched by their wiring, so copies of
+ * the standard rotors are accepted as well.
+ *
+ * @param key Pointer to the key to fill.
+ * @param enigma Pointer to the Enigma machine to pack.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_key_from_enigma(EnigmaKey* key, const Enigma* enigma) {
+    if (!key || !enigma || !enigma->reflector || enigma->rotor_count < 3
+        || enigma->rotor_count > ENIGMA_MAX_ROTOR_COUNT) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    memset(key, 0, sizeof(EnigmaKey));
+    for (int i = 0; i < enigma->rotor_count; i++) {
+        int id = enigma->rotors[i] ? enigma_rotor_id(enigma->rotors[i]) : ENIGMA_FAILURE;
+        if (id < 0 || enigma->rotor_indices[i] < 0
+            || enigma->rotor_indices[i] >= ENIGMA_ALPHA_SIZE || enigma->ring_settings[i] < 0
+            || enigma->ring_settings[i] >= ENIGMA_ALPHA_SIZE) {
+            return ENIGMA_ERROR("%s", "Only standard rotors can be stored in a key");
+        }
+
+        // Rings past rotor 1 never affect stepping, so they are folded into the position
+        int position = enigma->rotor_indices[i];
+        if (i < 2) {
+            key->rings[i] = enigma->ring_settings[i];
+        } else {
+            position = enigma_ring_offset(enigma, i);
+        }
+        key->rotors[i] = id | (position << 3);
+    }
+
+    int id = enigma_reflector_id(enigma->reflector);
+    if (id < 0) {
+        return ENIGMA_ERROR("%s", "Only standard reflectors can be stored in a key");
+    }
+
+    key->reflector   = id;
+    key->rotor_count = enigma->rotor_count;
+    key->plugboard   = enigma_plugboard_rank(enigma->plugboard_offsets);
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Unpack a key into an Enigma machine configuration.
+ *
+ * @param key Pointer to the key to unpack.
+ * @param enigma Pointer to the Enigma machine to fill.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_key_to_enigma(const EnigmaKey* key, Enigma* enigma) {
+    char plugboard[27];
+
+    if (!key || !enigma || key->rotor_count < 3 || key->rotor_count > ENIGMA_MAX_ROTOR_COUNT
+        || key->reflector >= ENIGMA_REFLECTOR_COUNT
+        || enigma_plugboard_unrank(key->plugboard, plugboard)) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    for (int i = 0; i < key->rotor_count; i++) {
+        if ((key->rotors[i] & 7) >= ENIGMA_ROTOR_COUNT
+            || (key->rotors[i] >> 3) >= ENIGMA_ALPHA_SIZE) {
+            return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        }
+    }
+    if (key->rings[0] >= ENIGMA_ALPHA_SIZE || key->rings[1] >= ENIGMA_ALPHA_SIZE) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    memset(enigma, 0, sizeof(Enigma));
+    for (int i = 0; i < key->rotor_count; i++) {
+        enigma->rotors[i]        = enigma_rotors[key->rotors[i] & 7];
+        enigma->rotor_indices[i] = key->rotors[i] >> 3;
+    }
+    enigma->ring_settings[0] = key->rings[0];
+    enigma->ring_settings[1] = key->rings[1];
+    enigma->rotor_count      = key->rotor_count;
+    enigma->reflector        = enigma_reflectors[key->reflector];
+    return enigma_set_plugboard(enigma, plugboard);
+}
+
 /**
  * @brief Get the plugboard configuration.
  *
@@ -270,6 +916,20 @@ EMSCRIPTEN_KEEPALIVE const EnigmaReflector* enigma_get_reflector(const Enigma* e
     return enigma->reflector;
 }
 
+/**
+ * @brief Get the ring setting of a rotor.
+ *
+ * @param enigma Pointer to the Enigma machine.
+ * @param rotor Index of the rotor in the Enigma machine.
+ * @return Ring setting of the rotor (0 for 'A'), or ENIGMA_FAILURE if the arguments are invalid.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_get_ring_setting(const Enigma* enigma, int rotor) {
+    if (!enigma || rotor < 0 || rotor >= ENIGMA_MAX_ROTOR_COUNT) {
+        return ENIGMA_FAILURE;
+    }
+    return enigma->ring_settings[rotor];
+}
+
 /**
  * @brief Get the rotor configuration.
  *
@@ -337,29 +997,49 @@ EMSCRIPTEN_KEEPALIVE int enigma_get_rotor_index(const Enigma* enigma, int rotor)
  * @brief Set the plugboard configuration.
  *
  * This function sets the plugboard configuration based on the provided string.
- * The string should contain pairs of uppercase letters representing the
- * connections between the letters. For example, "ABCDEF" would connect A to B,
- * C to D, and E to F.
+ * The string should contain pairs of letters representing the connections
+ * between the letters. For example, "ABCDEF" would connect A to B, C to D, and
+ * E to F. Lowercase letters are stored as uppercase, and each letter may only
+ * appear once.
+ *
+ * Both the plugboard string and the plugboard permutation table are updated.
  *
  * @param enigma Pointer to the Enigma machine.
  * @param s Pointer to the string containing the plugboard configuration.
  * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
  */
 EMSCRIPTEN_KEEPALIVE int enigma_set_plugboard(Enigma* enigma, const char* s) {
-    if (!enigma || !s || strlen(s) % 2 != 0 || strlen(s) > 26) {
+    if (!enigma || !s) {
         return ENIGMA_FAILURE;
     }
-    int i = 0;
-    while (s[i] != '\0') {
-        char c = toupper(s[i]);
-        if (c >= 'A' && c <= 'Z') {
-            enigma->plugboard[i] = s[i];
-            i++;
-        } else {
+
+    size_t len = strlen(s);
+    if (len % 2 != 0 || len > ENIGMA_ALPHA_SIZE) {
+        return ENIGMA_FAILURE;
+    }
+
+    char   plugboard[27];
+    int8_t offsets[ENIGMA_ALPHA_SIZE] = { 0 };
+    bool   used[ENIGMA_ALPHA_SIZE]    = { false };
+    for (size_t i = 0; i < len; i++) {
+        char c = toupper((unsigned char) s[i]);
+        if (c < 'A' || c > 'Z' || used[c - 'A']) {
             return ENIGMA_FAILURE;
         }
+        used[c - 'A'] = true;
+        plugboard[i]  = c;
     }
-    enigma->plugboard[i] = '\0';
+    plugboard[len] = '\0';
+
+    for (size_t i = 0; i < len; i += 2) {
+        int a      = plugboard[i] - 'A';
+        int b      = plugboard[i + 1] - 'A';
+        offsets[a] = b - a;
+        offsets[b] = a - b;
+    }
+
+    memcpy(enigma->plugboard, plugboard, len + 1);
+    memcpy(enigma->plugboard_offsets, offsets, sizeof(offsets));
     return ENIGMA_SUCCESS;
 }
 
@@ -380,6 +1060,26 @@ EMSCRIPTEN_KEEPALIVE int enigma_set_reflector(Enigma* enigma, int reflector) {
     return ENIGMA_SUCCESS;
 }
 
+/**
+ * @brief Set the ring setting of a rotor.
+ *
+ * The rotor position is left as it is, so the rotor's wiring turns by the difference between
+ * the old and new ring settings.
+ *
+ * @param enigma Pointer to the Enigma machine.
+ * @param rotor Index of the rotor in the Enigma machine.
+ * @param ring Ring setting to set (0 for 'A' to 25 for 'Z').
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_set_ring_setting(Enigma* enigma, int rotor, int ring) {
+    if (!enigma || rotor < 0 || rotor >= enigma->rotor_count || ring < 0
+        || ring >= ENIGMA_ALPHA_SIZE) {
+        return ENIGMA_FAILURE;
+    }
+    enigma->ring_settings[rotor] = ring;
+    return ENIGMA_SUCCESS;
+}
+
 /**
  * @brief Set the rotor
  *
@@ -451,6 +1151,165 @@ EMSCRIPTEN_KEEPALIVE int enigma_set_rotor_index(Enigma* enigma, int rotor, int i
     return ENIGMA_SUCCESS;
 }
 
+/**
+ * @brief Encode the chunk of the input of one worker, for enigma_encode_string_executor().
+ *
+ * @param arg Pointer to the `EnigmaEncodeJob` to run.
+ * @param worker The index of the worker, which is the index of its chunk.
+ */
+ENIGMA_STATIC void enigma_encode_chunk(void* arg, int worker) {
+    EnigmaEncodeJob* job = arg;
+    if (worker >= job->count) {
+        return;
+    }
+
+    EnigmaEncodeChunk* chunk = &job->chunks[worker];
+    for (int i = 0; i < chunk->length; i++) {
+        chunk->output[i] = enigma_encode_idx(&chunk->enigma, (chunk->input[i] & ~0x20) - 'A') + 'A';
+    }
+}
+
+/**
+ * @brief Count the plugboard permutations of a number of letters.
+ *
+ * These are the permutations that swap letters in pairs, with any number of pairs.
+ *
+ * @param n The number of letters.
+ * @return The number of plugboard permutations.
+ */
+ENIGMA_STATIC uint64_t enigma_plugboard_count(int n) {
+    uint64_t prev  = 1;
+    uint64_t count = 1;
+    for (int i = 2; i <= n; i++) {
+        uint64_t next = count + (i - 1) * prev;
+        prev          = count;
+        count         = next;
+    }
+    return count;
+}
+
+/**
+ * @brief Get the rank of a plugboard permutation among all plugboard permutations.
+ *
+ * Letters are taken in alphabetical order. The first remaining letter is either unplugged, which
+ * ranks before every permutation where it is plugged, or swapped with the `k`th of the other
+ * remaining letters, which skips `k` blocks of permutations of the letters left after the pair.
+ *
+ * @param offsets The plugboard permutation as letter offsets (see `Enigma`).
+ * @return The rank, less than enigma_plugboard_count(ENIGMA_ALPHA_SIZE).
+ */
+ENIGMA_STATIC uint64_t enigma_plugboard_rank(const int8_t* offsets) {
+    int      remaining[ENIGMA_ALPHA_SIZE];
+    int      n    = ENIGMA_ALPHA_SIZE;
+    uint64_t rank = 0;
+
+    for (int i = 0; i < ENIGMA_ALPHA_SIZE; i++) {
+        remaining[i] = i;
+    }
+
+    while (n > 1) {
+        int a = remaining[0];
+        int b = a + offsets[a];
+        int k = 1;
+
+        if (a == b) {
+            memmove(remaining, remaining + 1, --n * sizeof(int));
+            continue;
+        }
+
+        while (remaining[k] != b) {
+            k++;
+        }
+        rank += enigma_plugboard_count(n - 1) + (k - 1) * enigma_plugboard_count(n - 2);
+        memmove(remaining + k, remaining + k + 1, (n - k - 1) * sizeof(int));
+        memmove(remaining, remaining + 1, (n - 2) * sizeof(int));
+        n -= 2;
+    }
+    return rank;
+}
+
+/**
+ * @brief Get the plugboard permutation with a given rank.
+ *
+ * This is the inverse of enigma_plugboard_rank().
+ *
+ * @param rank The rank of the permutation.
+ * @param plugboard The buffer to store the plugboard pairs in (at least 27 characters).
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE if the rank is out of range.
+ */
+ENIGMA_STATIC int enigma_plugboard_unrank(uint64_t rank, char* plugboard) {
+    int remaining[ENIGMA_ALPHA_SIZE];
+    int n     = ENIGMA_ALPHA_SIZE;
+    int pairs = 0;
+
+    if (rank >= enigma_plugboard_count(ENIGMA_ALPHA_SIZE)) {
+        return ENIGMA_FAILURE;
+    }
+
+    for (int i = 0; i < ENIGMA_ALPHA_SIZE; i++) {
+        remaining[i] = i;
+    }
+
+    while (n > 1) {
+        uint64_t unplugged = enigma_plugboard_count(n - 1);
+        if (rank < unplugged) {
+            memmove(remaining, remaining + 1, --n * sizeof(int));
+            continue;
+        }
+
+        uint64_t block = enigma_plugboard_count(n - 2);
+        int      k     = 1 + (rank - unplugged) / block;
+        rank           = (rank - unplugged) % block;
+
+        plugboard[pairs * 2]     = 'A' + remaining[0];
+        plugboard[pairs * 2 + 1] = 'A' + remaining[k];
+        pairs++;
+        memmove(remaining + k, remaining + k + 1, (n - k - 1) * sizeof(int));
+        memmove(remaining, remaining + 1, (n - 2) * sizeof(int));
+        n -= 2;
+    }
+
+    plugboard[pairs * 2] = '\0';
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Check that a buffer only contains ASCII letters.
+ *
+ * @param text The buffer to check.
+ * @param length The number of characters to check.
+ * @return ENIGMA_SUCCESS if every character is a letter, ENIGMA_FAILURE otherwise.
+ */
+ENIGMA_STATIC int enigma_validate_text(const char* text, int length) {
+    for (int i = 0; i < length; i++) {
+        char c = text[i] & ~0x20;
+        if (c < 'A' || c > 'Z') {
+            return ENIGMA_FAILURE;
+        }
+    }
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Encode a letter index, stepping the rotors first.
+ *
+ * @param enigma Pointer to the Enigma machine structure.
+ * @param c The index of the letter in the alphabet.
+ * @return The index of the encoded letter.
+ */
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE int enigma_encode_idx(Enigma* enigma, int c) {
+    enigma_rotate_rotors(enigma);
+
+    // Plugboard
+    c = enigma_plug(enigma, c);
+
+    // Rotors, reflector, and rotors in reverse
+    c = enigma_scramble(enigma, c);
+
+    // Plugboard again
+    return enigma_plug(enigma, c);
+}
+
 /**
  * @brief Rotate a single rotor by one position.
  *
@@ -470,30 +1329,17 @@ ENIGMA_STATIC ENIGMA_ALWAYS_INLINE void enigma_rotate(int* idx) {
  * @brief Rotate the rotors of the Enigma machine.
  *
  * This function rotates the first rotor by one position and checks if the
- * next rotors need to be rotated based on the notches.
+ * next rotors need to be rotated based on the rotors' turnover masks.
  *
  * @param enigma Pointer to the Enigma machine structure.
  */
 ENIGMA_STATIC ENIGMA_ALWAYS_INLINE void enigma_rotate_rotors(Enigma* enigma) {
-    int turned = 0;
-    for (int i = 0; i < enigma->rotors[1]->notches_count; i++) {
-        if (enigma->rotors[1]->fwd_indices[enigma->rotor_indices[1]]
-            == enigma->rotors[1]->notches[i]) {
-            enigma_rotate(&enigma->rotor_indices[1]);
-            enigma_rotate(&enigma->rotor_indices[2]);
-            turned = 1;
-            break;
-        }
-    }
-
-    if (!turned) {
-        for (int i = 0; i < enigma->rotors[0]->notches_count; i++) {
-            if (enigma->rotors[0]->fwd_indices[enigma->rotor_indices[0]]
-                == enigma->rotors[0]->notches[i]) {
-                enigma_rotate(&enigma->rotor_indices[1]);
-                break;
-            }
-        }
+    if ((enigma->rotors[1]->turnovers >> enigma->rotor_indices[1]) & 1) {
+        // Double step
+        enigma_rotate(&enigma->rotor_indices[1]);
+        enigma_rotate(&enigma->rotor_indices[2]);
+    } else if ((enigma->rotors[0]->turnovers >> enigma->rotor_indices[0]) & 1) {
+        enigma_rotate(&enigma->rotor_indices[1]);
     }
     enigma_rotate(&enigma->rotor_indices[0]);
 }
@@ -548,6 +1394,67 @@ enigma_rotor_pass_reverse(const EnigmaRotor* rotor, int rotIdx, int idx) {
     return idx;
 }
 
+/**
+ * @brief Pass a character index through the plugboard.
+ *
+ * @param enigma Pointer to the Enigma machine structure.
+ * @param c The index of the character in the alphabet.
+ * @return The index of the character it is swapped with, or `c` if unplugged.
+ */
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE int enigma_plug(const Enigma* enigma, int c) {
+    return c + enigma->plugboard_offsets[c];
+}
+
+/**
+ * @brief Get the offset of a rotor's wiring, i.e. its position minus its ring setting.
+ *
+ * @param enigma Pointer to the Enigma machine structure.
+ * @param rotor The index of the rotor.
+ * @return The ring offset of the rotor (0-25).
+ */
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE int enigma_ring_offset(const Enigma* enigma, int rotor) {
+    int offset = enigma->rotor_indices[rotor] - enigma->ring_settings[rotor];
+    return offset < 0 ? offset + ENIGMA_ALPHA_SIZE : offset;
+}
+
+/**
+ * @brief Pass a character index through the scrambler at the current rotor positions.
+ *
+ * This passes the character through each rotor, the reflector, and back through the rotors
+ * in reverse, each rotor's wiring being turned by its ring offset. It does not step the rotors
+ * or apply the plugboard.
+ *
+ * @param enigma Pointer to the Enigma machine structure.
+ * @param c The index of the character in the alphabet.
+ * @return The index of the scrambled character.
+ */
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE int enigma_scramble(const Enigma* enigma, int c) {
+    for (int i = 0; i < enigma->rotor_count; i++) {
+        c = enigma_rotor_pass_forward(enigma->rotors[i], enigma_ring_offset(enigma, i), c);
+    }
+
+    c = enigma->reflector->indices[c];
+
+    for (int i = enigma->rotor_count - 1; i >= 0; i--) {
+        c = enigma_rotor_pass_reverse(enigma->rotors[i], enigma_ring_offset(enigma, i), c);
+    }
+    return c;
+}
+
+/**
+ * @brief Get the scrambler cache state index for the current rotor positions.
+ *
+ * @param enigma Pointer to the Enigma machine structure.
+ * @return The ring offsets read as a base-26 number, rotor 0 being the least significant digit.
+ */
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE size_t enigma_scrambler_state(const Enigma* enigma) {
+    size_t state = 0;
+    for (int i = enigma->rotor_count - 1; i >= 0; i--) {
+        state = state * ENIGMA_ALPHA_SIZE + enigma_ring_offset(enigma, i);
+    }
+    return state;
+}
+
 /**
  * @brief Substitute characters based on the plugboard configuration.
  *
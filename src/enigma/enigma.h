@@ -8,9 +8,13 @@
 #ifndef ENIGMA_ENIGMA_H
 #define ENIGMA_ENIGMA_H
 
+#include "executor.h"
 #include "reflector.h"
 #include "rotor.h"
 
+#include <stddef.h>
+#include <stdint.h>
+
 #ifndef ENIGMA_VERSION
 /**
  * @brief libenigma version string
@@ -18,6 +22,14 @@
 #define ENIGMA_VERSION "unknown"
 #endif
 
+#ifndef ENIGMA_PARALLEL_MIN_CHUNK
+/**
+ * @brief Minimum number of characters given to each worker by enigma_encode_string_parallel()
+ * and enigma_encode_string_executor().
+ */
+#define ENIGMA_PARALLEL_MIN_CHUNK 16384
+#endif
+
 /**
  * @struct Enigma
  * @brief Represents the state and configuration of an Enigma machine.
@@ -30,33 +42,115 @@
  * pair indicates two letters that are swapped during encoding.
  *
  * Example plugboard configuration: "ABCD" means A<->B and C<->D are swapped.
+ *
+ * Each rotor also has a ring setting (Ringstellung), which turns its wiring against its
+ * alphabet ring: the wiring is offset by the rotor position minus the ring setting, while the
+ * notches stay on the ring, so turnovers still happen at the same positions. Only the rings of
+ * rotors 0 and 1 change when other rotors step; the ring of any other rotor can be folded into
+ * its position by subtracting it from both.
+ *
+ * The same settings are also kept as a permutation table, `plugboard_offsets`, which is what
+ * encoding reads. Entry `i` holds the distance from letter `i` to the letter it is swapped
+ * with, so a zeroed table is the empty plugboard. Both fields are filled by
+ * enigma_set_plugboard(), which should be used instead of writing to `plugboard` directly.
  */
 typedef struct {
     const EnigmaRotor*     rotors[4]; //!< Array of pointers to rotor configurations.
     int                    rotor_indices[4]; //!< Array of current rotor indices.
+    int                    ring_settings[4]; //!< Ring setting of each rotor (0 for 'A').
     int                    rotor_flag; //!< Flag indicating rotor behavior.
     int                    rotor_count; //!< Number of rotors in use.
     const EnigmaReflector* reflector; //!< Pointer to reflector configuration.
     char                   plugboard[27]; //!< String representing plugboard settings.
+    int8_t                 plugboard_offsets[26]; //!< Plugboard permutation as letter offsets.
 } Enigma;
 
+/**
+ * @struct EnigmaScrambler
+ * @brief Precomputed scrambler permutations for a fixed rotor order and reflector.
+ *
+ * The scrambler (rotors and reflector, without the plugboard) has a single 26-letter
+ * permutation for each combination of rotor positions. This structure holds all of them
+ * (26^3 for three rotors, 26^4 for four) so that encoding a character under a known rotor
+ * state is a single table lookup instead of a walk through every rotor and back.
+ *
+ * The permutation for a state is stored at `permutations[state * ENIGMA_ALPHA_SIZE]`, where
+ * `state` is the ring offsets (rotor index minus ring setting, modulo 26) read as a base-26
+ * number with rotor 0 as the least significant digit. The permutations do not depend on the
+ * ring settings, so one scrambler serves every ring setting of its rotors and reflector.
+ */
+typedef struct {
+    const EnigmaRotor*     rotors[4]; //!< Rotors the permutations were built for.
+    int                    rotor_count; //!< Number of rotors in use.
+    const EnigmaReflector* reflector; //!< Reflector the permutations were built for.
+    size_t                 state_count; //!< Number of rotor states (26^rotor_count).
+    uint8_t*               permutations; //!< Scrambler permutation for every rotor state.
+} EnigmaScrambler;
+
+/**
+ * @struct EnigmaKey
+ * @brief A compact, 16-byte representation of an Enigma machine configuration.
+ *
+ * A key refers to the standard rotors and reflectors by their index in `enigma_rotors` and
+ * `enigma_reflectors`, and stores the plugboard as the rank of its permutation among every
+ * possible plugboard permutation (there are 532985208200576, so any plugboard fits in 49 bits).
+ * Keys hold no pointers, so they can be copied, compared with enigma_key_compare(), and written
+ * to files or shared memory as they are.
+ *
+ * Only the ring settings of rotors 0 and 1 are stored; the rings of the other rotors are folded
+ * into their positions (see Enigma), so a key describes how the machine encodes rather than how
+ * it was set up.
+ */
+typedef struct {
+    uint64_t plugboard; //!< Rank of the plugboard permutation.
+    uint8_t  rotors[4]; //!< Rotor id in bits 0-2 and rotor position in bits 3-7 of each rotor.
+    uint8_t  reflector; //!< Reflector id.
+    uint8_t  rotor_count; //!< Number of rotors in use.
+    uint8_t  rings[2]; //!< Ring settings of rotors 0 and 1.
+} EnigmaKey;
+
 char        enigma_encode(Enigma*, int);
+int         enigma_encode_index(Enigma*, int);
+int         enigma_encode_indices(Enigma*, const uint8_t*, uint8_t*, int);
+int         enigma_encode_indices_unchecked(Enigma*, const uint8_t*, uint8_t*, int);
 int         enigma_encode_string(Enigma*, const char*, char*, int);
+int         enigma_encode_string_executor(Enigma*, const char*, char*, int, EnigmaExecutor*);
+int         enigma_encode_string_parallel(Enigma*, const char*, char*, int, int);
+int         enigma_encode_string_unchecked(Enigma*, const char*, char*, int);
+int         enigma_indices_to_text(const uint8_t*, char*, int);
 int         enigma_init_rotors(Enigma*, const EnigmaRotor*, int);
 int         enigma_init_default_config(Enigma*);
 int         enigma_init_random_config(Enigma*);
 Enigma*     enigma_new(void);
+int         enigma_seek(Enigma*, size_t);
+int         enigma_text_to_indices(const char*, uint8_t*, int);
 const char* enigma_version(void);
 
+/* --- EnigmaScrambler functions --- */
+int enigma_scrambler_init(EnigmaScrambler*, const Enigma*);
+int enigma_scrambler_free(EnigmaScrambler*);
+int enigma_scrambler_matches(const EnigmaScrambler*, const Enigma*);
+int enigma_scrambler_encode_indices(const EnigmaScrambler*, Enigma*, const uint8_t*, uint8_t*, int);
+int enigma_scrambler_encode_indices_unchecked(
+    const EnigmaScrambler*, Enigma*, const uint8_t*, uint8_t*, int);
+int enigma_scrambler_encode_string(const EnigmaScrambler*, Enigma*, const char*, char*, int);
+
+/* --- EnigmaKey functions --- */
+int enigma_key_compare(const EnigmaKey*, const EnigmaKey*);
+int enigma_key_from_enigma(EnigmaKey*, const Enigma*);
+int enigma_key_to_enigma(const EnigmaKey*, Enigma*);
+
 /* --- Enigma getters and setters --- */
 const char*            enigma_get_plugboard(const Enigma*);
 const EnigmaReflector* enigma_get_reflector(const Enigma*);
+int                    enigma_get_ring_setting(const Enigma*, int);
 const EnigmaRotor*     enigma_get_rotor(const Enigma*, int);
 int                    enigma_get_rotor_count(const Enigma*);
 int                    enigma_get_rotor_flag(const Enigma*);
 int                    enigma_get_rotor_index(const Enigma*, int);
 int                    enigma_set_plugboard(Enigma*, const char*);
 int                    enigma_set_reflector(Enigma*, int);
+int                    enigma_set_ring_setting(Enigma*, int, int);
 int                    enigma_set_rotor(Enigma*, int, int);
 int                    enigma_set_rotor_count(Enigma*, int);
 int                    enigma_set_rotor_flag(Enigma*, int);
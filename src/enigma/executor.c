@@ -0,0 +1,196 @@
+/**
+ * @file enigma/executor.c
+ *
+ * This file implements a reusable pool of worker threads.
+ *
+ * Every job posted with enigma_executor_run() is run once by each worker, which is given its
+ * index so that it can pick its share of the work and its own buffers. The calling thread is
+ * worker 0 and waits for the background workers before returning.
+ */
+#include "executor.h"
+
+#include "common.h"
+#include "io.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+ENIGMA_STATIC void* enigma_executor_worker(void*);
+ENIGMA_STATIC void  enigma_executor_stop(EnigmaExecutor*, int);
+
+/**
+ * @brief Create an executor and start its worker threads.
+ *
+ * If some threads cannot be started (e.g. on platforms without threads), the executor is created
+ * with fewer workers; see enigma_executor_get_thread_count().
+ *
+ * @param threads The number of workers, including the calling thread (at least 1).
+ * @return Pointer to the new executor, or NULL on failure.
+ */
+EMSCRIPTEN_KEEPALIVE EnigmaExecutor* enigma_executor_new(int threads) {
+    if (threads < 1) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return NULL;
+    }
+
+    EnigmaExecutor* executor = calloc(1, sizeof(EnigmaExecutor));
+    if (!executor) {
+        return NULL;
+    }
+
+    executor->threads = malloc(threads * sizeof(pthread_t));
+    executor->workers = malloc(threads * sizeof(EnigmaExecutorWorker));
+    if (!executor->threads || !executor->workers) {
+        free(executor->threads);
+        free(executor->workers);
+        free(executor);
+        return NULL;
+    }
+
+    pthread_mutex_init(&executor->mutex, NULL);
+    pthread_cond_init(&executor->job_ready, NULL);
+    pthread_cond_init(&executor->job_done, NULL);
+
+    // Worker 0 is the calling thread, so background thread i - 1 is worker i
+    executor->thread_count = 1;
+    for (int i = 1; i < threads; i++) {
+        EnigmaExecutorWorker* worker = &executor->workers[i - 1];
+        worker->executor             = executor;
+        worker->index                = i;
+        if (pthread_create(&executor->threads[i - 1], NULL, enigma_executor_worker, worker)) {
+            break;
+        }
+        executor->thread_count++;
+    }
+
+    return executor;
+}
+
+/**
+ * @brief Stop the worker threads of an executor and free it.
+ *
+ * @param executor The executor to free.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_executor_free(EnigmaExecutor* executor) {
+    if (!executor) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    enigma_executor_stop(executor, executor->thread_count - 1);
+    pthread_mutex_destroy(&executor->mutex);
+    pthread_cond_destroy(&executor->job_ready);
+    pthread_cond_destroy(&executor->job_done);
+    free(executor->threads);
+    free(executor->workers);
+    free(executor);
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Run a job on every worker of an executor and wait for it to finish.
+ *
+ * The calling thread runs the job as worker 0. Jobs posted from several threads at once are run
+ * one after the other.
+ *
+ * @param executor The executor to run the job on.
+ * @param job The job to run.
+ * @param arg The argument to pass to the job.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int
+enigma_executor_run(EnigmaExecutor* executor, EnigmaExecutorJob job, void* arg) {
+    if (!executor || !job) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    pthread_mutex_lock(&executor->mutex);
+    while (executor->job) {
+        pthread_cond_wait(&executor->job_done, &executor->mutex);
+    }
+    executor->job     = job;
+    executor->job_arg = arg;
+    executor->running = executor->thread_count - 1;
+    executor->generation++;
+    pthread_cond_broadcast(&executor->job_ready);
+    pthread_mutex_unlock(&executor->mutex);
+
+    job(arg, 0);
+
+    pthread_mutex_lock(&executor->mutex);
+    while (executor->running > 0) {
+        pthread_cond_wait(&executor->job_done, &executor->mutex);
+    }
+    executor->job = NULL;
+    // Wake up any thread waiting to post the next job
+    pthread_cond_broadcast(&executor->job_done);
+    pthread_mutex_unlock(&executor->mutex);
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Get the number of workers of an executor, including the calling thread.
+ *
+ * @param executor The executor.
+ * @return The number of workers, or ENIGMA_FAILURE if executor is NULL.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_executor_get_thread_count(const EnigmaExecutor* executor) {
+    if (!executor) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    return executor->thread_count;
+}
+
+/**
+ * @brief Main loop of a background worker thread.
+ *
+ * @param data The EnigmaExecutorWorker of the thread.
+ * @return NULL
+ */
+ENIGMA_STATIC void* enigma_executor_worker(void* data) {
+    EnigmaExecutorWorker* worker   = data;
+    EnigmaExecutor*       executor = worker->executor;
+    unsigned long         seen     = 0;
+
+    pthread_mutex_lock(&executor->mutex);
+    for (;;) {
+        while (!executor->stopping && executor->generation == seen) {
+            pthread_cond_wait(&executor->job_ready, &executor->mutex);
+        }
+        if (executor->stopping) {
+            break;
+        }
+
+        EnigmaExecutorJob job = executor->job;
+        void*             arg = executor->job_arg;
+        seen                  = executor->generation;
+        pthread_mutex_unlock(&executor->mutex);
+
+        job(arg, worker->index);
+
+        pthread_mutex_lock(&executor->mutex);
+        if (--executor->running == 0) {
+            pthread_cond_broadcast(&executor->job_done);
+        }
+    }
+    pthread_mutex_unlock(&executor->mutex);
+    return NULL;
+}
+
+/**
+ * @brief Tell the background workers of an executor to exit and wait for them.
+ *
+ * @param executor The executor to stop.
+ * @param count The number of background workers that were started.
+ */
+ENIGMA_STATIC void enigma_executor_stop(EnigmaExecutor* executor, int count) {
+    pthread_mutex_lock(&executor->mutex);
+    executor->stopping = 1;
+    pthread_cond_broadcast(&executor->job_ready);
+    pthread_mutex_unlock(&executor->mutex);
+
+    for (int i = 0; i < count; i++) {
+        pthread_join(executor->threads[i], NULL);
+    }
+}
@@ -0,0 +1,58 @@
+/**
+ * @file enigma/executor.h
+ *
+ * This file declares a reusable pool of worker threads that the crack functions can run on.
+ */
+#ifndef ENIGMA_EXECUTOR_H
+#define ENIGMA_EXECUTOR_H
+
+#include <pthread.h>
+
+/**
+ * @brief A job run by every worker of an executor.
+ *
+ * The first argument is the argument passed to enigma_executor_run(), the second is the index of
+ * the worker running the job (0 to thread_count - 1).
+ */
+typedef void (*EnigmaExecutorJob)(void*, int);
+
+struct EnigmaExecutor_s;
+
+/**
+ * @struct EnigmaExecutorWorker
+ * @brief A background worker's view of its executor.
+ */
+typedef struct {
+    struct EnigmaExecutor_s* executor; //!< The executor the worker belongs to.
+    int                      index; //!< The index of the worker.
+} EnigmaExecutorWorker;
+
+/**
+ * @struct EnigmaExecutor
+ * @brief A pool of worker threads, created once and reused for every job.
+ *
+ * Worker 0 is the thread that calls enigma_executor_run(), so an executor with one thread runs
+ * jobs without starting any threads.
+ */
+typedef struct EnigmaExecutor_s {
+    pthread_t*            threads; //!< Background worker threads (thread_count - 1 of them).
+    EnigmaExecutorWorker* workers; //!< Argument passed to each background thread.
+    int                   thread_count; //!< Number of workers, including the calling thread.
+    pthread_mutex_t       mutex; //!< Protects the job state below.
+    pthread_cond_t        job_ready; //!< Signaled when a job is posted or on shutdown.
+    pthread_cond_t        job_done; //!< Signaled when the last background worker finishes a job.
+    EnigmaExecutorJob     job; //!< The job being run, or NULL if the executor is idle.
+    void*                 job_arg; //!< Argument passed to the job.
+    unsigned long         generation; //!< Incremented per job, so each worker runs it once.
+    int                   running; //!< Number of background workers still running the job.
+    int                   stopping; //!< Set when the executor is being freed.
+} EnigmaExecutor;
+
+EnigmaExecutor* enigma_executor_new(int);
+int             enigma_executor_free(EnigmaExecutor*);
+int             enigma_executor_run(EnigmaExecutor*, EnigmaExecutorJob, void*);
+
+/* --- EnigmaExecutor getters --- */
+int enigma_executor_get_thread_count(const EnigmaExecutor*);
+
+#endif
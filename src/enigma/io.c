@@ -45,7 +45,8 @@ int enigma_error_message(const char* func, const char* format, ...) {
  * POSITIONS is a string of starting positions for each rotor,
  * REFLECTOR is the reflector name, and PLUGBOARD is a string
  * representing plugboard connections. If there is no plugboard,
- * use "None".
+ * use "None". It may be followed by "|RINGS", a string of ring
+ * settings for each rotor; otherwise every ring is set to 'A'.
  *
  * @param enigma Pointer to the Enigma machine instance.
  * @param s      String representing the Enigma configuration.
@@ -62,6 +63,7 @@ EMSCRIPTEN_KEEPALIVE int enigma_load_config(Enigma* enigma, const char* s) {
     char* positions = strtok(NULL, "|");
     char* reflector = strtok(NULL, "|");
     char* plugboard = strtok(NULL, "|");
+    char* rings     = strtok(NULL, "|");
 
     if (enigma_load_rotor_config(enigma, rotors)) {
         return ENIGMA_ERROR("Invalid rotor configuration: %s", rotors);
@@ -71,12 +73,21 @@ EMSCRIPTEN_KEEPALIVE int enigma_load_config(Enigma* enigma, const char* s) {
         return ENIGMA_ERROR("Invalid rotor positions: %s", positions);
     }
 
+    memset(enigma->ring_settings, 0, sizeof(enigma->ring_settings));
+    if (rings && enigma_load_ring_settings(enigma, rings)) {
+        return ENIGMA_ERROR("Invalid ring settings: %s", rings);
+    }
+
     if (enigma_load_reflector_config(enigma, reflector)) {
         return ENIGMA_ERROR("Invalid reflector configuration: %s", reflector);
     }
 
-    if (strcmp(enigma->plugboard, "None")) {
-        strcpy(enigma->plugboard, plugboard);
+    if (!plugboard || !strcmp(plugboard, "None")) {
+        plugboard = "";
+    }
+
+    if (enigma_set_plugboard(enigma, plugboard)) {
+        return ENIGMA_ERROR("Invalid plugboard configuration: %s", plugboard);
     }
 
     return ENIGMA_SUCCESS;
@@ -128,7 +139,7 @@ EMSCRIPTEN_KEEPALIVE int enigma_load_custom_rotor(
         rotor->rev_indices[rotor->fwd_indices[i]] = i;
     }
 
-    return ENIGMA_SUCCESS;
+    return enigma_rotor_update_turnovers(rotor);
 }
 
 EMSCRIPTEN_KEEPALIVE int enigma_load_dict_f(EnigmaCrackParams* cfg, const char* path) {
@@ -312,11 +323,9 @@ EMSCRIPTEN_KEEPALIVE int enigma_load_ngrams(EnigmaCrackParams* cfg, const char*
  * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
  */
 EMSCRIPTEN_KEEPALIVE int enigma_load_plugboard_config(Enigma* enigma, const char* s) {
-    int len = strlen(s);
-    if (len % 2 != 0 || len > ENIGMA_ALPHA_SIZE) {
+    if (enigma_set_plugboard(enigma, s)) {
         return ENIGMA_ERROR("Invalid plugboard configuration: %s", s);
     }
-    memcpy(enigma->plugboard, s, len);
     return ENIGMA_SUCCESS;
 }
 
@@ -368,6 +377,39 @@ EMSCRIPTEN_KEEPALIVE int enigma_load_rotor_config(Enigma* enigma, char* s) {
     return ENIGMA_SUCCESS;
 }
 
+/**
+ * @brief Load ring settings (Ringstellung) from a string.
+ *
+ * This function expects a string of characters representing the ring setting of each rotor,
+ * in the same order as enigma_load_rotor_positions(), e.g. "AAB". Rotors past the end of the
+ * string keep their ring setting.
+ *
+ * @param enigma Pointer to the Enigma machine instance.
+ * @param s      String representing the ring settings.
+ *
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_load_ring_settings(Enigma* enigma, const char* s) {
+    if (!enigma || !s) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+    if (enigma->rotor_count == 0) {
+        return ENIGMA_ERROR("%s", "Cannot load ring settings without rotors");
+    }
+
+    for (int i = 0; s[i]; i++) {
+        if (i >= enigma->rotor_count || !isalpha(s[i])) {
+            return ENIGMA_FAILURE;
+        }
+    }
+
+    for (int i = 0; s[i]; i++) {
+        enigma->ring_settings[i] = toupper(s[i]) - 'A';
+    }
+
+    return ENIGMA_SUCCESS;
+}
+
 /**
  * @brief Load rotor starting positions from a string.
  *
@@ -398,20 +440,31 @@ EMSCRIPTEN_KEEPALIVE int enigma_load_rotor_positions(Enigma* enigma, const char*
 /**
  * @brief Print the current Enigma machine configuration to out.
  *
+ * The configuration is printed in the format read by enigma_load_config(). The ring settings
+ * are only printed if one of them is not 'A'.
+ *
  * @param enigma Pointer to the Enigma machine instance.
  * @param out    Buffer to store the configuration string.
  */
 EMSCRIPTEN_KEEPALIVE void enigma_print_config(const Enigma* enigma, char* out) {
-    sprintf(out,
-            "%s %s %s|%c%c%c|%s|%s",
-            enigma->rotors[0]->name,
-            enigma->rotors[1]->name,
-            enigma->rotors[2]->name,
-            enigma->rotor_indices[0] + 'A',
-            enigma->rotor_indices[1] + 'A',
-            enigma->rotor_indices[2] + 'A',
-            enigma->reflector->name,
-            enigma->plugboard[0] == '\0' ? "None" : enigma->plugboard);
+    int length = sprintf(out,
+                         "%s %s %s|%c%c%c|%s|%s",
+                         enigma->rotors[0]->name,
+                         enigma->rotors[1]->name,
+                         enigma->rotors[2]->name,
+                         enigma->rotor_indices[0] + 'A',
+                         enigma->rotor_indices[1] + 'A',
+                         enigma->rotor_indices[2] + 'A',
+                         enigma->reflector->name,
+                         enigma->plugboard[0] == '\0' ? "None" : enigma->plugboard);
+
+    if (enigma->ring_settings[0] || enigma->ring_settings[1] || enigma->ring_settings[2]) {
+        sprintf(out + length,
+                "|%c%c%c",
+                enigma->ring_settings[0] + 'A',
+                enigma->ring_settings[1] + 'A',
+                enigma->ring_settings[2] + 'A');
+    }
 }
 
 /**
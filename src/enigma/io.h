@@ -28,6 +28,7 @@ int                enigma_load_dict_s(EnigmaCrackParams*, const char*, size_t);
 int                enigma_load_ngrams(EnigmaCrackParams*, const char*);
 int                enigma_load_plugboard_config(Enigma*, const char*);
 int                enigma_load_reflector_config(Enigma*, const char*);
+int                enigma_load_ring_settings(Enigma*, const char*);
 int                enigma_load_rotor_config(Enigma*, char*);
 int                enigma_load_rotor_positions(Enigma*, const char*);
 void               enigma_print_config(const Enigma*, char*);
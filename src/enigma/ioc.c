@@ -34,3 +34,69 @@ EMSCRIPTEN_KEEPALIVE float enigma_ioc_score(const EnigmaCrackParams* cfg, const
     float score = total / (float) (len * (len - 1));
     return score;
 }
+
+/**
+ * @brief Score letter indices using Index of Coincidence.
+ *
+ * This is the index-domain counterpart of enigma_ioc_score(). Every entry of `text` must be a
+ * letter index (0-25).
+ *
+ * @param cfg Pointer to the cracking configuration structure.
+ * @param text The letter indices to score.
+ */
+EMSCRIPTEN_KEEPALIVE float enigma_ioc_score_indices(const EnigmaCrackParams* cfg,
+                                                    const uint8_t*           text) {
+    int   freq[26] = { 0 };
+    float total    = 0.0f;
+    int   len      = cfg->ciphertext_length;
+
+    for (int i = 0; i < len; i++) {
+        freq[text[i]]++;
+    }
+
+    for (int i = 0; i < 26; i++) {
+        total += (float) freq[i] * (freq[i] - 1);
+    }
+
+    return total / (float) (len * (len - 1));
+}
+
+/**
+ * @brief Score the letter indices of several candidates using Index of Coincidence.
+ *
+ * This is the batch counterpart of enigma_ioc_score_indices(). Up to
+ * ENIGMA_SCORE_BATCH_LANES candidates are counted together, so the histogram updates of
+ * different candidates are independent and can overlap.
+ *
+ * @param cfg Pointer to the cracking configuration structure.
+ * @param texts The letter indices of each candidate, `ciphertext_length` apart.
+ * @param count The number of candidates.
+ * @param scores Set to the score of each candidate.
+ */
+EMSCRIPTEN_KEEPALIVE void enigma_ioc_score_batch(const EnigmaCrackParams* cfg,
+                                                 const uint8_t*           texts,
+                                                 int                      count,
+                                                 float*                   scores) {
+    size_t len = cfg->ciphertext_length;
+
+    for (int first = 0; first < count; first += ENIGMA_SCORE_BATCH_LANES) {
+        int lanes = count - first < ENIGMA_SCORE_BATCH_LANES ? count - first
+                                                             : ENIGMA_SCORE_BATCH_LANES;
+        int freq[ENIGMA_SCORE_BATCH_LANES][26] = { { 0 } };
+        const uint8_t* text = texts + first * len;
+
+        for (size_t i = 0; i < len; i++) {
+            for (int j = 0; j < lanes; j++) {
+                freq[j][text[j * len + i]]++;
+            }
+        }
+
+        for (int j = 0; j < lanes; j++) {
+            float total = 0.0f;
+            for (int i = 0; i < 26; i++) {
+                total += (float) freq[j][i] * (freq[j][i] - 1);
+            }
+            scores[first + j] = total / (float) ((int) len * ((int) len - 1));
+        }
+    }
+}
@@ -40,5 +40,7 @@
 #define ENIGMA_IOC_GERMAN_MAX (ENIGMA_IOC_GERMAN + 0.25)
 
 float enigma_ioc_score(const EnigmaCrackParams*, const char*);
+float enigma_ioc_score_indices(const EnigmaCrackParams*, const uint8_t*);
+void  enigma_ioc_score_batch(const EnigmaCrackParams*, const uint8_t*, int, float*);
 
 #endif
@@ -0,0 +1,253 @@
+/**
+ * @file enigma/kernel.c
+ *
+ * This file implements encode kernels specialized per rotor order.
+ *
+ * The rotor tables used here are generated at build time by tools/kernelgen from rotor.h
+ * (see kernel_tables.h in the build directory), with each rotor's wiring expanded for every
+ * rotor position. Every kernel is instantiated for one order of the three stepping rotors, so
+ * the compiler sees constant tables and a fixed number of rotor passes. Kernels track ring
+ * offsets (position minus ring setting) rather than positions, testing the turnover masks
+ * turned by the ring settings once per call, so ring settings cost nothing per character.
+ * The fourth rotor never steps, so it is folded into the reflector once per call.
+ *
+ * Kernels are only built when ENIGMA_KERNELS is defined; otherwise enigma_kernel_encode_indices()
+ * always falls back to the generic encoder.
+ */
+#include "kernel.h"
+
+#include "common.h"
+#include "rotor.h"
+
+#include <stddef.h>
+
+#ifdef ENIGMA_KERNELS
+#include "kernel_tables.h"
+
+/**
+ * @brief An encode kernel for one rotor order.
+ *
+ * The last argument is the reflector, with the fourth rotor folded in.
+ */
+typedef void (*EnigmaKernel)(Enigma*, const uint8_t*, uint8_t*, int, const uint8_t*);
+
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE void
+enigma_kernel_run(Enigma*, const uint8_t*, uint8_t*, int, const uint8_t*, int, int, int);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE int      enigma_kernel_offset(int, int);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE uint32_t enigma_kernel_ring_turnovers(uint32_t, int);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE int      enigma_kernel_step(int);
+ENIGMA_STATIC void                          enigma_kernel_reflector(const Enigma*, uint8_t*);
+
+#define ENIGMA_KERNEL_ORDER(a, b, c)                                                             \
+    static void enigma_kernel_##a##_##b##_##c(Enigma*        enigma,                             \
+                                              const uint8_t* input,                              \
+                                              uint8_t*       output,                             \
+                                              int            length,                             \
+                                              const uint8_t* reflector) {                        \
+        enigma_kernel_run(enigma, input, output, length, reflector, a, b, c);                    \
+    }
+ENIGMA_KERNEL_ORDERS
+#undef ENIGMA_KERNEL_ORDER
+
+/**
+ * @brief Kernels indexed by the ids of the first three rotors, NULL for repeated rotors.
+ */
+#define ENIGMA_KERNEL_ORDER(a, b, c) [a][b][c] = enigma_kernel_##a##_##b##_##c,
+static const EnigmaKernel enigma_kernels[ENIGMA_ROTOR_COUNT][ENIGMA_ROTOR_COUNT]
+                                        [ENIGMA_ROTOR_COUNT]
+    = { ENIGMA_KERNEL_ORDERS };
+#undef ENIGMA_KERNEL_ORDER
+#endif
+
+/**
+ * @brief Encode a buffer of letter indices with the kernel for the machine's rotor order.
+ *
+ * This behaves like enigma_encode_indices_unchecked(), which calls it first. The arguments are
+ * not checked. The machine must have three or four rotors, the first three of them standard
+ * rotors (see enigma_rotor_id()); the fourth rotor and the reflector may be custom.
+ *
+ * @param enigma Pointer to the Enigma machine structure.
+ * @param input The letter indices to encode.
+ * @param output The buffer to store the encoded indices (at least `length` entries).
+ * @param length The number of indices to encode.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE without encoding anything if there is no
+ * kernel for the rotor count or order or libenigma was built without kernels.
+ */
+EMSCRIPTEN_KEEPALIVE int
+enigma_kernel_encode_indices(Enigma* enigma, const uint8_t* input, uint8_t* output, int length) {
+#ifdef ENIGMA_KERNELS
+    int ids[3];
+
+    // Kernels always pass through three rotors, so other rotor counts use the generic path
+    if (enigma->rotor_count < 3 || enigma->rotor_count > ENIGMA_MAX_ROTOR_COUNT) {
+        return ENIGMA_FAILURE;
+    }
+
+    for (int i = 0; i < 3; i++) {
+        if (!enigma->rotors[i] || (ids[i] = enigma_rotor_id(enigma->rotors[i])) < 0) {
+            return ENIGMA_FAILURE;
+        }
+    }
+
+    EnigmaKernel kernel = enigma_kernels[ids[0]][ids[1]][ids[2]];
+    if (!kernel) {
+        return ENIGMA_FAILURE;
+    }
+
+    uint8_t reflector[ENIGMA_ALPHA_SIZE];
+    enigma_kernel_reflector(enigma, reflector);
+    kernel(enigma, input, output, length, reflector);
+    return ENIGMA_SUCCESS;
+#else
+    return ENIGMA_FAILURE;
+#endif
+}
+
+/**
+ * @brief Get the number of specialized kernels in this build.
+ *
+ * @return The number of rotor orders with a kernel, or 0 if libenigma was built without kernels.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_kernel_count(void) {
+#ifdef ENIGMA_KERNELS
+#define ENIGMA_KERNEL_ORDER(a, b, c) +1
+    return 0 ENIGMA_KERNEL_ORDERS;
+#undef ENIGMA_KERNEL_ORDER
+#else
+    return 0;
+#endif
+}
+
+#ifdef ENIGMA_KERNELS
+/**
+ * @brief Encode a buffer of letter indices with rotors `a`, `b`, and `c` in the first slots.
+ *
+ * This is the body of every kernel; it is inlined with constant rotor ids, so the table lookups
+ * below use constant addresses.
+ *
+ * @param enigma Pointer to the Enigma machine structure.
+ * @param input The letter indices to encode.
+ * @param output The buffer to store the encoded indices.
+ * @param length The number of indices to encode.
+ * @param reflector The reflector, with the fourth rotor folded in.
+ * @param a The id of the rotor in the first slot.
+ * @param b The id of the rotor in the second slot.
+ * @param c The id of the rotor in the third slot.
+ */
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE void enigma_kernel_run(Enigma*        enigma,
+                                                          const uint8_t* input,
+                                                          uint8_t*       output,
+                                                          int            length,
+                                                          const uint8_t* reflector,
+                                                          int            a,
+                                                          int            b,
+                                                          int            c) {
+    const int8_t* plugboard = enigma->plugboard_offsets;
+    const int*    rings     = enigma->ring_settings;
+    uint32_t      t0        = enigma_kernel_ring_turnovers(enigma_kernel_turnovers[a], rings[0]);
+    uint32_t      t1        = enigma_kernel_ring_turnovers(enigma_kernel_turnovers[b], rings[1]);
+    int           p0        = enigma_kernel_offset(enigma->rotor_indices[0], -rings[0]);
+    int           p1        = enigma_kernel_offset(enigma->rotor_indices[1], -rings[1]);
+    int           p2        = enigma_kernel_offset(enigma->rotor_indices[2], -rings[2]);
+
+    for (int i = 0; i < length; i++) {
+        if ((t1 >> p1) & 1) {
+            // Double step
+            p1 = enigma_kernel_step(p1);
+            p2 = enigma_kernel_step(p2);
+        } else if ((t0 >> p0) & 1) {
+            p1 = enigma_kernel_step(p1);
+        }
+        p0 = enigma_kernel_step(p0);
+
+        int x = input[i];
+        x += plugboard[x];
+        x = enigma_kernel_fwd[a][p0][x];
+        x = enigma_kernel_fwd[b][p1][x];
+        x = enigma_kernel_fwd[c][p2][x];
+        x = reflector[x];
+        x = enigma_kernel_rev[c][p2][x];
+        x = enigma_kernel_rev[b][p1][x];
+        x = enigma_kernel_rev[a][p0][x];
+        output[i] = x + plugboard[x];
+    }
+
+    enigma->rotor_indices[0] = enigma_kernel_offset(p0, rings[0]);
+    enigma->rotor_indices[1] = enigma_kernel_offset(p1, rings[1]);
+    enigma->rotor_indices[2] = enigma_kernel_offset(p2, rings[2]);
+}
+
+/**
+ * @brief Add a signed amount to a rotor position or ring offset, wrapping around the alphabet.
+ *
+ * @param position The rotor position or ring offset (0-25).
+ * @param amount The amount to add (-25 to 25).
+ * @return The wrapped sum (0-25).
+ */
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE int enigma_kernel_offset(int position, int amount) {
+    position += amount;
+    if (position < 0) {
+        position += ENIGMA_ALPHA_SIZE;
+    } else if (position >= ENIGMA_ALPHA_SIZE) {
+        position -= ENIGMA_ALPHA_SIZE;
+    }
+    return position;
+}
+
+/**
+ * @brief Turn a turnover mask by a ring setting, as enigma_rotor_get_ring_turnovers() does.
+ *
+ * @param turnovers The turnover mask over positions.
+ * @param ring The ring setting (0-25).
+ * @return The turnover mask over ring offsets.
+ */
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE uint32_t enigma_kernel_ring_turnovers(uint32_t turnovers,
+                                                                          int      ring) {
+    uint32_t rotated = (turnovers >> ring) | (turnovers << (ENIGMA_ALPHA_SIZE - ring));
+    return rotated & ((UINT32_C(1) << ENIGMA_ALPHA_SIZE) - 1);
+}
+
+/**
+ * @brief Advance a rotor position by one.
+ *
+ * @param position The rotor position.
+ * @return The next rotor position.
+ */
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE int enigma_kernel_step(int position) {
+    return position == ENIGMA_ALPHA_SIZE - 1 ? 0 : position + 1;
+}
+
+/**
+ * @brief Fold the fourth rotor, if any, into the reflector.
+ *
+ * The fourth rotor never steps, so passing through it, the reflector, and back through it is a
+ * fixed substitution for the whole call.
+ *
+ * @param enigma Pointer to the Enigma machine structure.
+ * @param reflector The buffer to store the substitution in (26 entries).
+ */
+ENIGMA_STATIC void enigma_kernel_reflector(const Enigma* enigma, uint8_t* reflector) {
+    const EnigmaRotor* rotor    = enigma->rotor_count == 4 ? enigma->rotors[3] : NULL;
+    int                position = 0;
+
+    if (rotor) {
+        position = enigma_kernel_offset(enigma->rotor_indices[3], -enigma->ring_settings[3]);
+    }
+
+    for (int i = 0; i < ENIGMA_ALPHA_SIZE; i++) {
+        int x = i;
+        if (rotor) {
+            x = (rotor->fwd_indices[(x + position) % ENIGMA_ALPHA_SIZE] - position
+                 + ENIGMA_ALPHA_SIZE)
+              % ENIGMA_ALPHA_SIZE;
+        }
+        x = enigma->reflector->indices[x];
+        if (rotor) {
+            x = (rotor->rev_indices[(x + position) % ENIGMA_ALPHA_SIZE] - position
+                 + ENIGMA_ALPHA_SIZE)
+              % ENIGMA_ALPHA_SIZE;
+        }
+        reflector[i] = x;
+    }
+}
+#endif
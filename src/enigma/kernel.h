@@ -0,0 +1,16 @@
+/**
+ * @file enigma/kernel.h
+ *
+ * This file declares the encode kernels specialized per rotor order.
+ */
+#ifndef ENIGMA_KERNEL_H
+#define ENIGMA_KERNEL_H
+
+#include "enigma.h"
+
+#include <stdint.h>
+
+int enigma_kernel_encode_indices(Enigma*, const uint8_t*, uint8_t*, int);
+int enigma_kernel_count(void);
+
+#endif
@@ -0,0 +1,254 @@
+/**
+ * @file enigma/keyspace.c
+ *
+ * This file implements a keyspace split into ranges of candidates and a work-stealing
+ * scheduler for the ranges.
+ *
+ * Queues are only locked one at a time: a thief locks the victim's queue to take ranges from
+ * its back, then its own queue to store them, so the owner and thieves never wait on each
+ * other for more than a few instructions.
+ */
+#include "keyspace.h"
+
+#include "common.h"
+#include "io.h"
+
+#include <stdlib.h>
+
+ENIGMA_STATIC void enigma_keyspace_share(EnigmaKeyspace*, size_t, size_t);
+ENIGMA_STATIC int  enigma_keyspace_steal(EnigmaKeyspace*, int);
+
+/**
+ * @brief Split a keyspace into ranges and share them between workers.
+ *
+ * @param keyspace The keyspace to initialize.
+ * @param size The number of candidates.
+ * @param rangeSize The number of candidates per range (at least 1).
+ * @param workers The number of workers that will take ranges (at least 1).
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int
+enigma_keyspace_init(EnigmaKeyspace* keyspace, size_t size, size_t rangeSize, int workers) {
+    if (!keyspace || rangeSize < 1 || workers < 1) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    keyspace->size        = size;
+    keyspace->range_size  = rangeSize;
+    keyspace->range_count = (size + rangeSize - 1) / rangeSize;
+    keyspace->queue_count = workers;
+    keyspace->queues      = malloc(workers * sizeof(EnigmaKeyspaceQueue));
+    if (!keyspace->queues) {
+        return ENIGMA_ERROR("%s", "Failed to allocate keyspace queues");
+    }
+
+    for (int i = 0; i < workers; i++) {
+        pthread_mutex_init(&keyspace->queues[i].mutex, NULL);
+    }
+    enigma_keyspace_share(keyspace, 0, keyspace->range_count);
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Restrict a keyspace to one shard of its ranges.
+ *
+ * The ranges are split into `shardCount` contiguous shards of about the same total work, so
+ * that independent processes can each run one shard without coordinating. The split only
+ * depends on the arguments, so every process computes the same shards. The queues are shared
+ * out again over the ranges of the shard, so this must be called before any range is taken.
+ *
+ * @param keyspace The keyspace.
+ * @param work The work of each range, e.g. its number of candidates to run, or NULL if every
+ * range is the same work.
+ * @param shard The index of the shard to keep (0 to `shardCount - 1`).
+ * @param shardCount The number of shards (at least 1).
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int
+enigma_keyspace_shard(EnigmaKeyspace* keyspace, const size_t* work, int shard, int shardCount) {
+    if (!keyspace || shardCount < 1 || shard < 0 || shard >= shardCount) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    size_t total = keyspace->range_count;
+    if (work) {
+        total = 0;
+        for (size_t i = 0; i < keyspace->range_count; i++) {
+            total += work[i];
+        }
+    }
+
+    // A shard starts at the first range whose preceding work reaches its share of the total
+    size_t first = shard == 0 ? 0 : keyspace->range_count;
+    size_t last  = keyspace->range_count;
+    size_t done  = 0;
+    for (size_t i = 0; i < keyspace->range_count; i++) {
+        if (first == keyspace->range_count && done * shardCount >= total * shard) {
+            first = i;
+        }
+        if (shard + 1 < shardCount && done * shardCount >= total * (shard + 1)) {
+            last = i;
+            break;
+        }
+        done += work ? work[i] : 1;
+    }
+
+    enigma_keyspace_share(keyspace, first, last);
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Free the queues of a keyspace.
+ *
+ * @param keyspace The keyspace to free.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_keyspace_free(EnigmaKeyspace* keyspace) {
+    if (!keyspace) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    for (int i = 0; i < keyspace->queue_count; i++) {
+        pthread_mutex_destroy(&keyspace->queues[i].mutex);
+    }
+    free(keyspace->queues);
+    keyspace->queues      = NULL;
+    keyspace->queue_count = 0;
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Take the next range for a worker.
+ *
+ * The range comes from the worker's own queue, or is stolen from another worker's queue once
+ * its own is empty. Every range is taken exactly once.
+ *
+ * @param keyspace The keyspace.
+ * @param worker The index of the worker.
+ * @param range Set to the index of the range taken (see enigma_keyspace_get_range()).
+ * @return 1 if a range was taken, 0 if every range has been taken, or ENIGMA_FAILURE on
+ * failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_keyspace_next(EnigmaKeyspace* keyspace, int worker, size_t* range) {
+    if (!keyspace || !range || worker < 0 || worker >= keyspace->queue_count) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    EnigmaKeyspaceQueue* queue = &keyspace->queues[worker];
+    for (;;) {
+        pthread_mutex_lock(&queue->mutex);
+        if (queue->first < queue->last) {
+            *range = queue->first++;
+            pthread_mutex_unlock(&queue->mutex);
+            return 1;
+        }
+        pthread_mutex_unlock(&queue->mutex);
+
+        if (!enigma_keyspace_steal(keyspace, worker)) {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief Get the candidates of a range.
+ *
+ * @param keyspace The keyspace.
+ * @param range The index of the range.
+ * @param first Set to the index of the first candidate of the range.
+ * @param last Set to the index past the last candidate of the range.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_keyspace_get_range(const EnigmaKeyspace* keyspace,
+                                                   size_t                range,
+                                                   size_t*               first,
+                                                   size_t*               last) {
+    if (!keyspace || !first || !last || range >= keyspace->range_count) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    *first = range * keyspace->range_size;
+    *last  = *first + keyspace->range_size;
+    if (*last > keyspace->size) {
+        *last = keyspace->size;
+    }
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Get the number of ranges of a keyspace.
+ *
+ * @param keyspace The keyspace.
+ * @return The number of ranges, or ENIGMA_FAILURE if keyspace is NULL.
+ */
+EMSCRIPTEN_KEEPALIVE size_t enigma_keyspace_get_range_count(const EnigmaKeyspace* keyspace) {
+    if (!keyspace) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    return keyspace->range_count;
+}
+
+/**
+ * @brief Share a span of ranges between the queues of a keyspace.
+ *
+ * @param keyspace The keyspace.
+ * @param first The index of the first range.
+ * @param last The index past the last range.
+ */
+ENIGMA_STATIC void enigma_keyspace_share(EnigmaKeyspace* keyspace, size_t first, size_t last) {
+    int workers = keyspace->queue_count;
+
+    for (int i = 0; i < workers; i++) {
+        EnigmaKeyspaceQueue* queue = &keyspace->queues[i];
+        queue->first               = first + (last - first) * i / workers;
+        queue->last                = first + (last - first) * (i + 1) / workers;
+    }
+}
+
+/**
+ * @brief Move the back half of the fullest queue to a worker's queue.
+ *
+ * @param keyspace The keyspace.
+ * @param worker The index of the idle worker.
+ * @return 1 if ranges were stolen, 0 if every queue is empty.
+ */
+ENIGMA_STATIC int enigma_keyspace_steal(EnigmaKeyspace* keyspace, int worker) {
+    for (;;) {
+        int    victim = -1;
+        size_t most   = 0;
+
+        for (int i = 0; i < keyspace->queue_count; i++) {
+            EnigmaKeyspaceQueue* queue = &keyspace->queues[i];
+            pthread_mutex_lock(&queue->mutex);
+            size_t remaining = queue->last - queue->first;
+            pthread_mutex_unlock(&queue->mutex);
+            if (i != worker && remaining > most) {
+                victim = i;
+                most   = remaining;
+            }
+        }
+        if (victim < 0) {
+            return 0;
+        }
+
+        // The victim may have run some of its ranges since it was picked
+        EnigmaKeyspaceQueue* queue = &keyspace->queues[victim];
+        pthread_mutex_lock(&queue->mutex);
+        size_t remaining = queue->last - queue->first;
+        size_t last      = queue->last;
+        size_t first     = last - (remaining + 1) / 2;
+        queue->last      = first;
+        pthread_mutex_unlock(&queue->mutex);
+        if (remaining == 0) {
+            continue;
+        }
+
+        queue = &keyspace->queues[worker];
+        pthread_mutex_lock(&queue->mutex);
+        queue->first = first;
+        queue->last  = last;
+        pthread_mutex_unlock(&queue->mutex);
+        return 1;
+    }
+}
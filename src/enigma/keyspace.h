@@ -0,0 +1,50 @@
+/**
+ * @file enigma/keyspace.h
+ *
+ * This file declares a keyspace split into ranges of candidates, and a work-stealing scheduler
+ * that hands the ranges to the workers of an executor.
+ */
+#ifndef ENIGMA_KEYSPACE_H
+#define ENIGMA_KEYSPACE_H
+
+#include <pthread.h>
+#include <stddef.h>
+
+/**
+ * @struct EnigmaKeyspaceQueue
+ * @brief The ranges waiting to be run by one worker.
+ *
+ * The owner takes ranges from the front; idle workers steal from the back.
+ */
+typedef struct {
+    pthread_mutex_t mutex; //!< Protects `first` and `last`.
+    size_t          first; //!< Index of the next range to run.
+    size_t          last; //!< Index past the last range to run.
+} EnigmaKeyspaceQueue;
+
+/**
+ * @struct EnigmaKeyspace
+ * @brief Candidates numbered from 0 to `size - 1`, split into ranges of `range_size`.
+ *
+ * Each worker starts with a contiguous share of the ranges. Once its own queue is empty, a
+ * worker steals the back half of the fullest queue, so no worker sits idle while ranges are
+ * left, even when some ranges take much longer than others.
+ */
+typedef struct {
+    size_t               size; //!< Number of candidates.
+    size_t               range_size; //!< Number of candidates per range (the last may be shorter).
+    size_t               range_count; //!< Number of ranges.
+    EnigmaKeyspaceQueue* queues; //!< Queue of each worker.
+    int                  queue_count; //!< Number of workers.
+} EnigmaKeyspace;
+
+int enigma_keyspace_init(EnigmaKeyspace*, size_t, size_t, int);
+int enigma_keyspace_free(EnigmaKeyspace*);
+int enigma_keyspace_next(EnigmaKeyspace*, int, size_t*);
+int enigma_keyspace_shard(EnigmaKeyspace*, const size_t*, int, int);
+int enigma_keyspace_get_range(const EnigmaKeyspace*, size_t, size_t*, size_t*);
+
+/* --- EnigmaKeyspace getters --- */
+size_t enigma_keyspace_get_range_count(const EnigmaKeyspace*);
+
+#endif
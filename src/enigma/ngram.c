@@ -86,3 +86,179 @@ EMSCRIPTEN_KEEPALIVE float enigma_quadgram_score(const EnigmaCrackParams* cfg, c
 
     return total / cfg->ciphertext_length;
 }
+
+/**
+ * @brief Score letter indices using bigram frequencies.
+ *
+ * This is the index-domain counterpart of enigma_bigram_score(). Every entry of `text` must
+ * be a letter index (0-25).
+ *
+ * @param cfg Pointer to the cracking configuration structure.
+ * @param text The letter indices to score.
+ *
+ * @return The total bigram score.
+ */
+EMSCRIPTEN_KEEPALIVE float enigma_bigram_score_indices(const EnigmaCrackParams* cfg,
+                                                       const uint8_t*           text) {
+    float total = 0.0f;
+
+    for (size_t i = 1; i < cfg->ciphertext_length; i++) {
+        total += cfg->ngrams[ENIGMA_BIIDX(text[i - 1], text[i])];
+    }
+
+    return total / cfg->ciphertext_length;
+}
+
+/**
+ * @brief Score letter indices using trigram frequencies.
+ *
+ * This is the index-domain counterpart of enigma_trigram_score(). Every entry of `text` must
+ * be a letter index (0-25).
+ *
+ * @param cfg Pointer to the cracking configuration structure.
+ * @param text The letter indices to score.
+ *
+ * @return The total trigram score.
+ */
+EMSCRIPTEN_KEEPALIVE float enigma_trigram_score_indices(const EnigmaCrackParams* cfg,
+                                                        const uint8_t*           text) {
+    float total = 0.0f;
+
+    for (size_t i = 2; i < cfg->ciphertext_length; i++) {
+        total += cfg->ngrams[ENIGMA_TRIIDX(text[i - 2], text[i - 1], text[i])];
+    }
+
+    return total / cfg->ciphertext_length;
+}
+
+/**
+ * @brief Score letter indices using quadgram frequencies.
+ *
+ * This is the index-domain counterpart of enigma_quadgram_score(). Every entry of `text` must
+ * be a letter index (0-25).
+ *
+ * @param cfg Pointer to the cracking configuration structure.
+ * @param text The letter indices to score.
+ *
+ * @return The total quadgram score.
+ */
+EMSCRIPTEN_KEEPALIVE float enigma_quadgram_score_indices(const EnigmaCrackParams* cfg,
+                                                         const uint8_t*           text) {
+    float total = 0.0f;
+
+    for (size_t i = 3; i < cfg->ciphertext_length; i++) {
+        total += cfg->ngrams[ENIGMA_QUADIDX(text[i - 3], text[i - 2], text[i - 1], text[i])];
+    }
+
+    return total / cfg->ciphertext_length;
+}
+
+/**
+ * @brief Score the letter indices of several candidates using bigram frequencies.
+ *
+ * This is the batch counterpart of enigma_bigram_score_indices(). Up to
+ * ENIGMA_SCORE_BATCH_LANES candidates are scored together, so the table lookups of different
+ * candidates are independent and can overlap. Each candidate's terms are summed in the same
+ * order as enigma_bigram_score_indices(), so the scores are identical.
+ *
+ * @param cfg Pointer to the cracking configuration structure.
+ * @param texts The letter indices of each candidate, `ciphertext_length` apart.
+ * @param count The number of candidates.
+ * @param scores Set to the total bigram score of each candidate.
+ */
+EMSCRIPTEN_KEEPALIVE void enigma_bigram_score_batch(const EnigmaCrackParams* cfg,
+                                                    const uint8_t*           texts,
+                                                    int                      count,
+                                                    float*                   scores) {
+    size_t len = cfg->ciphertext_length;
+
+    for (int first = 0; first < count; first += ENIGMA_SCORE_BATCH_LANES) {
+        int lanes = count - first < ENIGMA_SCORE_BATCH_LANES ? count - first
+                                                             : ENIGMA_SCORE_BATCH_LANES;
+        float          total[ENIGMA_SCORE_BATCH_LANES] = { 0.0f };
+        const uint8_t* text                            = texts + first * len;
+
+        for (size_t i = 1; i < len; i++) {
+            for (int j = 0; j < lanes; j++) {
+                const uint8_t* t  = text + j * len + i;
+                total[j]         += cfg->ngrams[ENIGMA_BIIDX(t[-1], t[0])];
+            }
+        }
+
+        for (int j = 0; j < lanes; j++) {
+            scores[first + j] = total[j] / len;
+        }
+    }
+}
+
+/**
+ * @brief Score the letter indices of several candidates using trigram frequencies.
+ *
+ * This is the batch counterpart of enigma_trigram_score_indices(), and gives identical scores
+ * (see enigma_bigram_score_batch()).
+ *
+ * @param cfg Pointer to the cracking configuration structure.
+ * @param texts The letter indices of each candidate, `ciphertext_length` apart.
+ * @param count The number of candidates.
+ * @param scores Set to the total trigram score of each candidate.
+ */
+EMSCRIPTEN_KEEPALIVE void enigma_trigram_score_batch(const EnigmaCrackParams* cfg,
+                                                     const uint8_t*           texts,
+                                                     int                      count,
+                                                     float*                   scores) {
+    size_t len = cfg->ciphertext_length;
+
+    for (int first = 0; first < count; first += ENIGMA_SCORE_BATCH_LANES) {
+        int lanes = count - first < ENIGMA_SCORE_BATCH_LANES ? count - first
+                                                             : ENIGMA_SCORE_BATCH_LANES;
+        float          total[ENIGMA_SCORE_BATCH_LANES] = { 0.0f };
+        const uint8_t* text                            = texts + first * len;
+
+        for (size_t i = 2; i < len; i++) {
+            for (int j = 0; j < lanes; j++) {
+                const uint8_t* t  = text + j * len + i;
+                total[j]         += cfg->ngrams[ENIGMA_TRIIDX(t[-2], t[-1], t[0])];
+            }
+        }
+
+        for (int j = 0; j < lanes; j++) {
+            scores[first + j] = total[j] / len;
+        }
+    }
+}
+
+/**
+ * @brief Score the letter indices of several candidates using quadgram frequencies.
+ *
+ * This is the batch counterpart of enigma_quadgram_score_indices(), and gives identical scores
+ * (see enigma_bigram_score_batch()).
+ *
+ * @param cfg Pointer to the cracking configuration structure.
+ * @param texts The letter indices of each candidate, `ciphertext_length` apart.
+ * @param count The number of candidates.
+ * @param scores Set to the total quadgram score of each candidate.
+ */
+EMSCRIPTEN_KEEPALIVE void enigma_quadgram_score_batch(const EnigmaCrackParams* cfg,
+                                                      const uint8_t*           texts,
+                                                      int                      count,
+                                                      float*                   scores) {
+    size_t len = cfg->ciphertext_length;
+
+    for (int first = 0; first < count; first += ENIGMA_SCORE_BATCH_LANES) {
+        int lanes = count - first < ENIGMA_SCORE_BATCH_LANES ? count - first
+                                                             : ENIGMA_SCORE_BATCH_LANES;
+        float          total[ENIGMA_SCORE_BATCH_LANES] = { 0.0f };
+        const uint8_t* text                            = texts + first * len;
+
+        for (size_t i = 3; i < len; i++) {
+            for (int j = 0; j < lanes; j++) {
+                const uint8_t* t  = text + j * len + i;
+                total[j]         += cfg->ngrams[ENIGMA_QUADIDX(t[-3], t[-2], t[-1], t[0])];
+            }
+        }
+
+        for (int j = 0; j < lanes; j++) {
+            scores[first + j] = total[j] / len;
+        }
+    }
+}
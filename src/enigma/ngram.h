@@ -25,7 +25,13 @@
 #define ENIGMA_QUADIDX(a, b, c, d) ((a << 15) | (b << 10) | (c << 5) | d)
 
 float enigma_bigram_score(const EnigmaCrackParams*, const char*);
+float enigma_bigram_score_indices(const EnigmaCrackParams*, const uint8_t*);
+void  enigma_bigram_score_batch(const EnigmaCrackParams*, const uint8_t*, int, float*);
 float enigma_trigram_score(const EnigmaCrackParams*, const char*);
+float enigma_trigram_score_indices(const EnigmaCrackParams*, const uint8_t*);
+void  enigma_trigram_score_batch(const EnigmaCrackParams*, const uint8_t*, int, float*);
 float enigma_quadgram_score(const EnigmaCrackParams*, const char*);
+float enigma_quadgram_score_indices(const EnigmaCrackParams*, const uint8_t*);
+void  enigma_quadgram_score_batch(const EnigmaCrackParams*, const uint8_t*, int, float*);
 
 #endif
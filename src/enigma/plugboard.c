@@ -0,0 +1,888 @@
+/**
+ * @file enigma/plugboard.c
+ *
+ * This file implements plugboard solvers that search whole plugboards at once for a known rotor
+ * order, rotor positions and reflector: hill climbing, and simulated annealing with independent
+ * restarts run in parallel.
+ *
+ * The plugboard is applied on both sides of the scrambler, whose permutation at each position
+ * does not depend on it, so the scrambler output of every letter at every position is computed
+ * once. A move that replugs a few letters then only changes the plaintext at the positions whose
+ * ciphertext letter or scrambler output is one of them, and for the library's IoC and n-gram
+ * scoring functions only the letter counts or n-grams of those positions are rescored.
+ */
+#include "plugboard.h"
+
+#include "common.h"
+#include "crack.h"
+#include "enigma.h"
+#include "executor.h"
+#include "io.h"
+#include "ioc.h"
+#include "ngram.h"
+#include "progress.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Smallest score improvement, in units of EnigmaPlugboardState.total, that a move must
+ * make to be taken, so that rounding never lets a move and its reverse both improve the score.
+ */
+#define ENIGMA_PLUGBOARD_EPSILON 1e-6
+
+/**
+ * @brief Number of random moves scored to calibrate the starting temperature of a run.
+ */
+#define ENIGMA_ANNEAL_CALIBRATION_MOVES 200
+
+/**
+ * @brief Number of annealing steps between two progress updates.
+ */
+#define ENIGMA_ANNEAL_PROGRESS_STEPS 1024
+
+/**
+ * @brief The plaintext of the current plugboard and what is needed to rescore a move.
+ */
+typedef struct {
+    const EnigmaCrackParams* cfg; //!< The crack parameters.
+    float (*score)(const EnigmaCrackParams*, const char*); //!< Text scoring function.
+    int      n; //!< N-gram length, 1 for IoC, or 0 to rescore the whole text with `score`.
+    size_t   length; //!< Ciphertext length.
+    uint8_t* ciphertext; //!< Ciphertext as letter indices.
+    uint8_t* scrambled; //!< Scrambler output of letter `x` at position `i` at `i * 26 + x`.
+    uint8_t* plaintext; //!< Plaintext letter indices under `plug`.
+    char*    text; //!< Plaintext under `plug`, null-terminated.
+    size_t*  changed; //!< Positions whose plaintext the move being scored changes.
+    uint8_t* letters; //!< New plaintext letters at the `changed` positions.
+    int8_t   plug[ENIGMA_ALPHA_SIZE]; //!< Letter each letter is plugged into (itself if none).
+    int      pairs; //!< Number of plugged pairs.
+    int      counts[ENIGMA_ALPHA_SIZE]; //!< Plaintext letter counts.
+    double   total; //!< Sum of the n-grams, sum of count * (count - 1), or score for n == 0.
+    double   scale; //!< What `total` is divided by to give the score.
+} EnigmaPlugboardState;
+
+/**
+ * @brief The restarts of one enigma_crack_plugboard_anneal() call, shared by its workers.
+ *
+ * Each restart writes its own entries, so the results do not depend on which worker ran it.
+ */
+typedef struct {
+    const EnigmaCrackParams* cfg; //!< The crack parameters.
+    float (*score)(const EnigmaCrackParams*, const char*); //!< Text scoring function.
+    EnigmaAnnealParams anneal; //!< The settings, with the defaults filled in.
+    EnigmaScore*       results; //!< Best configuration of each restart.
+    char*              texts; //!< Plaintext of each result, `ciphertext_length + 1` apart.
+    int*               done; //!< 1 for each restart that ran.
+    int                next; //!< Index of the next restart to run.
+    int                stop; //!< Set once a restart fails or reaches the target score.
+    int                failed; //!< Set if a restart failed.
+} EnigmaPlugboardAnnealJob;
+
+ENIGMA_STATIC void     enigma_plugboard_anneal_job(void*, int);
+ENIGMA_STATIC int      enigma_plugboard_anneal_run(EnigmaPlugboardAnnealJob*, int);
+ENIGMA_STATIC uint32_t enigma_plugboard_connect(
+    const EnigmaPlugboardState*, int, int, int8_t*, int*);
+ENIGMA_STATIC int      enigma_plugboard_move(const EnigmaPlugboardState*, int, int);
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE float enigma_plugboard_ngram(const EnigmaPlugboardState*,
+                                                                size_t);
+ENIGMA_STATIC uint64_t enigma_plugboard_random(uint64_t*);
+ENIGMA_STATIC uint32_t enigma_plugboard_random_move(
+    const EnigmaPlugboardState*, uint64_t*, int, int8_t*, int*);
+ENIGMA_STATIC void     enigma_plugboard_state_apply(
+    EnigmaPlugboardState*, const int8_t*, int, size_t, double);
+ENIGMA_STATIC double   enigma_plugboard_state_calibrate(EnigmaPlugboardState*, int, uint64_t*);
+ENIGMA_STATIC void     enigma_plugboard_state_climb(EnigmaPlugboardState*, int);
+ENIGMA_STATIC double   enigma_plugboard_state_delta(EnigmaPlugboardState*, size_t);
+ENIGMA_STATIC size_t   enigma_plugboard_state_diff(EnigmaPlugboardState*, const int8_t*, uint32_t);
+ENIGMA_STATIC void     enigma_plugboard_state_free(EnigmaPlugboardState*);
+ENIGMA_STATIC int      enigma_plugboard_state_init(EnigmaPlugboardState*,
+                                                   const EnigmaCrackParams*,
+                                                   float (*)(const EnigmaCrackParams*,
+                                                             const char*));
+ENIGMA_STATIC int      enigma_plugboard_state_result(const EnigmaPlugboardState*, Enigma*);
+ENIGMA_STATIC double   enigma_plugboard_state_total(const EnigmaPlugboardState*);
+ENIGMA_STATIC double   enigma_plugboard_state_windows(const EnigmaPlugboardState*, size_t);
+
+/**
+ * @brief Recover the plugboard by simulated annealing, from many independent restarts.
+ *
+ * Hill climbing (see enigma_crack_plugboard_climb()) stops at the first plugboard that no move
+ * improves, which on short ciphertexts is often not the right one. Each restart of this search
+ * instead starts from the plugboard of `cfg->enigma` and tries `steps` random moves of the kinds
+ * in `moves`, taking every move that improves the score, and a move that loses `d` of the score
+ * with probability `exp(-d / T)`. The temperature `T` falls geometrically from
+ * `start_temperature` to `end_temperature`, so the search wanders widely at first and settles
+ * later. The best plugboard of the run is then hill climbed to its local optimum with the same
+ * moves. Moves are rescored incrementally, as by enigma_crack_plugboard_climb().
+ *
+ * The restarts run on every worker of `cfg->executor`. Each one draws its moves from its own
+ * generator, seeded from `seed` and its index, so the results do not depend on the number of
+ * workers. The best configuration of each restart is appended to `cfg->score_list`, or written
+ * to `cfg->sink`, from the best score down and skipping duplicates, with its score computed by
+ * `scoreFunc`. Once a restart reaches the target score, or `cfg->progress` is cancelled, the
+ * restarts that have not started are skipped.
+ *
+ * @param cfg Pointer to the cracking configuration structure.
+ * @param anneal The settings, or NULL for the defaults (see EnigmaAnnealParams).
+ * @param scoreFunc Function pointer to the scoring function to use.
+ *
+ * @return `ENIGMA_SUCCESS` on success, `ENIGMA_FAILURE` on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_crack_plugboard_anneal(EnigmaCrackParams*        cfg,
+                                                       const EnigmaAnnealParams* anneal,
+                                                       float (*scoreFunc)(const EnigmaCrackParams*,
+                                                                          const char*)) {
+    EnigmaPlugboardAnnealJob job = { 0 };
+    if (anneal) {
+        job.anneal = *anneal;
+    }
+
+    EnigmaAnnealParams* params = &job.anneal;
+    if (!cfg || !scoreFunc || (!cfg->score_list && !cfg->sink) || params->restarts < 0
+        || params->steps < 0 || params->start_temperature < 0.0 || params->end_temperature < 0.0
+        || (params->moves & ~ENIGMA_PLUGBOARD_MOVES_ALL)) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    // Check the ciphertext and plugboard once, rather than in every restart
+    EnigmaPlugboardState state;
+    if (enigma_plugboard_state_init(&state, cfg, scoreFunc)) {
+        return ENIGMA_FAILURE;
+    }
+    enigma_plugboard_state_free(&state);
+
+    params->restarts = params->restarts ? params->restarts : ENIGMA_ANNEAL_RESTARTS;
+    params->steps    = params->steps ? params->steps : ENIGMA_ANNEAL_STEPS;
+    params->moves    = params->moves ? params->moves : ENIGMA_PLUGBOARD_MOVES_ALL;
+    job.cfg          = cfg;
+    job.score        = scoreFunc;
+    job.results      = malloc(params->restarts * sizeof(EnigmaScore));
+    job.texts        = malloc(params->restarts * (cfg->ciphertext_length + 1));
+    job.done         = calloc(params->restarts, sizeof(int));
+    if (!job.results || !job.texts || !job.done) {
+        free(job.results);
+        free(job.texts);
+        free(job.done);
+        return ENIGMA_ERROR("%s", "Failed to allocate annealing results");
+    }
+
+    if (cfg->progress) {
+        enigma_progress_add_total(cfg->progress, (size_t) params->restarts * params->steps);
+    }
+    if (cfg->executor && enigma_executor_get_thread_count(cfg->executor) > 1) {
+        enigma_executor_run(cfg->executor, enigma_plugboard_anneal_job, &job);
+    } else {
+        enigma_plugboard_anneal_job(&job, 0);
+    }
+
+    // Emit the results from the best down, ties in restart order, each plugboard once
+    int* order = malloc(params->restarts * sizeof(int));
+    int  count = 0;
+    int  ret   = job.failed || !order ? ENIGMA_FAILURE : ENIGMA_SUCCESS;
+    for (int i = 0; ret == ENIGMA_SUCCESS && i < params->restarts; i++) {
+        if (!job.done[i]) {
+            continue;
+        }
+
+        int j = count++;
+        for (; j > 0 && job.results[order[j - 1]].score < job.results[i].score; j--) {
+            order[j] = order[j - 1];
+        }
+        order[j] = i;
+    }
+    for (int i = 0; ret == ENIGMA_SUCCESS && i < count; i++) {
+        EnigmaKey key;
+        int       duplicate = 0;
+        enigma_key_from_enigma(&key, &job.results[order[i]].enigma);
+        for (int j = 0; !duplicate && j < i; j++) {
+            EnigmaKey other;
+            enigma_key_from_enigma(&other, &job.results[order[j]].enigma);
+            duplicate = enigma_key_compare(&key, &other) == 0;
+        }
+        if (!duplicate) {
+            ret = enigma_score_append(cfg,
+                                      &job.results[order[i]].enigma,
+                                      &job.texts[order[i] * (cfg->ciphertext_length + 1)],
+                                      job.results[order[i]].score);
+        }
+    }
+
+    free(order);
+    free(job.results);
+    free(job.texts);
+    free(job.done);
+    return ret;
+}
+
+/**
+ * @brief Recover the plugboard by hill climbing from the plugboard of `cfg->enigma`.
+ *
+ * Unlike enigma_crack_plugboard(), which tries one more pair at a time, each step scores every
+ * move that plugs two letters into each other: adding a pair of free letters (up to
+ * ENIGMA_MAX_PLUGBOARD_SETTINGS pairs), removing a pair, moving one end of a pair to a free
+ * letter, and swapping the partners of two pairs. The best move is taken until none improves the
+ * score, so pairs plugged early that turn out to be wrong can still be undone.
+ *
+ * Scoring a move only decodes the positions it changes. With enigma_ioc_score(),
+ * enigma_bigram_score(), enigma_trigram_score() or enigma_quadgram_score() only the letter
+ * counts or n-grams of those positions are rescored; any other scoring function is called on
+ * the whole text.
+ *
+ * The resulting configuration is appended to `cfg->score_list`, or written to `cfg->sink`, with
+ * its score computed by `scoreFunc`. The search runs on the calling thread, and stops after the
+ * current step if `cfg->progress` is cancelled.
+ *
+ * @param cfg Pointer to the cracking configuration structure.
+ * @param scoreFunc Function pointer to the scoring function to use.
+ *
+ * @return `ENIGMA_SUCCESS` on success, `ENIGMA_FAILURE` on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_crack_plugboard_climb(EnigmaCrackParams* cfg,
+                                                      float (*scoreFunc)(const EnigmaCrackParams*,
+                                                                         const char*)) {
+    if (!cfg || !scoreFunc || (!cfg->score_list && !cfg->sink)) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    EnigmaPlugboardState state;
+    if (enigma_plugboard_state_init(&state, cfg, scoreFunc)) {
+        return ENIGMA_FAILURE;
+    }
+    enigma_plugboard_state_climb(&state, ENIGMA_PLUGBOARD_MOVES_ALL);
+
+    Enigma result = cfg->enigma;
+    int    ret    = enigma_plugboard_state_result(&state, &result);
+    if (ret == ENIGMA_SUCCESS) {
+        ret = enigma_score_append(cfg, &result, state.text, scoreFunc(cfg, state.text));
+    }
+
+    enigma_plugboard_state_free(&state);
+    return ret;
+}
+
+/**
+ * @brief Run the restarts taken by one worker of enigma_crack_plugboard_anneal().
+ *
+ * This is the job passed to enigma_executor_run().
+ *
+ * @param arg The EnigmaPlugboardAnnealJob being run.
+ * @param index The index of the worker.
+ */
+ENIGMA_STATIC void enigma_plugboard_anneal_job(void* arg, int index) {
+    EnigmaPlugboardAnnealJob* job      = arg;
+    EnigmaProgress*           progress = job->cfg->progress;
+    int                       restart;
+
+    while (!__atomic_load_n(&job->stop, __ATOMIC_RELAXED)
+           && !(progress && enigma_progress_is_cancelled(progress))
+           && (restart = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED))
+                  < job->anneal.restarts) {
+        if (enigma_plugboard_anneal_run(job, restart)) {
+            __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+            __atomic_store_n(&job->stop, 1, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/**
+ * @brief Run one restart of enigma_crack_plugboard_anneal(), storing its best configuration.
+ *
+ * @param job The annealing job.
+ * @param restart The index of the restart.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+ENIGMA_STATIC int enigma_plugboard_anneal_run(EnigmaPlugboardAnnealJob* job, int restart) {
+    const EnigmaAnnealParams* anneal   = &job->anneal;
+    const EnigmaCrackParams*  cfg      = job->cfg;
+    EnigmaProgress*           progress = cfg->progress;
+    EnigmaPlugboardState      state;
+    if (enigma_plugboard_state_init(&state, cfg, job->score)) {
+        return ENIGMA_FAILURE;
+    }
+
+    // Mixing the index into the seed gives each restart an unrelated sequence
+    uint64_t rng = anneal->seed ^ ((uint64_t) restart * 0xD1B54A32D192ED03ull);
+    enigma_plugboard_random(&rng);
+
+    double temperature = anneal->start_temperature;
+    if (temperature <= 0.0) {
+        temperature = enigma_plugboard_state_calibrate(&state, anneal->moves, &rng);
+    }
+    double end = anneal->end_temperature;
+    if (end <= 0.0) {
+        end = temperature * ENIGMA_ANNEAL_END_RATIO;
+    }
+    double cooling = exp(log(end / temperature) / anneal->steps);
+
+    int8_t best[ENIGMA_ALPHA_SIZE];
+    int    bestPairs = state.pairs;
+    double bestTotal = state.total;
+    int    cancelled = 0;
+    memcpy(best, state.plug, sizeof(best));
+
+    for (int step = 0; step < anneal->steps && !cancelled;) {
+        int    chunk    = anneal->steps - step < ENIGMA_ANNEAL_PROGRESS_STEPS
+                            ? anneal->steps - step
+                            : ENIGMA_ANNEAL_PROGRESS_STEPS;
+        size_t rescored = 0;
+
+        for (int k = 0; k < chunk; k++) {
+            int8_t   next[ENIGMA_ALPHA_SIZE];
+            int      pairs;
+            uint32_t mask = enigma_plugboard_random_move(&state, &rng, anneal->moves, next, &pairs);
+
+            temperature *= cooling;
+            if (!mask) {
+                continue;
+            }
+
+            size_t count  = enigma_plugboard_state_diff(&state, next, mask);
+            double delta  = count ? enigma_plugboard_state_delta(&state, count) : 0.0;
+            rescored     += count;
+            if (delta < 0.0
+                && (enigma_plugboard_random(&rng) >> 11) * 0x1.0p-53
+                       >= exp(delta / state.scale / temperature)) {
+                continue;
+            }
+
+            enigma_plugboard_state_apply(&state, next, pairs, count, delta);
+            if (state.total > bestTotal + ENIGMA_PLUGBOARD_EPSILON) {
+                memcpy(best, state.plug, sizeof(best));
+                bestPairs = state.pairs;
+                bestTotal = state.total;
+            }
+        }
+
+        step += chunk;
+        if (progress) {
+            enigma_progress_add(progress, chunk, chunk, rescored);
+            cancelled = enigma_progress_is_cancelled(progress);
+        }
+    }
+
+    // Go back to the best plugboard of the run, and finish it off
+    size_t count = enigma_plugboard_state_diff(&state, best, (1 << ENIGMA_ALPHA_SIZE) - 1);
+    double delta = count ? enigma_plugboard_state_delta(&state, count) : 0.0;
+    enigma_plugboard_state_apply(&state, best, bestPairs, count, delta);
+    enigma_plugboard_state_climb(&state, anneal->moves);
+
+    EnigmaScore* result = &job->results[restart];
+    result->enigma      = cfg->enigma;
+    int ret             = enigma_plugboard_state_result(&state, &result->enigma);
+    if (ret == ENIGMA_SUCCESS) {
+        result->score = job->score(cfg, state.text);
+        result->flags = 0;
+        memcpy(&job->texts[restart * (cfg->ciphertext_length + 1)],
+               state.text,
+               cfg->ciphertext_length + 1);
+        job->done[restart] = 1;
+        if (cfg->target_score > 0.0f && result->score >= cfg->target_score) {
+            __atomic_store_n(&job->stop, 1, __ATOMIC_RELAXED);
+        }
+    }
+
+    enigma_plugboard_state_free(&state);
+    return ret;
+}
+
+/**
+ * @brief Build the plugboard that plugs letters `a` and `b` into each other.
+ *
+ * If `a` and `b` are already plugged together, the pair is removed instead. A letter left
+ * without its partner is plugged into the other one left without its partner, or unplugged if
+ * there is none, so the move adds, removes, moves or swaps pairs depending on the letters.
+ *
+ * @param state The current plugboard.
+ * @param a The first letter (0-25).
+ * @param b The second letter (0-25), not `a`.
+ * @param next Set to the new plugboard.
+ * @param pairs Set to the number of pairs of the new plugboard.
+ * @return The letters whose partner changes, as a bit mask, or 0 if the move would exceed
+ * ENIGMA_MAX_PLUGBOARD_SETTINGS pairs.
+ */
+ENIGMA_STATIC uint32_t enigma_plugboard_connect(
+    const EnigmaPlugboardState* state, int a, int b, int8_t* next, int* pairs) {
+    int x = state->plug[a];
+    int y = state->plug[b];
+
+    memcpy(next, state->plug, sizeof(state->plug));
+    *pairs = state->pairs;
+    if (x == b) {
+        next[a] = a;
+        next[b] = b;
+        *pairs -= 1;
+        return (1u << a) | (1u << b);
+    }
+    if (x == a && y == b) {
+        if (state->pairs >= ENIGMA_MAX_PLUGBOARD_SETTINGS) {
+            return 0;
+        }
+        *pairs += 1;
+    }
+
+    uint32_t mask = (1u << a) | (1u << b);
+    next[a]       = b;
+    next[b]       = a;
+    if (x != a) {
+        next[x]  = y != b ? y : x;
+        mask    |= 1u << x;
+    }
+    if (y != b) {
+        next[y]  = x != a ? x : y;
+        mask    |= 1u << y;
+    }
+    return mask;
+}
+
+/**
+ * @brief Classify the move built by enigma_plugboard_connect().
+ *
+ * @param state The current plugboard.
+ * @param a The first letter (0-25).
+ * @param b The second letter (0-25), not `a`.
+ * @return One of the ENIGMA_PLUGBOARD_MOVE_ flags.
+ */
+ENIGMA_STATIC int enigma_plugboard_move(const EnigmaPlugboardState* state, int a, int b) {
+    int x = state->plug[a];
+    int y = state->plug[b];
+
+    if (x == b) {
+        return ENIGMA_PLUGBOARD_MOVE_REMOVE;
+    }
+    if (x == a && y == b) {
+        return ENIGMA_PLUGBOARD_MOVE_ADD;
+    }
+    if (x == a || y == b) {
+        return ENIGMA_PLUGBOARD_MOVE_REPLUG;
+    }
+    return ENIGMA_PLUGBOARD_MOVE_SWAP;
+}
+
+/**
+ * @brief Look up the n-gram of the current plaintext starting at a position.
+ *
+ * @param state The plugboard state, with `n` from 2 to 4.
+ * @param start The first position of the n-gram.
+ * @return The n-gram's entry in `cfg->ngrams`.
+ */
+ENIGMA_STATIC ENIGMA_ALWAYS_INLINE float enigma_plugboard_ngram(const EnigmaPlugboardState* state,
+                                                                size_t                      start) {
+    const uint8_t* p   = &state->plaintext[start];
+    int            idx = 0;
+    for (int k = 0; k < state->n; k++) {
+        idx = (idx << 5) | p[k];
+    }
+    return state->cfg->ngrams[idx];
+}
+
+/**
+ * @brief Draw the next number of a SplitMix64 generator.
+ *
+ * @param rng The generator state, advanced by the call.
+ * @return A uniformly distributed 64-bit number.
+ */
+ENIGMA_STATIC uint64_t enigma_plugboard_random(uint64_t* rng) {
+    uint64_t z = (*rng += 0x9E3779B97F4A7C15ull);
+    z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z          = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Build the move connecting two random letters.
+ *
+ * @param state The current plugboard.
+ * @param rng The generator to draw the letters from.
+ * @param moves The ENIGMA_PLUGBOARD_MOVE_ flags of the moves allowed.
+ * @param next Set to the new plugboard.
+ * @param pairs Set to the number of pairs of the new plugboard.
+ * @return The letters whose partner changes, as a bit mask, or 0 if the move drawn is not
+ * allowed.
+ */
+ENIGMA_STATIC uint32_t enigma_plugboard_random_move(
+    const EnigmaPlugboardState* state, uint64_t* rng, int moves, int8_t* next, int* pairs) {
+    int a = enigma_plugboard_random(rng) % ENIGMA_ALPHA_SIZE;
+    int b = enigma_plugboard_random(rng) % (ENIGMA_ALPHA_SIZE - 1);
+    b    += b >= a;
+
+    if (!(enigma_plugboard_move(state, a, b) & moves)) {
+        return 0;
+    }
+    return enigma_plugboard_connect(state, a, b, next, pairs);
+}
+
+/**
+ * @brief Apply a move scored by enigma_plugboard_state_diff() and enigma_plugboard_state_delta().
+ *
+ * @param state The plugboard state.
+ * @param next The new plugboard.
+ * @param pairs The number of pairs of the new plugboard.
+ * @param count The number of changed positions.
+ * @param delta The change of `total`.
+ */
+ENIGMA_STATIC void enigma_plugboard_state_apply(
+    EnigmaPlugboardState* state, const int8_t* next, int pairs, size_t count, double delta) {
+    for (size_t k = 0; k < count; k++) {
+        size_t i = state->changed[k];
+        state->counts[state->plaintext[i]]--;
+        state->counts[state->letters[k]]++;
+        state->plaintext[i] = state->letters[k];
+        state->text[i]      = 'A' + state->letters[k];
+    }
+
+    memcpy(state->plug, next, sizeof(state->plug));
+    state->pairs  = pairs;
+    state->total += delta;
+}
+
+/**
+ * @brief Pick a starting temperature from the score lost by random moves.
+ *
+ * At the average loss, a losing move is taken with probability 1/e.
+ *
+ * @param state The plugboard state.
+ * @param moves The ENIGMA_PLUGBOARD_MOVE_ flags of the moves allowed.
+ * @param rng The generator to draw the moves from.
+ * @return The temperature, in score units.
+ */
+ENIGMA_STATIC double enigma_plugboard_state_calibrate(EnigmaPlugboardState* state,
+                                                      int                   moves,
+                                                      uint64_t*             rng) {
+    double loss  = 0.0;
+    int    count = 0;
+
+    for (int i = 0; i < ENIGMA_ANNEAL_CALIBRATION_MOVES; i++) {
+        int8_t   next[ENIGMA_ALPHA_SIZE];
+        int      pairs;
+        uint32_t mask = enigma_plugboard_random_move(state, rng, moves, next, &pairs);
+        size_t   changed = mask ? enigma_plugboard_state_diff(state, next, mask) : 0;
+        double   delta   = changed ? enigma_plugboard_state_delta(state, changed) : 0.0;
+        if (delta < 0.0) {
+            loss -= delta;
+            count++;
+        }
+    }
+
+    return (count ? loss / count : ENIGMA_PLUGBOARD_EPSILON) / state->scale;
+}
+
+/**
+ * @brief Take the best move until none improves the score.
+ *
+ * @param state The plugboard state.
+ * @param moves The ENIGMA_PLUGBOARD_MOVE_ flags of the moves allowed.
+ */
+ENIGMA_STATIC void enigma_plugboard_state_climb(EnigmaPlugboardState* state, int moves) {
+    EnigmaProgress* progress = state->cfg->progress;
+
+    while (!progress || !enigma_progress_is_cancelled(progress)) {
+        int8_t best[ENIGMA_ALPHA_SIZE];
+        double bestDelta = ENIGMA_PLUGBOARD_EPSILON;
+        int    bestPairs = -1;
+        size_t tried     = 0;
+        size_t rescored  = 0;
+
+        for (int a = 0; a < ENIGMA_ALPHA_SIZE; a++) {
+            for (int b = a + 1; b < ENIGMA_ALPHA_SIZE; b++) {
+                int8_t   next[ENIGMA_ALPHA_SIZE];
+                int      pairs;
+                uint32_t mask = 0;
+                if (enigma_plugboard_move(state, a, b) & moves) {
+                    mask = enigma_plugboard_connect(state, a, b, next, &pairs);
+                }
+                if (!mask) {
+                    continue;
+                }
+
+                size_t count  = enigma_plugboard_state_diff(state, next, mask);
+                double delta  = count ? enigma_plugboard_state_delta(state, count) : 0.0;
+                tried        += 1;
+                rescored     += count;
+                if (delta > bestDelta) {
+                    memcpy(best, next, sizeof(best));
+                    bestDelta = delta;
+                    bestPairs = pairs;
+                }
+            }
+        }
+
+        if (progress) {
+            enigma_progress_add_total(progress, tried);
+            enigma_progress_add(progress, tried, tried, rescored);
+        }
+        if (bestPairs < 0) {
+            break;
+        }
+
+        // Only the best move's changes are kept, so it is diffed again before being applied
+        size_t count = enigma_plugboard_state_diff(state, best, (1 << ENIGMA_ALPHA_SIZE) - 1);
+        enigma_plugboard_state_apply(state, best, bestPairs, count, bestDelta);
+    }
+}
+
+/**
+ * @brief Score the changes found by enigma_plugboard_state_diff().
+ *
+ * @param state The plugboard state.
+ * @param count The number of changed positions.
+ * @return The change of `total` the move would make.
+ */
+ENIGMA_STATIC double enigma_plugboard_state_delta(EnigmaPlugboardState* state, size_t count) {
+    if (state->n == 1) {
+        int counts[ENIGMA_ALPHA_SIZE];
+        memcpy(counts, state->counts, sizeof(counts));
+        for (size_t k = 0; k < count; k++) {
+            counts[state->plaintext[state->changed[k]]]--;
+            counts[state->letters[k]]++;
+        }
+
+        double total = 0.0;
+        for (int i = 0; i < ENIGMA_ALPHA_SIZE; i++) {
+            total += (double) counts[i] * (counts[i] - 1);
+        }
+        return total - state->total;
+    }
+
+    if (state->n == 0) {
+        for (size_t k = 0; k < count; k++) {
+            state->text[state->changed[k]] = 'A' + state->letters[k];
+        }
+        double score = state->score(state->cfg, state->text);
+        for (size_t k = 0; k < count; k++) {
+            size_t i       = state->changed[k];
+            state->text[i] = 'A' + state->plaintext[i];
+        }
+        return score - state->total;
+    }
+
+    // Swap the new letters in to sum the same windows again, then swap the old ones back
+    double before = enigma_plugboard_state_windows(state, count);
+    for (size_t k = 0; k < count; k++) {
+        uint8_t* p        = &state->plaintext[state->changed[k]];
+        uint8_t  letter   = *p;
+        *p                = state->letters[k];
+        state->letters[k] = letter;
+    }
+    double after = enigma_plugboard_state_windows(state, count);
+    for (size_t k = 0; k < count; k++) {
+        uint8_t* p        = &state->plaintext[state->changed[k]];
+        uint8_t  letter   = *p;
+        *p                = state->letters[k];
+        state->letters[k] = letter;
+    }
+    return after - before;
+}
+
+/**
+ * @brief Find the positions whose plaintext a new plugboard changes.
+ *
+ * Only positions whose ciphertext letter or scrambler output is in `mask` can change. They are
+ * stored in `changed`, in increasing order, with their new letters in `letters`.
+ *
+ * @param state The plugboard state.
+ * @param next The new plugboard.
+ * @param mask The letters whose partner differs between the plugboards, as a bit mask.
+ * @return The number of changed positions.
+ */
+ENIGMA_STATIC size_t enigma_plugboard_state_diff(EnigmaPlugboardState* state,
+                                                 const int8_t*         next,
+                                                 uint32_t              mask) {
+    size_t count = 0;
+
+    for (size_t i = 0; i < state->length; i++) {
+        const uint8_t* scrambled = &state->scrambled[i * ENIGMA_ALPHA_SIZE];
+        int            c         = state->ciphertext[i];
+        int            m         = scrambled[state->plug[c]];
+        if (!((mask >> c) & 1) && !((mask >> m) & 1)) {
+            continue;
+        }
+
+        int p = next[scrambled[next[c]]];
+        if (p != state->plaintext[i]) {
+            state->changed[count] = i;
+            state->letters[count] = p;
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Free the buffers of a plugboard state.
+ *
+ * @param state The plugboard state.
+ */
+ENIGMA_STATIC void enigma_plugboard_state_free(EnigmaPlugboardState* state) {
+    free(state->ciphertext);
+    free(state->scrambled);
+    free(state->plaintext);
+    free(state->text);
+    free(state->changed);
+    free(state->letters);
+}
+
+/**
+ * @brief Decode the ciphertext under the plugboard of `cfg->enigma`.
+ *
+ * @param state The plugboard state to initialize. It is freed on failure.
+ * @param cfg The crack parameters.
+ * @param scoreFunc The scoring function.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+ENIGMA_STATIC int enigma_plugboard_state_init(EnigmaPlugboardState*    state,
+                                              const EnigmaCrackParams* cfg,
+                                              float (*scoreFunc)(const EnigmaCrackParams*,
+                                                                 const char*)) {
+    memset(state, 0, sizeof(EnigmaPlugboardState));
+
+    Enigma enigma = cfg->enigma;
+    if (!cfg->ciphertext || cfg->ciphertext_length == 0 || !enigma.reflector
+        || enigma_set_plugboard(&enigma, cfg->enigma.plugboard)) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    state->cfg    = cfg;
+    state->score  = scoreFunc;
+    state->length = cfg->ciphertext_length;
+    if (scoreFunc == enigma_ioc_score) {
+        state->n = 1;
+    } else if (cfg->ngrams && scoreFunc == enigma_bigram_score) {
+        state->n = 2;
+    } else if (cfg->ngrams && scoreFunc == enigma_trigram_score) {
+        state->n = 3;
+    } else if (cfg->ngrams && scoreFunc == enigma_quadgram_score) {
+        state->n = 4;
+    }
+
+    size_t length     = state->length;
+    state->ciphertext = malloc(length);
+    state->scrambled  = malloc(length * ENIGMA_ALPHA_SIZE);
+    state->plaintext  = malloc(length);
+    state->text       = malloc(length + 1);
+    state->changed    = malloc(length * sizeof(size_t));
+    state->letters    = malloc(length);
+    if (!state->ciphertext || !state->scrambled || !state->plaintext || !state->text
+        || !state->changed || !state->letters) {
+        enigma_plugboard_state_free(state);
+        return ENIGMA_ERROR("%s", "Failed to allocate plugboard state");
+    }
+    if (enigma_text_to_indices(cfg->ciphertext, state->ciphertext, length)) {
+        enigma_plugboard_state_free(state);
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    // Encoding a run of one letter without the plugboard gives its scrambler output everywhere
+    Enigma bare = enigma;
+    enigma_set_plugboard(&bare, "");
+    for (int x = 0; x < ENIGMA_ALPHA_SIZE; x++) {
+        Enigma run = bare;
+        memset(state->plaintext, x, length);
+        enigma_encode_indices_unchecked(&run, state->plaintext, state->letters, length);
+        for (size_t i = 0; i < length; i++) {
+            state->scrambled[i * ENIGMA_ALPHA_SIZE + x] = state->letters[i];
+        }
+    }
+
+    for (int i = 0; i < ENIGMA_ALPHA_SIZE; i++) {
+        state->plug[i] = i + enigma.plugboard_offsets[i];
+    }
+    state->pairs = strlen(enigma.plugboard) / 2;
+
+    for (size_t i = 0; i < length; i++) {
+        const uint8_t* scrambled = &state->scrambled[i * ENIGMA_ALPHA_SIZE];
+        int            p = state->plug[scrambled[state->plug[state->ciphertext[i]]]];
+        state->plaintext[i] = p;
+        state->text[i]      = 'A' + p;
+        state->counts[p]++;
+    }
+    state->text[length] = '\0';
+    state->total        = enigma_plugboard_state_total(state);
+    state->scale        = state->n == 1 && length > 1 ? (double) length * (length - 1)
+                          : state->n > 1              ? (double) length
+                                                      : 1.0;
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Set the plugboard of an Enigma to the current plugboard, in alphabetical order.
+ *
+ * @param state The plugboard state.
+ * @param enigma The Enigma to update.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+ENIGMA_STATIC int enigma_plugboard_state_result(const EnigmaPlugboardState* state,
+                                                Enigma*                     enigma) {
+    char plugboard[ENIGMA_ALPHA_SIZE + 1];
+    int  len = 0;
+
+    for (int a = 0; a < ENIGMA_ALPHA_SIZE; a++) {
+        if (state->plug[a] > a) {
+            plugboard[len++] = 'A' + a;
+            plugboard[len++] = 'A' + state->plug[a];
+        }
+    }
+    plugboard[len] = '\0';
+    return enigma_set_plugboard(enigma, plugboard);
+}
+
+/**
+ * @brief Compute `total` for the current plaintext from scratch.
+ *
+ * @param state The plugboard state.
+ * @return The total.
+ */
+ENIGMA_STATIC double enigma_plugboard_state_total(const EnigmaPlugboardState* state) {
+    double total = 0.0;
+
+    if (state->n == 0) {
+        return state->score(state->cfg, state->text);
+    }
+    if (state->n == 1) {
+        for (int i = 0; i < ENIGMA_ALPHA_SIZE; i++) {
+            total += (double) state->counts[i] * (state->counts[i] - 1);
+        }
+        return total;
+    }
+
+    for (size_t i = 0; i + state->n <= state->length; i++) {
+        total += enigma_plugboard_ngram(state, i);
+    }
+    return total;
+}
+
+/**
+ * @brief Sum the n-grams of the current plaintext that overlap the changed positions.
+ *
+ * Each n-gram is counted once, even if it overlaps several changed positions.
+ *
+ * @param state The plugboard state, with `n` from 2 to 4.
+ * @param count The number of changed positions.
+ * @return The sum of the n-grams.
+ */
+ENIGMA_STATIC double enigma_plugboard_state_windows(const EnigmaPlugboardState* state,
+                                                    size_t                      count) {
+    size_t n     = state->n;
+    double total = 0.0;
+    size_t next  = 0;
+
+    if (state->length < n) {
+        return 0.0;
+    }
+
+    size_t last = state->length - n;
+    for (size_t k = 0; k < count; k++) {
+        size_t i    = state->changed[k];
+        size_t from = i + 1 > n ? i + 1 - n : 0;
+        size_t to   = i < last ? i : last;
+        for (size_t s = from > next ? from : next; s <= to; s++) {
+            total += enigma_plugboard_ngram(state, s);
+        }
+        if (to + 1 > next) {
+            next = to + 1;
+        }
+    }
+    return total;
+}
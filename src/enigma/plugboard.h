@@ -0,0 +1,84 @@
+/**
+ * @file enigma/plugboard.h
+ *
+ * This file declares functions for recovering the whole plugboard of a configuration whose
+ * rotors, rotor positions and reflector are known, by local search over plugboards.
+ */
+#ifndef ENIGMA_PLUGBOARD_H
+#define ENIGMA_PLUGBOARD_H
+
+#include "crack.h"
+
+#include <stdint.h>
+
+/**
+ * @brief Move plugging two free letters together.
+ */
+#define ENIGMA_PLUGBOARD_MOVE_ADD 1
+
+/**
+ * @brief Move unplugging a pair.
+ */
+#define ENIGMA_PLUGBOARD_MOVE_REMOVE 2
+
+/**
+ * @brief Move plugging one letter of a pair into a free letter instead.
+ */
+#define ENIGMA_PLUGBOARD_MOVE_REPLUG 4
+
+/**
+ * @brief Move swapping the partners of two pairs.
+ */
+#define ENIGMA_PLUGBOARD_MOVE_SWAP 8
+
+/**
+ * @brief Every plugboard move.
+ */
+#define ENIGMA_PLUGBOARD_MOVES_ALL                                                                 \
+    (ENIGMA_PLUGBOARD_MOVE_ADD | ENIGMA_PLUGBOARD_MOVE_REMOVE | ENIGMA_PLUGBOARD_MOVE_REPLUG       \
+     | ENIGMA_PLUGBOARD_MOVE_SWAP)
+
+#ifndef ENIGMA_ANNEAL_RESTARTS
+/**
+ * @brief Default number of independent runs of enigma_crack_plugboard_anneal().
+ */
+#define ENIGMA_ANNEAL_RESTARTS 32
+#endif
+
+#ifndef ENIGMA_ANNEAL_STEPS
+/**
+ * @brief Default number of moves tried by each run of enigma_crack_plugboard_anneal().
+ */
+#define ENIGMA_ANNEAL_STEPS 20000
+#endif
+
+#ifndef ENIGMA_ANNEAL_END_RATIO
+/**
+ * @brief Default ratio of the final temperature of enigma_crack_plugboard_anneal() to its
+ * starting temperature.
+ */
+#define ENIGMA_ANNEAL_END_RATIO 0.001
+#endif
+
+/**
+ * @struct EnigmaAnnealParams
+ * @brief Settings of enigma_crack_plugboard_anneal().
+ *
+ * A zeroed structure selects the default of every setting.
+ */
+typedef struct {
+    int      restarts; //!< Independent runs, or 0 for ENIGMA_ANNEAL_RESTARTS.
+    int      steps; //!< Moves tried by each run, or 0 for ENIGMA_ANNEAL_STEPS.
+    double   start_temperature; //!< Starting temperature in score units, or 0 to calibrate it.
+    double   end_temperature; //!< Final temperature, or 0 for ENIGMA_ANNEAL_END_RATIO * start.
+    int      moves; //!< ENIGMA_PLUGBOARD_MOVE_ flags of the moves tried, or 0 for all of them.
+    uint64_t seed; //!< Seed of the random moves; a run depends only on it and its index.
+} EnigmaAnnealParams;
+
+int enigma_crack_plugboard_anneal(EnigmaCrackParams*,
+                                  const EnigmaAnnealParams*,
+                                  float (*)(const EnigmaCrackParams*, const char*));
+int enigma_crack_plugboard_climb(EnigmaCrackParams*,
+                                 float (*)(const EnigmaCrackParams*, const char*));
+
+#endif
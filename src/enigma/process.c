@@ -0,0 +1,172 @@
+/**
+ * @file enigma/process.c
+ *
+ * This file implements multi-process cracking.
+ *
+ * Workers are forked from the caller, so they see the caller's n-grams, dictionary and other
+ * read-only state copy-on-write, without copying it, and any state that is not safe to share
+ * between threads is private to each worker. Each worker runs one shard of the keyspace and
+ * keeps its best scores in its own slot of a shared anonymous mapping, which the caller merges
+ * once every worker has exited.
+ *
+ * Since a forked worker has the same address space layout as the caller, the rotor and
+ * reflector pointers of the published configurations are valid in the caller as well.
+ *
+ * Without fork() (see ENIGMA_PROCESSES), enigma_process_crack() only validates its arguments
+ * and fails.
+ */
+#include "process.h"
+
+#include "common.h"
+#include "io.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef ENIGMA_PROCESSES
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+ENIGMA_STATIC void enigma_process_worker(const EnigmaCrackParams*,
+                                         EnigmaProcessSlot*,
+                                         int,
+                                         int,
+                                         EnigmaProcessFunc,
+                                         void*);
+#endif
+
+/**
+ * @brief Run a crack function in forked worker processes and merge their best scores.
+ *
+ * The keyspace is split into one shard per worker (see enigma_crack_set_shard()); if `cfg`
+ * is already restricted to a shard, that shard is split further. Each worker runs `func` on
+ * its own copy of `cfg`, whose score list is a top-K list of the same size as
+ * `cfg->score_list`, and the best scores of all the workers are pushed to `cfg->score_list`.
+ *
+ * Threads do not survive fork(), so the workers' `executor` is NULL; `func` may create an
+ * executor of its own to run several threads per worker. A target score only stops the
+ * worker that reaches it.
+ *
+ * @param cfg The EnigmaCrackParams struct instance. Its score list must be a top-K list, and
+ * it must not have a sink or a checkpoint.
+ * @param processes The number of worker processes (at least 1).
+ * @param func The crack function call to run in each worker.
+ * @param arg The argument to pass to `func`.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE if a worker failed or the platform cannot
+ * fork. The scores of the workers that succeeded are merged either way.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_process_crack(EnigmaCrackParams* cfg,
+                                              int                processes,
+                                              EnigmaProcessFunc  func,
+                                              void*              arg) {
+    if (!cfg || !cfg->score_list || cfg->score_list->top_k < 1 || cfg->sink || cfg->checkpoint
+        || processes < 1 || !func) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+#ifndef ENIGMA_PROCESSES
+    return ENIGMA_ERROR("%s", "Worker processes are not supported on this platform");
+#else
+    size_t slotSize = sizeof(EnigmaProcessSlot) + cfg->score_list->top_k * sizeof(EnigmaScore);
+    char*  slots    = mmap(NULL,
+                       slotSize * processes,
+                       PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_ANONYMOUS,
+                       -1,
+                       0);
+    if (slots == MAP_FAILED) {
+        return ENIGMA_ERROR("%s", "Failed to map worker process slots");
+    }
+
+    pid_t* pids = malloc(processes * sizeof(pid_t));
+    if (!pids) {
+        munmap(slots, slotSize * processes);
+        return ENIGMA_ERROR("%s", "Failed to allocate worker processes");
+    }
+
+    // Anything still buffered would otherwise be written again by every worker
+    fflush(NULL);
+
+    int ret     = ENIGMA_SUCCESS;
+    int started = 0;
+    for (; started < processes; started++) {
+        EnigmaProcessSlot* slot = (EnigmaProcessSlot*) (slots + started * slotSize);
+        slot->status            = ENIGMA_FAILURE;
+        pids[started]           = fork();
+        if (pids[started] < 0) {
+            ret = ENIGMA_ERROR("%s", "Failed to start worker process");
+            break;
+        }
+        if (pids[started] == 0) {
+            enigma_process_worker(cfg, slot, started, processes, func, arg);
+        }
+    }
+
+    for (int i = 0; i < started; i++) {
+        EnigmaProcessSlot* slot = (EnigmaProcessSlot*) (slots + i * slotSize);
+        int                status;
+        pid_t              pid;
+        while ((pid = waitpid(pids[i], &status, 0)) < 0 && errno == EINTR) {
+        }
+
+        if (pid < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS
+            || slot->status != ENIGMA_SUCCESS) {
+            ret = ENIGMA_ERROR("Worker process %d failed", i);
+            continue;
+        }
+        for (int j = 0; j < slot->scores.score_count; j++) {
+            if (enigma_score_list_push(cfg->score_list, &slot->scores.scores[j])) {
+                ret = ENIGMA_FAILURE;
+                break;
+            }
+        }
+    }
+
+    free(pids);
+    munmap(slots, slotSize * processes);
+    return ret;
+#endif
+}
+
+#ifdef ENIGMA_PROCESSES
+
+/**
+ * @brief Run the shard of one worker process and exit.
+ *
+ * @param cfg The caller's EnigmaCrackParams
+ * @param slot The worker's slot, followed by room for `top_k` scores
+ * @param index The index of the worker
+ * @param count The number of workers
+ * @param func The crack function call to run
+ * @param arg The argument to pass to `func`
+ */
+ENIGMA_STATIC void enigma_process_worker(const EnigmaCrackParams* cfg,
+                                         EnigmaProcessSlot*       slot,
+                                         int                      index,
+                                         int                      count,
+                                         EnigmaProcessFunc        func,
+                                         void*                    arg) {
+    EnigmaCrackParams params = *cfg;
+    int               shard  = cfg->shard_count > 1 ? cfg->shard : 0;
+    int               shards = cfg->shard_count > 1 ? cfg->shard_count : 1;
+
+    // The list never grows past top_k, so it never leaves the slot
+    slot->scores.scores      = (EnigmaScore*) (slot + 1);
+    slot->scores.score_count = 0;
+    slot->scores.max_scores  = cfg->score_list->top_k;
+    slot->scores.top_k       = cfg->score_list->top_k;
+    params.score_list        = &slot->scores;
+    params.executor          = NULL;
+    params.shard             = shard * count + index;
+    params.shard_count       = shards * count;
+
+    slot->status = func(&params, arg);
+
+    // The caller's atexit handlers must not run in the worker
+    fflush(NULL);
+    _exit(slot->status == ENIGMA_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+#endif
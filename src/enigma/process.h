@@ -0,0 +1,44 @@
+/**
+ * @file enigma/process.h
+ *
+ * This file declares multi-process cracking, which runs a crack function in forked worker
+ * processes instead of threads.
+ */
+#ifndef ENIGMA_PROCESS_H
+#define ENIGMA_PROCESS_H
+
+#include "crack.h"
+#include "score.h"
+
+#ifndef _WIN32
+/**
+ * @brief Defined when enigma_process_crack() can fork worker processes.
+ *
+ * Windows has no fork(), so enigma_process_crack() always fails there.
+ */
+#define ENIGMA_PROCESSES
+#endif
+
+/**
+ * @brief A crack function call run by each worker process.
+ *
+ * The first argument is the worker's copy of the crack parameters, restricted to its shard of
+ * the keyspace. The second is the argument passed to enigma_process_crack().
+ */
+typedef int (*EnigmaProcessFunc)(EnigmaCrackParams*, void*);
+
+/**
+ * @struct EnigmaProcessSlot
+ * @brief The top-K scores published by one worker process, in memory shared with the parent.
+ *
+ * Each slot has a single writer, its worker, and is only read by the parent once the worker
+ * has exited, so no locks or atomics are needed.
+ */
+typedef struct {
+    EnigmaScoreList scores; //!< The worker's top-K list, backed by `scores.scores` in the slot.
+    int             status; //!< ENIGMA_SUCCESS once the worker's crack function returned it.
+} EnigmaProcessSlot;
+
+int enigma_process_crack(EnigmaCrackParams*, int, EnigmaProcessFunc, void*);
+
+#endif
@@ -0,0 +1,280 @@
+/**
+ * @file enigma/progress.c
+ *
+ * This file implements the progress of crack function calls.
+ *
+ * The crack functions add to the counters once per range of candidates rather than once per
+ * candidate, so workers rarely touch the shared counters, and a cancelled search stops at the
+ * next range boundary.
+ */
+#include "progress.h"
+
+#include "common.h"
+#include "io.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Create a progress with its counters at zero and its clock started.
+ *
+ * @return Pointer to the new progress, or NULL on failure.
+ */
+EMSCRIPTEN_KEEPALIVE EnigmaProgress* enigma_progress_new(void) {
+    EnigmaProgress* progress = malloc(sizeof(EnigmaProgress));
+    if (!progress) {
+        ENIGMA_ERROR("%s", "Failed to allocate progress");
+        return NULL;
+    }
+
+    enigma_progress_reset(progress);
+    return progress;
+}
+
+/**
+ * @brief Free a progress.
+ *
+ * @param progress The progress to free.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_progress_free(EnigmaProgress* progress) {
+    if (!progress) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    free(progress);
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Set the counters of a progress to zero, clear its cancellation and restart its clock.
+ *
+ * This also initializes a progress that was not created with enigma_progress_new(). It must not
+ * be called while a search is using the progress.
+ *
+ * @param progress The progress to reset.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_progress_reset(EnigmaProgress* progress) {
+    if (!progress) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    memset(progress, 0, sizeof(EnigmaProgress));
+    clock_gettime(CLOCK_MONOTONIC, &progress->started);
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Add the candidate indices of a starting search to the total.
+ *
+ * @param progress The progress to update.
+ * @param total The number of candidate indices the search will run.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_progress_add_total(EnigmaProgress* progress, size_t total) {
+    if (!progress) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    __atomic_fetch_add(&progress->total, total, __ATOMIC_RELAXED);
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Add a completed range of candidates to the counters.
+ *
+ * @param progress The progress to update.
+ * @param searched The number of candidate indices run.
+ * @param candidates The number of those candidates that were decoded and scored.
+ * @param characters The number of characters decrypted.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_progress_add(EnigmaProgress* progress,
+                                             size_t          searched,
+                                             size_t          candidates,
+                                             size_t          characters) {
+    if (!progress) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    __atomic_fetch_add(&progress->searched, searched, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&progress->candidates, candidates, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&progress->characters, characters, __ATOMIC_RELAXED);
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Ask the searches using a progress to stop.
+ *
+ * The searches stop at the next range boundary and return the scores of the ranges they ran.
+ * This only stores a flag, so it may be called from a signal handler.
+ *
+ * @param progress The progress of the searches to stop.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_progress_cancel(EnigmaProgress* progress) {
+    if (!progress) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    __atomic_store_n(&progress->cancelled, 1, __ATOMIC_RELAXED);
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Check whether the searches using a progress were asked to stop.
+ *
+ * @param progress The progress to check.
+ * @return 1 if enigma_progress_cancel() was called, 0 if not, or ENIGMA_FAILURE if progress is
+ * NULL.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_progress_is_cancelled(const EnigmaProgress* progress) {
+    if (!progress) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    return __atomic_load_n(&progress->cancelled, __ATOMIC_RELAXED) != 0;
+}
+
+/**
+ * @brief Get the number of candidate indices of the searches started so far.
+ *
+ * @param progress The EnigmaProgress struct instance.
+ * @return The total, or 0 if progress is NULL.
+ */
+EMSCRIPTEN_KEEPALIVE size_t enigma_progress_get_total(const EnigmaProgress* progress) {
+    if (!progress) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return 0;
+    }
+
+    return __atomic_load_n(&progress->total, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Get the number of candidate indices run so far.
+ *
+ * @param progress The EnigmaProgress struct instance.
+ * @return The number of indices run, or 0 if progress is NULL.
+ */
+EMSCRIPTEN_KEEPALIVE size_t enigma_progress_get_searched(const EnigmaProgress* progress) {
+    if (!progress) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return 0;
+    }
+
+    return __atomic_load_n(&progress->searched, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Get the number of candidate indices of the searches started so far that are left.
+ *
+ * @param progress The EnigmaProgress struct instance.
+ * @return The number of indices left, or 0 if progress is NULL.
+ */
+EMSCRIPTEN_KEEPALIVE size_t enigma_progress_get_remaining(const EnigmaProgress* progress) {
+    if (!progress) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return 0;
+    }
+
+    // The two counters are not read together, so the difference is clamped
+    size_t searched = __atomic_load_n(&progress->searched, __ATOMIC_RELAXED);
+    size_t total    = __atomic_load_n(&progress->total, __ATOMIC_RELAXED);
+    return total > searched ? total - searched : 0;
+}
+
+/**
+ * @brief Get the number of candidates decoded and scored so far.
+ *
+ * This excludes candidate indices that were skipped, e.g. rotor orders that reuse a rotor.
+ *
+ * @param progress The EnigmaProgress struct instance.
+ * @return The number of candidates, or 0 if progress is NULL.
+ */
+EMSCRIPTEN_KEEPALIVE size_t enigma_progress_get_candidates(const EnigmaProgress* progress) {
+    if (!progress) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return 0;
+    }
+
+    return __atomic_load_n(&progress->candidates, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Get the number of characters decrypted so far.
+ *
+ * @param progress The EnigmaProgress struct instance.
+ * @return The number of characters, or 0 if progress is NULL.
+ */
+EMSCRIPTEN_KEEPALIVE size_t enigma_progress_get_characters(const EnigmaProgress* progress) {
+    if (!progress) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return 0;
+    }
+
+    return __atomic_load_n(&progress->characters, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Get the number of seconds since the progress was reset.
+ *
+ * @param progress The EnigmaProgress struct instance.
+ * @return The elapsed time in seconds, or 0 if progress is NULL.
+ */
+EMSCRIPTEN_KEEPALIVE double enigma_progress_get_elapsed(const EnigmaProgress* progress) {
+    if (!progress) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return 0.0;
+    }
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) (now.tv_sec - progress->started.tv_sec)
+           + (now.tv_nsec - progress->started.tv_nsec) / 1e9;
+}
+
+/**
+ * @brief Get the number of candidates decoded and scored per second since the progress was
+ * reset.
+ *
+ * @param progress The EnigmaProgress struct instance.
+ * @return The rate, or 0 if progress is NULL or no time has passed.
+ */
+EMSCRIPTEN_KEEPALIVE double enigma_progress_get_rate(const EnigmaProgress* progress) {
+    if (!progress) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return 0.0;
+    }
+
+    double elapsed = enigma_progress_get_elapsed(progress);
+    if (elapsed <= 0.0) {
+        return 0.0;
+    }
+    return enigma_progress_get_candidates(progress) / elapsed;
+}
+
+/**
+ * @brief Estimate the number of seconds left to run the searches started so far.
+ *
+ * The estimate assumes the remaining candidate indices run at the average rate of those run so
+ * far, and does not account for searches that have not started yet.
+ *
+ * @param progress The EnigmaProgress struct instance.
+ * @return The estimate in seconds, or a negative value if progress is NULL or nothing has been
+ * run yet.
+ */
+EMSCRIPTEN_KEEPALIVE double enigma_progress_get_eta(const EnigmaProgress* progress) {
+    if (!progress) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return -1.0;
+    }
+
+    size_t searched = enigma_progress_get_searched(progress);
+    if (searched == 0) {
+        return -1.0;
+    }
+    return enigma_progress_get_remaining(progress) * enigma_progress_get_elapsed(progress)
+           / searched;
+}
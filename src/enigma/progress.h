@@ -0,0 +1,48 @@
+/**
+ * @file enigma/progress.h
+ *
+ * This file declares the progress of crack function calls, which callers can poll from another
+ * thread while a search runs, and use to cancel it.
+ */
+#ifndef ENIGMA_PROGRESS_H
+#define ENIGMA_PROGRESS_H
+
+#include <stddef.h>
+#include <time.h>
+
+/**
+ * @struct EnigmaProgress
+ * @brief Counters updated by the crack functions as each range of candidates completes.
+ *
+ * The counters are updated and read atomically, so any thread may poll them with the getters
+ * while searches run on others. One progress may be shared by several crack function calls, in
+ * which case it covers all of them.
+ */
+typedef struct {
+    size_t          total; //!< Candidate indices of the searches started so far.
+    size_t          searched; //!< Candidate indices run so far.
+    size_t          candidates; //!< Candidates decoded and scored so far.
+    size_t          characters; //!< Characters decrypted so far.
+    struct timespec started; //!< When the progress was reset.
+    int             cancelled; //!< Nonzero once the searches were asked to stop.
+} EnigmaProgress;
+
+EnigmaProgress* enigma_progress_new(void);
+int             enigma_progress_free(EnigmaProgress*);
+int             enigma_progress_reset(EnigmaProgress*);
+int             enigma_progress_add_total(EnigmaProgress*, size_t);
+int             enigma_progress_add(EnigmaProgress*, size_t, size_t, size_t);
+int             enigma_progress_cancel(EnigmaProgress*);
+int             enigma_progress_is_cancelled(const EnigmaProgress*);
+
+/* --- EnigmaProgress getters --- */
+size_t enigma_progress_get_total(const EnigmaProgress*);
+size_t enigma_progress_get_searched(const EnigmaProgress*);
+size_t enigma_progress_get_remaining(const EnigmaProgress*);
+size_t enigma_progress_get_candidates(const EnigmaProgress*);
+size_t enigma_progress_get_characters(const EnigmaProgress*);
+double enigma_progress_get_elapsed(const EnigmaProgress*);
+double enigma_progress_get_rate(const EnigmaProgress*);
+double enigma_progress_get_eta(const EnigmaProgress*);
+
+#endif
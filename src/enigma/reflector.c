@@ -30,6 +30,32 @@ EMSCRIPTEN_KEEPALIVE int enigma_reflector_generate_indices(EnigmaReflector* refl
     }
     return ENIGMA_SUCCESS;
 }
+
+/**
+ * @brief Find the index of a reflector in enigma_reflectors.
+ *
+ * Reflectors are matched by wiring, so copies of the standard reflectors are found too.
+ *
+ * @param reflector The reflector to look up.
+ * @return The index of the reflector in enigma_reflectors, or ENIGMA_FAILURE if it is not a
+ * standard reflector.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_reflector_id(const EnigmaReflector* reflector) {
+    if (!reflector) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    for (int id = 0; id < ENIGMA_REFLECTOR_COUNT; id++) {
+        if (reflector == enigma_reflectors[id]
+            || !memcmp(reflector->indices,
+                       enigma_reflectors[id]->indices,
+                       sizeof(reflector->indices))) {
+            return id;
+        }
+    }
+    return ENIGMA_FAILURE;
+}
+
 /**
  * @brief Get the name of the reflector.
  *
@@ -67,6 +67,7 @@ static const EnigmaReflector* enigma_reflectors[] = {
 };
 
 int enigma_reflector_generate_indices(EnigmaReflector*, const char*);
+int enigma_reflector_id(const EnigmaReflector*);
 
 /* --- EnigmaReflector getters and setters --- */
 const char* enigma_reflector_get_name(const EnigmaReflector*);
@@ -37,9 +37,62 @@ EMSCRIPTEN_KEEPALIVE int enigma_rotor_generate_indices(EnigmaRotor* rotor, const
         }
     }
 
+    return enigma_rotor_update_turnovers(rotor);
+}
+
+/**
+ * @brief Recompute the turnover mask of the rotor.
+ *
+ * This function sets bit `p` of the rotor's turnover mask for every position `p` at which the
+ * rotor steps the next rotor, i.e. every position whose forward index is one of the notches.
+ * The setters call it already; it only needs to be called after writing the rotor's fields
+ * directly.
+ *
+ * @param rotor The rotor to update.
+ * @return ENIGMA_SUCCESS on success, or ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_rotor_update_turnovers(EnigmaRotor* rotor) {
+    if (!rotor) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    rotor->turnovers = 0;
+    for (int p = 0; p < ENIGMA_ALPHA_SIZE; p++) {
+        for (int i = 0; i < rotor->notches_count; i++) {
+            if (rotor->fwd_indices[p] == rotor->notches[i]) {
+                rotor->turnovers |= 1 << p;
+            }
+        }
+    }
     return ENIGMA_SUCCESS;
 }
 
+/**
+ * @brief Find the index of a rotor in enigma_rotors.
+ *
+ * Rotors are matched by wiring and turnovers, so copies of the standard rotors are found too.
+ *
+ * @param rotor The rotor to look up.
+ * @return The index of the rotor in enigma_rotors, or ENIGMA_FAILURE if it is not a standard
+ * rotor.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_rotor_id(const EnigmaRotor* rotor) {
+    if (!rotor) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    for (int id = 0; id < ENIGMA_ROTOR_COUNT; id++) {
+        if (rotor == enigma_rotors[id]
+            || (rotor->turnovers == enigma_rotors[id]->turnovers
+                && !memcmp(rotor->fwd_indices,
+                           enigma_rotors[id]->fwd_indices,
+                           sizeof(rotor->fwd_indices)))) {
+            return id;
+        }
+    }
+    return ENIGMA_FAILURE;
+}
+
 /**
  * @brief Get the name of the rotor.
  *
@@ -119,6 +172,43 @@ EMSCRIPTEN_KEEPALIVE int enigma_rotor_get_notches_count(const EnigmaRotor* rotor
     return rotor->notches_count;
 }
 
+/**
+ * @brief Get the turnover mask of the rotor.
+ *
+ * This function gets the mask of the positions at which the rotor steps the next rotor.
+ *
+ * @param rotor The rotor to get the turnover mask of.
+ * @return the turnover mask of the rotor on success, or ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_rotor_get_turnovers(const EnigmaRotor* rotor) {
+    if (!rotor) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+    return rotor->turnovers;
+}
+
+/**
+ * @brief Get the turnover mask of the rotor over ring offsets.
+ *
+ * A ring setting turns the rotor's wiring but not its notches, so an encoder that tracks each
+ * rotor's ring offset (position minus ring setting) instead of its position can test this mask
+ * the way it would test the turnover mask: bit `o` is set if the rotor steps the next rotor at
+ * ring offset `o`.
+ *
+ * @param rotor The rotor to get the turnover mask of.
+ * @param ring The ring setting of the rotor (0-25).
+ * @return the turnover mask over ring offsets on success, or ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_rotor_get_ring_turnovers(const EnigmaRotor* rotor, int ring) {
+    if (!rotor || ring < 0 || ring >= ENIGMA_ALPHA_SIZE) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    unsigned int turnovers = rotor->turnovers;
+    unsigned int rotated   = (turnovers >> ring) | (turnovers << (ENIGMA_ALPHA_SIZE - ring));
+    return rotated & ((1u << ENIGMA_ALPHA_SIZE) - 1);
+}
+
 /**
  * @brief Set the name of the rotor.
  *
@@ -150,7 +240,7 @@ EMSCRIPTEN_KEEPALIVE int enigma_rotor_set_fwd_indices(EnigmaRotor* rotor, const
         return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
     }
     memcpy(rotor->fwd_indices, indices, sizeof(int) * 26);
-    return ENIGMA_SUCCESS;
+    return enigma_rotor_update_turnovers(rotor);
 }
 
 /**
@@ -187,7 +277,7 @@ enigma_rotor_set_notches(EnigmaRotor* rotor, const int* notches, int count) {
     }
     memcpy(rotor->notches, notches, sizeof(int) * count);
     rotor->notches_count = count;
-    return ENIGMA_SUCCESS;
+    return enigma_rotor_update_turnovers(rotor);
 }
 
 /**
@@ -204,5 +294,5 @@ EMSCRIPTEN_KEEPALIVE int enigma_rotor_set_notches_count(EnigmaRotor* rotor, int
         return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
     }
     rotor->notches_count = count;
-    return ENIGMA_SUCCESS;
+    return enigma_rotor_update_turnovers(rotor);
 }
@@ -19,6 +19,11 @@
  *
  * Indices here are entered manually to avoid extra calculation at runtime. Essentially, they map
  * the rotor's alphabet to the standard alphabet (A-Z).
+ *
+ * `turnovers` is precomputed from the indices and notches for the same reason, so that stepping
+ * is a bit test. Bit `p` is set if the rotor steps the next rotor when it is at position `p`,
+ * which is when `fwd_indices[p]` is one of the notches. The setters keep it up to date; if the
+ * fields are written directly, call enigma_rotor_update_turnovers() afterwards.
  */
 typedef struct {
     const char* name; //!< Name of the rotor.
@@ -28,6 +33,7 @@ typedef struct {
         [ENIGMA_ALPHA_SIZE]; //!< Character code of each rotor's alphabetic character in the standard alphabet.
     int notches[2]; //!< Array of notch positions.
     int notches_count; //!< Number of notches.
+    int turnovers; //!< Mask of the positions at which the rotor steps the next rotor.
 } EnigmaRotor;
 
 // clang-format off
@@ -49,6 +55,7 @@ static const EnigmaRotor enigma_rotor_I = {
                        10, 12, 19, 7, 23, 18, 11, 17, 8,  13, 16, 14, 9 },
     .notches       = { 16 },
     .notches_count = 1,
+    .turnovers     = 1 << 7,
 };
 
 /**
@@ -65,6 +72,7 @@ static const EnigmaRotor enigma_rotor_II = {
                        19, 24, 20, 16, 6,  4,  13, 7,  23, 12, 8, 21, 18 },
     .notches       = { 4 },
     .notches_count = 1,
+    .turnovers     = 1 << 25,
 };
 
 /**
@@ -81,6 +89,7 @@ static const EnigmaRotor enigma_rotor_III = {
                        13, 25, 7, 24, 8,  23, 9,  22, 11, 17, 10, 14, 12 },
     .notches       = { 21 },
     .notches_count = 1,
+    .turnovers     = 1 << 11,
 };
 
 /**
@@ -97,6 +106,7 @@ static const EnigmaRotor enigma_rotor_IV = {
                        16, 2,  4,  9,  12, 1,  18, 10, 3,  24, 14, 8,  5 },
     .notches       = { 17 },
     .notches_count = 1,
+    .turnovers     = 1 << 12,
 };
 
 /**
@@ -113,6 +123,7 @@ static const EnigmaRotor enigma_rotor_V = {
                        12, 21, 9,  20, 3,  10, 6, 8,  0, 17, 15, 7,  1 },
     .notches       = { 25 },
     .notches_count = 1,
+    .turnovers     = 1 << 1,
 };
 
 /**
@@ -129,6 +140,7 @@ static const EnigmaRotor enigma_rotor_VI = {
                        12, 4,  1,  9,  15, 19, 24, 5,  3,  25, 20, 8,  14 },
     .notches       = { 25, 12 },
     .notches_count = 2,
+    .turnovers     = (1 << 6) | (1 << 14),
 };
 
 /**
@@ -145,6 +157,7 @@ static const EnigmaRotor enigma_rotor_VII = {
                        0,  13, 20, 23, 5,  10, 25, 14, 18, 11, 7,  9,  1 },
     .notches       = { 25, 12 },
     .notches_count = 2,
+    .turnovers     = (1 << 1) | (1 << 8),
 };
 
 /**
@@ -161,6 +174,7 @@ static const EnigmaRotor enigma_rotor_VIII = {
                        20, 7, 12, 2,  15, 11, 4,  22, 25, 19, 6, 23, 14 },
     .notches       = { 25, 12 },
     .notches_count = 2,
+    .turnovers     = (1 << 14) | (1 << 17),
 };
 
 // clang-format on
@@ -173,6 +187,8 @@ static const EnigmaRotor* enigma_rotors[]
         &enigma_rotor_V, &enigma_rotor_VI, &enigma_rotor_VII, &enigma_rotor_VIII };
 
 int enigma_rotor_generate_indices(EnigmaRotor*, const char*);
+int enigma_rotor_update_turnovers(EnigmaRotor*);
+int enigma_rotor_id(const EnigmaRotor*);
 
 /* --- EnigmaRotor getters and setters --- */
 const char* enigma_rotor_get_name(const EnigmaRotor*);
@@ -180,6 +196,8 @@ const int*  enigma_rotor_get_fwd_indices(const EnigmaRotor*);
 const int*  enigma_rotor_get_rev_indices(const EnigmaRotor*);
 const int*  enigma_rotor_get_notches(const EnigmaRotor*);
 int         enigma_rotor_get_notches_count(const EnigmaRotor*);
+int         enigma_rotor_get_ring_turnovers(const EnigmaRotor*, int);
+int         enigma_rotor_get_turnovers(const EnigmaRotor*);
 int         enigma_rotor_set_name(EnigmaRotor*, const char*);
 int         enigma_rotor_set_fwd_indices(EnigmaRotor*, const int*);
 int         enigma_rotor_set_rev_indices(EnigmaRotor*, const int*);
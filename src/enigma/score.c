@@ -11,7 +11,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-ENIGMA_STATIC int enigma_score_compare(const void* a, const void* b);
+ENIGMA_STATIC int  enigma_score_compare(const void* a, const void* b);
+ENIGMA_STATIC void enigma_score_heap_down(EnigmaScore*, int, int);
+ENIGMA_STATIC void enigma_score_heap_up(EnigmaScore*, int);
+ENIGMA_STATIC void enigma_score_heapify(EnigmaScore*, int);
 
 /**
  * @brief Print the scores in an EnigmaScoreList.
@@ -23,18 +26,99 @@ EMSCRIPTEN_KEEPALIVE int enigma_score_print(const EnigmaScoreList* list) {
     if (!list) {
         return ENIGMA_FAILURE;
     }
-    char buf[64];
     for (int i = 0; i < list->score_count; i++) {
-        printf("%.6f\t", list->scores[i].score);
-        if (list->scores[i].flags & ENIGMA_FLAG_DICTIONARY_MATCH) {
-            printf("D");
+        enigma_score_fprint(stdout, &list->scores[i]);
+    }
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Print a score to a file, in the format of enigma_score_print().
+ *
+ * @param file The file to print to.
+ * @param score Pointer to the EnigmaScore structure.
+ * @return ENIGMA_SUCCESS on success, or ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_score_fprint(FILE* file, const EnigmaScore* score) {
+    if (!file || !score) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    char buf[64];
+    enigma_print_config(&score->enigma, buf);
+    if (fprintf(file,
+                "%.6f\t%s%s\t%s\n",
+                score->score,
+                score->flags & ENIGMA_FLAG_DICTIONARY_MATCH ? "D" : "",
+                score->flags & ENIGMA_FLAG_FREQUENCY ? "F" : "",
+                buf)
+        < 0) {
+        return ENIGMA_FAILURE;
+    }
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Check whether a score would be kept by an EnigmaScoreList.
+ *
+ * This lets callers skip the work of building an EnigmaScore (e.g. computing its flags) for a
+ * score that a full top-K list would reject. It takes constant time.
+ *
+ * @param list Pointer to the EnigmaScoreList structure.
+ * @param score The score to check.
+ * @return 1 if the score would be kept, 0 if not, or ENIGMA_FAILURE if list is NULL.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_score_list_accepts(const EnigmaScoreList* list, float score) {
+    if (!list) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    // The root of a full heap is the lowest score kept
+    return list->top_k <= 0 || list->score_count < list->top_k || score > list->scores[0].score;
+}
+
+/**
+ * @brief Add a score to an EnigmaScoreList.
+ *
+ * Without a top-K limit, the score is appended, growing the array as needed. With one, the
+ * score replaces the lowest score kept if the list is full, in O(log K) time, and is dropped if
+ * it is not higher than that score.
+ *
+ * @param list Pointer to the EnigmaScoreList structure.
+ * @param score The score to add.
+ * @return ENIGMA_SUCCESS on success (including when the score is dropped), or ENIGMA_FAILURE
+ * on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_score_list_push(EnigmaScoreList* list, const EnigmaScore* score) {
+    if (!list || !score) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    if (list->top_k > 0 && list->score_count >= list->top_k) {
+        if (score->score > list->scores[0].score) {
+            list->scores[0] = *score;
+            enigma_score_heap_down(list->scores, list->score_count, 0);
+        }
+        return ENIGMA_SUCCESS;
+    }
+
+    if (list->score_count >= list->max_scores) {
+        int max = list->max_scores > 0 ? list->max_scores * 2 : 1;
+        if (list->top_k > 0 && max > list->top_k) {
+            max = list->top_k;
         }
-        if (list->scores[i].flags & ENIGMA_FLAG_FREQUENCY) {
-            printf("F");
+
+        EnigmaScore* grown = realloc(list->scores, max * sizeof(EnigmaScore));
+        if (!grown) {
+            return ENIGMA_ERROR("%s", "Failed to grow score list");
         }
-        printf("\t");
-        enigma_print_config(&list->scores[i].enigma, buf);
-        printf("%s\n", buf);
+        list->scores     = grown;
+        list->max_scores = max;
+    }
+
+    list->scores[list->score_count++] = *score;
+    if (list->top_k > 0) {
+        enigma_score_heap_up(list->scores, list->score_count - 1);
     }
     return ENIGMA_SUCCESS;
 }
@@ -42,6 +126,9 @@ EMSCRIPTEN_KEEPALIVE int enigma_score_print(const EnigmaScoreList* list) {
 /**
  * @brief Sort an array of EnigmaScore by score in descending order.
  *
+ * A top-K list is heap-sorted in place, in O(K log K) time. The sorted list is no longer a
+ * heap, so call enigma_score_list_set_top_k() again before adding more scores to it.
+ *
  * @param list The array of EnigmaScore to sort.
  *
  * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
@@ -51,6 +138,19 @@ EMSCRIPTEN_KEEPALIVE int enigma_score_list_sort(EnigmaScoreList* list) {
         return ENIGMA_FAILURE;
     }
 
+    if (list->top_k > 0) {
+        // The list may have been sorted already, so rebuild the heap first. Moving the lowest
+        // score to the back of the shrinking heap then leaves the array in descending order.
+        enigma_score_heapify(list->scores, list->score_count);
+        for (int end = list->score_count - 1; end > 0; end--) {
+            EnigmaScore lowest = list->scores[0];
+            list->scores[0]    = list->scores[end];
+            list->scores[end]  = lowest;
+            enigma_score_heap_down(list->scores, end, 0);
+        }
+        return ENIGMA_SUCCESS;
+    }
+
     qsort(list->scores, list->score_count, sizeof(EnigmaScore), enigma_score_compare);
     return ENIGMA_SUCCESS;
 }
@@ -204,6 +304,21 @@ EMSCRIPTEN_KEEPALIVE int enigma_score_list_get_max_scores(EnigmaScoreList* list)
     return list->max_scores;
 }
 
+/**
+ * @brief Get the top_k field from the given EnigmaScoreList
+ *
+ * @param list The EnigmaScoreList instance
+ * @return int The number of best scores kept, 0 if every score is kept, or ENIGMA_FAILURE if
+ * list is NULL
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_score_list_get_top_k(EnigmaScoreList* list) {
+    if (!list) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    return list->top_k;
+}
+
 /**
  * @brief Set the score at the given index in the given EnigmaScoreList
  *
@@ -254,6 +369,33 @@ EMSCRIPTEN_KEEPALIVE int enigma_score_list_set_max_scores(EnigmaScoreList* list,
     return ENIGMA_SUCCESS;
 }
 
+/**
+ * @brief Set the top_k field in the given EnigmaScoreList
+ *
+ * Scores already in the list are turned into a heap, and all but the best `topK` are dropped.
+ *
+ * @param list The EnigmaScoreList instance
+ * @param topK The number of best scores to keep, or 0 to keep every score
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_score_list_set_top_k(EnigmaScoreList* list, int topK) {
+    if (!list || topK < 0) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    list->top_k = topK;
+    if (topK == 0) {
+        return ENIGMA_SUCCESS;
+    }
+
+    enigma_score_heapify(list->scores, list->score_count);
+    while (list->score_count > topK) {
+        list->scores[0] = list->scores[--list->score_count];
+        enigma_score_heap_down(list->scores, list->score_count, 0);
+    }
+    return ENIGMA_SUCCESS;
+}
+
 /**
  * @brief Compare function for sorting EnigmaScore by score.
  *
@@ -272,3 +414,62 @@ ENIGMA_STATIC int enigma_score_compare(const void* a, const void* b) {
         return 0;
     }
 }
+
+/**
+ * @brief Move a score down a min-heap until its children are not lower.
+ *
+ * @param heap The heap.
+ * @param count The number of scores in the heap.
+ * @param index The index of the score to move.
+ */
+ENIGMA_STATIC void enigma_score_heap_down(EnigmaScore* heap, int count, int index) {
+    EnigmaScore score = heap[index];
+
+    for (;;) {
+        int child = 2 * index + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && heap[child + 1].score < heap[child].score) {
+            child++;
+        }
+        if (heap[child].score >= score.score) {
+            break;
+        }
+        heap[index] = heap[child];
+        index       = child;
+    }
+    heap[index] = score;
+}
+
+/**
+ * @brief Move a score up a min-heap until its parent is not higher.
+ *
+ * @param heap The heap.
+ * @param index The index of the score to move.
+ */
+ENIGMA_STATIC void enigma_score_heap_up(EnigmaScore* heap, int index) {
+    EnigmaScore score = heap[index];
+
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (heap[parent].score <= score.score) {
+            break;
+        }
+        heap[index] = heap[parent];
+        index       = parent;
+    }
+    heap[index] = score;
+}
+
+/**
+ * @brief Turn an array of scores into a min-heap.
+ *
+ * @param heap The scores.
+ * @param count The number of scores.
+ */
+ENIGMA_STATIC void enigma_score_heapify(EnigmaScore* heap, int count) {
+    for (int i = count / 2 - 1; i >= 0; i--) {
+        enigma_score_heap_down(heap, count, i);
+    }
+}
@@ -8,6 +8,8 @@
 
 #include "enigma.h"
 
+#include <stdio.h>
+
 /**
  * @brief Flag indicating that an analyzed configuration should, or does, have at least two dictionary word matches.
  */
@@ -36,14 +38,21 @@ typedef struct {
 /**
  * @struct EnigmaScoreList
  * @brief A structure representing a list of scored Enigma configurations.
+ *
+ * By default every score is kept, in the order it was added. If `top_k` is positive, only the
+ * best `top_k` scores are kept, as a min-heap on the score (see enigma_score_list_set_top_k()).
  */
 typedef struct {
     EnigmaScore* scores; //!< An array of EnigmaScore structs.
     int          score_count; //!< The number of scores in the array.
     int          max_scores; //!< The maximum number of scores that can be stored in the array.
+    int          top_k; //!< The number of best scores to keep, or 0 to keep every score.
 } EnigmaScoreList;
 
 int enigma_score_print(const EnigmaScoreList*);
+int enigma_score_fprint(FILE*, const EnigmaScore*);
+int enigma_score_list_accepts(const EnigmaScoreList*, float);
+int enigma_score_list_push(EnigmaScoreList*, const EnigmaScore*);
 int enigma_score_list_sort(EnigmaScoreList*);
 
 /* --- EnigmaScore getters and setters --- */
@@ -59,8 +68,10 @@ EnigmaScore* enigma_score_list_get_scores(EnigmaScoreList*);
 EnigmaScore* enigma_score_list_get_score(EnigmaScoreList*, int);
 int          enigma_score_list_get_score_count(EnigmaScoreList*);
 int          enigma_score_list_get_max_scores(EnigmaScoreList*);
+int          enigma_score_list_get_top_k(EnigmaScoreList*);
 int          enigma_score_list_set_score(EnigmaScoreList*, int, EnigmaScore*);
 int          enigma_score_list_set_score_count(EnigmaScoreList*, int);
 int          enigma_score_list_set_max_scores(EnigmaScoreList*, int);
+int          enigma_score_list_set_top_k(EnigmaScoreList*, int);
 
 #endif
@@ -0,0 +1,188 @@
+/**
+ * @file enigma/sink.c
+ *
+ * This file implements result sinks for the crack functions.
+ *
+ * Every write locks the sink's mutex, so a sink can be shared by the workers of an executor and
+ * its function never runs on two threads at once. Writes only happen for kept scores, which are
+ * rare compared to the candidates decoded, so the lock is not contended in practice.
+ */
+#include "sink.h"
+
+#include "common.h"
+#include "io.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+ENIGMA_STATIC int enigma_sink_file(EnigmaSink*, const EnigmaScore*);
+ENIGMA_STATIC int enigma_sink_top_k(EnigmaSink*, const EnigmaScore*);
+
+/**
+ * @brief Create a sink that calls a function with each score.
+ *
+ * @param func The function to call with each score, or NULL to only count the scores.
+ * @param data User data for the function (see enigma_sink_get_data()).
+ * @return Pointer to the new sink, or NULL on failure.
+ */
+EMSCRIPTEN_KEEPALIVE EnigmaSink* enigma_sink_new(EnigmaSinkFunc func, void* data) {
+    EnigmaSink* sink = calloc(1, sizeof(EnigmaSink));
+    if (!sink) {
+        ENIGMA_ERROR("%s", "Failed to allocate sink");
+        return NULL;
+    }
+
+    sink->func = func;
+    sink->data = data;
+    pthread_mutex_init(&sink->mutex, NULL);
+    return sink;
+}
+
+/**
+ * @brief Create a sink that only counts the scores (see enigma_sink_get_count()).
+ *
+ * @return Pointer to the new sink, or NULL on failure.
+ */
+EMSCRIPTEN_KEEPALIVE EnigmaSink* enigma_sink_new_count(void) { return enigma_sink_new(NULL, NULL); }
+
+/**
+ * @brief Create a sink that prints the scores to a file as they are found.
+ *
+ * Scores are printed in the format of enigma_score_print(). The file is not closed when the
+ * sink is freed.
+ *
+ * @param file The file to print to.
+ * @param minScore Scores below this are counted but not printed.
+ * @return Pointer to the new sink, or NULL on failure.
+ */
+EMSCRIPTEN_KEEPALIVE EnigmaSink* enigma_sink_new_file(FILE* file, float minScore) {
+    if (!file) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return NULL;
+    }
+
+    EnigmaSink* sink = enigma_sink_new(enigma_sink_file, NULL);
+    if (sink) {
+        sink->file      = file;
+        sink->min_score = minScore;
+    }
+    return sink;
+}
+
+/**
+ * @brief Create a sink that keeps the best scores in a score list.
+ *
+ * The list is made a top-K list (see enigma_score_list_set_top_k()), so its memory stays
+ * bounded however many scores are written. It is not freed when the sink is freed.
+ *
+ * @param list The list to keep the scores in.
+ * @param k The number of best scores to keep (at least 1).
+ * @return Pointer to the new sink, or NULL on failure.
+ */
+EMSCRIPTEN_KEEPALIVE EnigmaSink* enigma_sink_new_top_k(EnigmaScoreList* list, int k) {
+    if (!list || k < 1 || enigma_score_list_set_top_k(list, k)) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return NULL;
+    }
+
+    EnigmaSink* sink = enigma_sink_new(enigma_sink_top_k, NULL);
+    if (sink) {
+        sink->score_list = list;
+    }
+    return sink;
+}
+
+/**
+ * @brief Free a sink.
+ *
+ * @param sink The sink to free.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_sink_free(EnigmaSink* sink) {
+    if (!sink) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    pthread_mutex_destroy(&sink->mutex);
+    free(sink);
+    return ENIGMA_SUCCESS;
+}
+
+/**
+ * @brief Write a score to a sink.
+ *
+ * This is safe to call from several threads at once.
+ *
+ * @param sink The sink to write to.
+ * @param score The score to write.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+EMSCRIPTEN_KEEPALIVE int enigma_sink_write(EnigmaSink* sink, const EnigmaScore* score) {
+    if (!sink || !score) {
+        return ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+    }
+
+    int ret = ENIGMA_SUCCESS;
+    pthread_mutex_lock(&sink->mutex);
+    sink->count++;
+    if (sink->func) {
+        ret = sink->func(sink, score);
+    }
+    pthread_mutex_unlock(&sink->mutex);
+    return ret;
+}
+
+/**
+ * @brief Get the number of scores written to a sink.
+ *
+ * @param sink The sink.
+ * @return The number of scores, or 0 if sink is NULL.
+ */
+EMSCRIPTEN_KEEPALIVE unsigned long enigma_sink_get_count(const EnigmaSink* sink) {
+    if (!sink) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return 0;
+    }
+
+    return sink->count;
+}
+
+/**
+ * @brief Get the user data of a sink.
+ *
+ * @param sink The sink.
+ * @return The user data passed to enigma_sink_new(), or NULL if sink is NULL.
+ */
+EMSCRIPTEN_KEEPALIVE void* enigma_sink_get_data(const EnigmaSink* sink) {
+    if (!sink) {
+        ENIGMA_ERROR("%s", enigma_invalid_argument_message);
+        return NULL;
+    }
+
+    return sink->data;
+}
+
+/**
+ * @brief Print a score to the file of a file sink, if it reaches the sink's minimum score.
+ *
+ * @param sink The file sink.
+ * @param score The score to print.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+ENIGMA_STATIC int enigma_sink_file(EnigmaSink* sink, const EnigmaScore* score) {
+    if (score->score < sink->min_score) {
+        return ENIGMA_SUCCESS;
+    }
+    return enigma_score_fprint(sink->file, score);
+}
+
+/**
+ * @brief Add a score to the list of a top-K sink.
+ *
+ * @param sink The top-K sink.
+ * @param score The score to add.
+ * @return ENIGMA_SUCCESS on success, ENIGMA_FAILURE on failure.
+ */
+ENIGMA_STATIC int enigma_sink_top_k(EnigmaSink* sink, const EnigmaScore* score) {
+    return enigma_score_list_push(sink->score_list, score);
+}
@@ -0,0 +1,55 @@
+/**
+ * @file enigma/sink.h
+ *
+ * This file declares result sinks, which receive the scores of the crack functions as they are
+ * found instead of storing them in a score list.
+ */
+#ifndef ENIGMA_SINK_H
+#define ENIGMA_SINK_H
+
+#include "score.h"
+
+#include <pthread.h>
+#include <stdio.h>
+
+struct EnigmaSink_s;
+
+/**
+ * @brief A function called with each score written to a sink.
+ *
+ * Calls are serialized by the sink, so the function does not need to be thread-safe. It should
+ * return ENIGMA_SUCCESS, or ENIGMA_FAILURE to make the crack function report a failure.
+ */
+typedef int (*EnigmaSinkFunc)(struct EnigmaSink_s*, const EnigmaScore*);
+
+/**
+ * @struct EnigmaSink
+ * @brief A destination for the scores of the crack functions.
+ *
+ * Scores are written to the sink as soon as a worker keeps them, so with an executor they
+ * arrive in no particular order. The built-in sinks count the scores (enigma_sink_new_count()),
+ * keep the best of them (enigma_sink_new_top_k()), or print them to a file
+ * (enigma_sink_new_file()).
+ */
+typedef struct EnigmaSink_s {
+    EnigmaSinkFunc   func; //!< Called with each score, or NULL to only count the scores.
+    void*            data; //!< User data for `func`.
+    pthread_mutex_t  mutex; //!< Serializes writes from the workers of an executor.
+    unsigned long    count; //!< Number of scores written to the sink.
+    EnigmaScoreList* score_list; //!< Score list of a top-K sink.
+    FILE*            file; //!< File of a file sink.
+    float            min_score; //!< Scores below this are not printed by a file sink.
+} EnigmaSink;
+
+EnigmaSink* enigma_sink_new(EnigmaSinkFunc, void*);
+EnigmaSink* enigma_sink_new_count(void);
+EnigmaSink* enigma_sink_new_file(FILE*, float);
+EnigmaSink* enigma_sink_new_top_k(EnigmaScoreList*, int);
+int         enigma_sink_free(EnigmaSink*);
+int         enigma_sink_write(EnigmaSink*, const EnigmaScore*);
+
+/* --- EnigmaSink getters --- */
+unsigned long enigma_sink_get_count(const EnigmaSink*);
+void*         enigma_sink_get_data(const EnigmaSink*);
+
+#endif
@@ -0,0 +1,231 @@
+#include "enigma/batch.h"
+#include "enigma/common.h"
+#include "enigma/enigma.h"
+#include "unity.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define CONFIG_COUNT 19
+
+const char* success = "Expected success";
+const char* failure = "Expected failure";
+
+Enigma      enigmas[CONFIG_COUNT];
+uint8_t     input[300];
+
+void        setUp(void) {
+    const char* plugboards[] = { "", "AB", "HXEQ", "ZYXWVUTSRQ", "MNOPQRSTUVWXYZABCDEF" };
+
+    for (int n = 0; n < CONFIG_COUNT; n++) {
+        enigma_init_default_config(&enigmas[n]);
+        // Mix three- and four-rotor machines, with positions near the notches
+        enigma_set_rotor_count(&enigmas[n], n % 3 ? 3 : 4);
+        for (int r = 0; r < enigmas[n].rotor_count; r++) {
+            enigma_set_rotor(&enigmas[n], (n + r * 3) % ENIGMA_ROTOR_COUNT, r);
+            enigma_set_rotor_index(&enigmas[n], r, (n * 7 + r * 11) % ENIGMA_ALPHA_SIZE);
+        }
+        enigma_set_reflector(&enigmas[n], n % ENIGMA_REFLECTOR_COUNT);
+        enigma_set_plugboard(&enigmas[n], plugboards[n % 5]);
+    }
+
+    for (size_t i = 0; i < sizeof(input); i++) {
+        input[i] = (i * 17 + i / 5) % ENIGMA_ALPHA_SIZE;
+    }
+}
+
+void tearDown(void) { enigma_batch_set_engine(ENIGMA_BATCH_ENGINE_AUTO); }
+
+/**
+ * Encode `input` under every configuration with the given engine, with ring settings on every
+ * other configuration, and compare the output and the final rotor positions with
+ * enigma_encode_indices().
+ */
+static void assert_engine_matches(int engine, const char* name) {
+    Enigma   expected[CONFIG_COUNT];
+    uint8_t  expectedOutput[sizeof(input)];
+    uint8_t* output = malloc(CONFIG_COUNT * sizeof(input));
+
+    if (enigma_batch_set_engine(engine) != ENIGMA_SUCCESS) {
+        free(output);
+        TEST_IGNORE_MESSAGE(name);
+    }
+    if (engine != ENIGMA_BATCH_ENGINE_AUTO) {
+        TEST_ASSERT_EQUAL_INT_MESSAGE(
+            engine, enigma_batch_get_engine(), "Expected engine to be set");
+    }
+
+    for (int n = 1; n < CONFIG_COUNT; n += 2) {
+        for (int r = 0; r < enigmas[n].rotor_count; r++) {
+            enigma_set_ring_setting(&enigmas[n], r, (n * 3 + r * 7) % ENIGMA_ALPHA_SIZE);
+        }
+    }
+
+    memcpy(expected, enigmas, sizeof(enigmas));
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS,
+        enigma_batch_encode_indices(enigmas, CONFIG_COUNT, input, output, sizeof(input)),
+        success);
+
+    for (int n = 0; n < CONFIG_COUNT; n++) {
+        enigma_encode_indices(&expected[n], input, expectedOutput, sizeof(input));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(expectedOutput,
+                                              output + n * sizeof(input),
+                                              sizeof(input),
+                                              "Expected output to match enigma_encode_indices()");
+        TEST_ASSERT_EQUAL_INT_ARRAY_MESSAGE(expected[n].rotor_indices,
+                                            enigmas[n].rotor_indices,
+                                            4,
+                                            "Expected rotor indices to match");
+    }
+
+    free(output);
+}
+
+void test_enigma_batch_encode_indices(void) {
+    Enigma   expected[CONFIG_COUNT];
+    uint8_t  expectedOutput[sizeof(input)];
+    uint8_t* output = malloc(CONFIG_COUNT * sizeof(input));
+
+    memcpy(expected, enigmas, sizeof(enigmas));
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS,
+        enigma_batch_encode_indices(enigmas, CONFIG_COUNT, input, output, sizeof(input)),
+        success);
+
+    for (int n = 0; n < CONFIG_COUNT; n++) {
+        enigma_encode_indices(&expected[n], input, expectedOutput, sizeof(input));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(expectedOutput,
+                                              output + n * sizeof(input),
+                                              sizeof(input),
+                                              "Expected output to match enigma_encode_indices()");
+        TEST_ASSERT_EQUAL_INT_ARRAY_MESSAGE(expected[n].rotor_indices,
+                                            enigmas[n].rotor_indices,
+                                            4,
+                                            "Expected rotor indices to match");
+    }
+
+    free(output);
+}
+
+void test_enigma_batch_encode_indices_WithSingleConfig(void) {
+    Enigma  expected = enigmas[0];
+    uint8_t expectedOutput[sizeof(input)];
+    uint8_t output[sizeof(input)];
+
+    int ret = enigma_batch_encode_indices(enigmas, 1, input, output, sizeof(input));
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, ret, success);
+    enigma_encode_indices(&expected, input, expectedOutput, sizeof(input));
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(
+        expectedOutput, output, sizeof(input), "Expected output to match enigma_encode_indices()");
+}
+
+void test_enigma_batch_encode_indices_WithRingSettings(void) {
+    Enigma   expected[CONFIG_COUNT];
+    uint8_t  expectedOutput[sizeof(input)];
+    uint8_t* output = malloc(CONFIG_COUNT * sizeof(input));
+
+    for (int n = 0; n < CONFIG_COUNT; n++) {
+        for (int r = 0; r < enigmas[n].rotor_count; r++) {
+            enigma_set_ring_setting(&enigmas[n], r, (n * 5 + r * 9) % ENIGMA_ALPHA_SIZE);
+        }
+    }
+
+    memcpy(expected, enigmas, sizeof(enigmas));
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS,
+        enigma_batch_encode_indices(enigmas, CONFIG_COUNT, input, output, sizeof(input)),
+        success);
+
+    for (int n = 0; n < CONFIG_COUNT; n++) {
+        enigma_encode_indices(&expected[n], input, expectedOutput, sizeof(input));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(expectedOutput,
+                                              output + n * sizeof(input),
+                                              sizeof(input),
+                                              "Expected output to match enigma_encode_indices()");
+        TEST_ASSERT_EQUAL_INT_ARRAY_MESSAGE(expected[n].rotor_indices,
+                                            enigmas[n].rotor_indices,
+                                            4,
+                                            "Expected rotor indices to match");
+    }
+
+    free(output);
+}
+
+void test_enigma_batch_encode_indices_WithCustomRotors(void) {
+    EnigmaRotor custom = enigma_rotor_I;
+
+    // Every third configuration has no rotor-order kernel, so the others are encoded apart
+    custom.fwd_indices[0]                     = enigma_rotor_I.fwd_indices[1];
+    custom.fwd_indices[1]                     = enigma_rotor_I.fwd_indices[0];
+    custom.rev_indices[custom.fwd_indices[0]] = 0;
+    custom.rev_indices[custom.fwd_indices[1]] = 1;
+    for (int n = 0; n < CONFIG_COUNT; n += 3) {
+        enigmas[n].rotors[1] = &custom;
+    }
+
+    assert_engine_matches(ENIGMA_BATCH_ENGINE_AUTO, "");
+}
+
+void test_enigma_batch_encode_indices_WithScalarEngine(void) {
+    assert_engine_matches(ENIGMA_BATCH_ENGINE_SCALAR, "Scalar engine not supported");
+}
+
+void test_enigma_batch_encode_indices_WithSSE41Engine(void) {
+    assert_engine_matches(ENIGMA_BATCH_ENGINE_SSE41, "SSE4.1 not supported");
+}
+
+void test_enigma_batch_encode_indices_WithAVX2Engine(void) {
+    assert_engine_matches(ENIGMA_BATCH_ENGINE_AVX2, "AVX2 not supported");
+}
+
+void test_enigma_batch_encode_indices_WithInvalidArguments(void) {
+    uint8_t output[CONFIG_COUNT * 4];
+    uint8_t invalid[4] = { 0, 1, ENIGMA_ALPHA_SIZE, 2 };
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_batch_encode_indices(NULL, 1, input, output, 4), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_batch_encode_indices(enigmas, 0, input, output, 4), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_batch_encode_indices(enigmas, 1, NULL, output, 4), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_batch_encode_indices(enigmas, 1, input, NULL, 4), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_batch_encode_indices(enigmas, 1, input, output, 0), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_batch_encode_indices(enigmas, 1, invalid, output, 4), failure);
+
+    enigmas[2].reflector = NULL;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_batch_encode_indices(enigmas, 3, input, output, 4), failure);
+}
+
+void test_enigma_batch_set_engine(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS, enigma_batch_set_engine(ENIGMA_BATCH_ENGINE_AUTO), success);
+    TEST_ASSERT_NOT_EQUAL_INT_MESSAGE(ENIGMA_BATCH_ENGINE_AUTO,
+                                      enigma_batch_get_engine(),
+                                      "Expected the automatic engine to be resolved");
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS, enigma_batch_set_engine(ENIGMA_BATCH_ENGINE_SCALAR), success);
+    TEST_ASSERT_EQUAL_INT(ENIGMA_BATCH_ENGINE_SCALAR, enigma_batch_get_engine());
+}
+
+void test_enigma_batch_set_engine_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_batch_set_engine(-1), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_batch_set_engine(4), failure);
+}
+
+void test_enigma_batch_width(void) {
+    int width = enigma_batch_width();
+    TEST_ASSERT_TRUE_MESSAGE(width == 1 || width == ENIGMA_BATCH_LANES,
+                             "Expected batch width to be 1 or ENIGMA_BATCH_LANES");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(enigma_batch_get_engine() == ENIGMA_BATCH_ENGINE_AVX2
+                                      ? ENIGMA_BATCH_LANES
+                                      : 1,
+                                  width,
+                                  "Expected only the AVX2 engine to group configurations");
+}
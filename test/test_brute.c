@@ -68,3 +68,47 @@ void test_enigma_brute_score_WithNonMatchingPlaintext_Not_X_Separated(void) {
                                     "Expected dictionary not to match");
     free(cfg.dictionary);
 }
+
+void test_enigma_brute_score_indices(void) {
+    const char* plaintext = "HELLOXWORLDXFOOXBAR";
+    const char* dictStr   = "BAR\nBAZ\nFOO\nGOODBYE\nHELLO\nTEST\nWORLD";
+    uint8_t     indices[19];
+    cfg.ciphertext_length = strlen(plaintext);
+    enigma_text_to_indices(plaintext, indices, cfg.ciphertext_length);
+
+    int ret = enigma_load_dict_s(&cfg, dictStr, strlen(dictStr));
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, ret, "Expected enigma_load_dict_s to succeed");
+
+    TEST_ASSERT_EQUAL_FLOAT_MESSAGE(1.0,
+                                    enigma_brute_score_indices(&cfg, indices),
+                                    "Expected dictionary to match");
+
+    cfg.flags |= ENIGMA_FLAG_X_SEPARATED;
+    TEST_ASSERT_EQUAL_FLOAT_MESSAGE(1.0,
+                                    enigma_brute_score_indices(&cfg, indices),
+                                    "Expected dictionary to match");
+    free(cfg.dictionary);
+}
+
+void test_enigma_brute_score_batch(void) {
+    const char* texts[]  = { "HELLOXWORLDXFOOXBAR", "XQZJVKWPLMNBCDFGHTR", "GOODBYEXTESTXBAZXAB" };
+    const char* dictStr  = "BAR\nBAZ\nFOO\nGOODBYE\nHELLO\nTEST\nWORLD";
+    uint8_t     indices[3 * 19];
+    float       scores[3];
+    cfg.ciphertext_length = 19;
+    for (int i = 0; i < 3; i++) {
+        enigma_text_to_indices(texts[i], indices + i * 19, 19);
+    }
+
+    int ret = enigma_load_dict_s(&cfg, dictStr, strlen(dictStr));
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, ret, "Expected enigma_load_dict_s to succeed");
+
+    enigma_brute_score_batch(&cfg, indices, 3, scores);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_FLOAT_MESSAGE(enigma_brute_score_indices(&cfg, indices + i * 19),
+                                        scores[i],
+                                        "Expected brute force scores to be equal");
+    }
+    TEST_ASSERT_EQUAL_FLOAT_MESSAGE(0.0, scores[1], "Expected dictionary not to match");
+    free(cfg.dictionary);
+}
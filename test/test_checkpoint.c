@@ -0,0 +1,180 @@
+#include "enigma/checkpoint.h"
+#include "enigma/common.h"
+#include "enigma/enigma.h"
+#include "enigma/score.h"
+#include "unity.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECKPOINT_PATH "checkpoint_test.bin"
+#define RANGE_COUNT     10
+#define FINGERPRINT     0x1234u
+
+const char*       success = "Expected success";
+const char*       failure = "Expected failure";
+
+EnigmaCheckpoint* checkpoint;
+EnigmaScoreList   scores;
+
+void              setUp(void) {
+    checkpoint = enigma_checkpoint_new(CHECKPOINT_PATH, 0);
+    memset(&scores, 0, sizeof(EnigmaScoreList));
+}
+
+void tearDown(void) {
+    enigma_checkpoint_free(checkpoint);
+    free(scores.scores);
+    remove(CHECKPOINT_PATH);
+}
+
+static void add_score(float value) {
+    EnigmaScore score = { 0 };
+    enigma_init_default_config(&score.enigma);
+    score.enigma.rotor_indices[0] = (int) value % 26;
+    score.score                   = value;
+    enigma_score_list_push(&scores, &score);
+}
+
+void test_enigma_checkpoint_new_WithInvalidArguments(void) {
+    TEST_ASSERT_NULL(enigma_checkpoint_new(NULL, 0));
+    TEST_ASSERT_NULL(enigma_checkpoint_new(CHECKPOINT_PATH, -1));
+}
+
+void test_enigma_checkpoint_begin(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS, enigma_checkpoint_begin(checkpoint, FINGERPRINT, 95, 10, 0), success);
+    TEST_ASSERT_EQUAL_size_t(RANGE_COUNT, enigma_checkpoint_get_range_count(checkpoint));
+    TEST_ASSERT_EQUAL_size_t(0, enigma_checkpoint_get_done_count(checkpoint));
+
+    // The same search can begin again, a different one cannot, even with the same size
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS, enigma_checkpoint_begin(checkpoint, FINGERPRINT, 95, 10, 0), success);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_checkpoint_begin(checkpoint, FINGERPRINT, 100, 10, 0), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_checkpoint_begin(checkpoint, FINGERPRINT + 1, 95, 10, 0), failure);
+}
+
+void test_enigma_checkpoint_begin_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_checkpoint_begin(NULL, FINGERPRINT, 100, 10, 0), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_checkpoint_begin(checkpoint, FINGERPRINT, 100, 0, 0), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_checkpoint_begin(checkpoint, FINGERPRINT, 100, 10, -1), failure);
+}
+
+void test_enigma_checkpoint_complete(void) {
+    enigma_checkpoint_begin(checkpoint, FINGERPRINT, 100, 10, 0);
+    add_score(1.0f);
+    add_score(2.0f);
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS, enigma_checkpoint_complete(checkpoint, 3, &scores), success);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, scores.score_count, "Expected the scores to be moved");
+    TEST_ASSERT_EQUAL_INT(2, enigma_checkpoint_get_scores(checkpoint)->score_count);
+    TEST_ASSERT_EQUAL_INT(1, enigma_checkpoint_is_done(checkpoint, 3));
+    TEST_ASSERT_EQUAL_INT(0, enigma_checkpoint_is_done(checkpoint, 4));
+    TEST_ASSERT_EQUAL_size_t(1, enigma_checkpoint_get_done_count(checkpoint));
+}
+
+void test_enigma_checkpoint_complete_WithTopK(void) {
+    enigma_checkpoint_begin(checkpoint, FINGERPRINT, 100, 10, 2);
+    for (int i = 0; i < RANGE_COUNT; i++) {
+        add_score((float) i);
+        enigma_checkpoint_complete(checkpoint, i, &scores);
+    }
+
+    EnigmaScoreList* kept = (EnigmaScoreList*) enigma_checkpoint_get_scores(checkpoint);
+    TEST_ASSERT_EQUAL_INT(2, kept->score_count);
+    enigma_score_list_sort(kept);
+    TEST_ASSERT_EQUAL_FLOAT(9.0f, kept->scores[0].score);
+    TEST_ASSERT_EQUAL_FLOAT(8.0f, kept->scores[1].score);
+    TEST_ASSERT_EQUAL_size_t(RANGE_COUNT, enigma_checkpoint_get_done_count(checkpoint));
+}
+
+void test_enigma_checkpoint_complete_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_checkpoint_complete(checkpoint, 0, &scores), failure);
+
+    enigma_checkpoint_begin(checkpoint, FINGERPRINT, 100, 10, 0);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_checkpoint_complete(NULL, 0, &scores), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_checkpoint_complete(checkpoint, 0, NULL), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_checkpoint_complete(checkpoint, RANGE_COUNT, &scores), failure);
+}
+
+void test_enigma_checkpoint_is_done_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_checkpoint_is_done(checkpoint, 0), failure);
+
+    enigma_checkpoint_begin(checkpoint, FINGERPRINT, 100, 10, 0);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_checkpoint_is_done(NULL, 0), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_checkpoint_is_done(checkpoint, RANGE_COUNT), failure);
+}
+
+void test_enigma_checkpoint_load(void) {
+    enigma_checkpoint_begin(checkpoint, FINGERPRINT, 95, 10, 3);
+    for (int i = 0; i < 4; i++) {
+        add_score((float) i);
+        enigma_checkpoint_complete(checkpoint, i * 2, &scores);
+    }
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, enigma_checkpoint_save(checkpoint), success);
+
+    EnigmaCheckpoint* loaded = enigma_checkpoint_load(CHECKPOINT_PATH, 0);
+    TEST_ASSERT_NOT_NULL(loaded);
+    TEST_ASSERT_EQUAL_size_t(RANGE_COUNT, enigma_checkpoint_get_range_count(loaded));
+    TEST_ASSERT_EQUAL_size_t(4, enigma_checkpoint_get_done_count(loaded));
+    for (int i = 0; i < RANGE_COUNT; i++) {
+        TEST_ASSERT_EQUAL_INT(i % 2 == 0 && i < 8, enigma_checkpoint_is_done(loaded, i));
+    }
+
+    // The best scores and their configurations are restored
+    EnigmaScoreList* kept = (EnigmaScoreList*) enigma_checkpoint_get_scores(loaded);
+    TEST_ASSERT_EQUAL_INT(3, kept->top_k);
+    TEST_ASSERT_EQUAL_INT(3, kept->score_count);
+    enigma_score_list_sort(kept);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_FLOAT((float) (3 - i), kept->scores[i].score);
+        TEST_ASSERT_EQUAL_INT(3 - i, kept->scores[i].enigma.rotor_indices[0]);
+    }
+
+    // A loaded checkpoint only resumes the search it was saved from
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_checkpoint_begin(loaded, FINGERPRINT, 100, 10, 3), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_checkpoint_begin(loaded, FINGERPRINT + 1, 95, 10, 3), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS, enigma_checkpoint_begin(loaded, FINGERPRINT, 95, 10, 3), success);
+    enigma_checkpoint_free(loaded);
+}
+
+void test_enigma_checkpoint_load_WithInvalidFile(void) {
+    FILE* file = fopen(CHECKPOINT_PATH, "wb");
+    fputs("not a checkpoint", file);
+    fclose(file);
+
+    TEST_ASSERT_NULL(enigma_checkpoint_load(CHECKPOINT_PATH, 0));
+    remove(CHECKPOINT_PATH);
+    TEST_ASSERT_NULL(enigma_checkpoint_load(CHECKPOINT_PATH, 0));
+}
+
+void test_enigma_checkpoint_save_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_checkpoint_save(NULL), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_checkpoint_save(checkpoint), failure);
+}
+
+void test_enigma_checkpoint_free_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_checkpoint_free(NULL), failure);
+}
+
+void test_enigma_checkpoint_get_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_size_t(0, enigma_checkpoint_get_done_count(NULL));
+    TEST_ASSERT_EQUAL_size_t(0, enigma_checkpoint_get_range_count(NULL));
+    TEST_ASSERT_NULL(enigma_checkpoint_get_scores(NULL));
+}
@@ -1,12 +1,20 @@
 #include "enigma/common.h"
 #include "enigma/crack.h"
 #include "enigma/enigma.h"
+#include "enigma/executor.h"
 #include "enigma/io.h"
+#include "enigma/ioc.h"
+#include "enigma/ngram.h"
+#include "enigma/progress.h"
 #include "enigma/reflector.h"
 #include "enigma/rotor.h"
 #include "enigma/score.h"
+#include "enigma/sink.h"
 #include "unity.h"
 
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -38,6 +46,7 @@ void              setUp(void) {
     cfg.score_list              = &scores;
     cfg.score_list->max_scores  = 100;
     cfg.score_list->score_count = 0;
+    cfg.score_list->top_k       = 0;
     cfg.score_list->scores      = calloc(100, sizeof(EnigmaScore));
     memset(storedScores, 0, MAX_STORED_SCORES * sizeof(float));
 }
@@ -252,6 +261,211 @@ void test_enigma_crack_params_validate_WherePlugboardIsNotDefined(void) {
     TEST_ASSERT_EQUAL(0, ret & ENIGMA_PLUGBOARD_DEFINED);
 }
 
+const char* autoPlaintext =
+    "ITWASTHEBESTOFTIMESITWASTHEWORSTOFTIMESITWASTHEAGEOFWISDOMITWASTHEAGEOFFOOLISHNESS"
+    "ITWASTHEEPOCHOFBELIEFITWASTHEEPOCHOFINCREDULITYITWASTHESEASONOFLIGHTITWASTHESEASON"
+    "OFDARKNESSITWASTHESPRINGOFHOPEITWASTHEWINTEROFDESPAIRWEHADEVERYTHINGBEFOREUSWEHAD"
+    "NOTHINGBEFOREUSWEWEREALLGOINGDIRECTTOHEAVENWEWEREALLGOINGDIRECTTHEOTHERWAYINSHORT"
+    "THEPERIODWASSOFARLIKETHEPRESENTPERIODTHATSOMEOFITSNOISIESTAUTHORITIESINSISTEDONITS"
+    "BEINGRECEIVEDFORGOODORFOREVILINTHESUPERLATIVEDEGREEOFCOMPARISONONLY";
+
+/**
+ * Encrypt autoPlaintext with the default rotors and reflector at the given positions and
+ * plugboard, and point cfg at the ciphertext.
+ */
+static char* auto_encrypt(int left, int middle, int right, const char* plugboard) {
+    size_t length = strlen(autoPlaintext);
+    char*  text   = malloc(length + 1);
+    Enigma enigma;
+
+    enigma_init_default_config(&enigma);
+    enigma.rotor_indices[2] = left;
+    enigma.rotor_indices[1] = middle;
+    enigma.rotor_indices[0] = right;
+    enigma_set_plugboard(&enigma, plugboard);
+    enigma_encode_string(&enigma, autoPlaintext, text, length);
+    text[length] = '\0';
+
+    cfg.ciphertext        = text;
+    cfg.ciphertext_length = length;
+    return text;
+}
+
+void test_enigma_crack_auto_WithRotorPositionsAndReflectorNotDefined(void) {
+    char* text = auto_encrypt(7, 19, 3, "");
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS,
+        enigma_crack_auto(&cfg, ENIGMA_ROTORS_DEFINED | ENIGMA_PLUGBOARD_DEFINED, 3),
+        success);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(3, scores.score_count, "Expected one score per survivor");
+
+    enigma_score_list_sort(&scores);
+    Enigma* best = &scores.scores[0].enigma;
+    TEST_ASSERT_EQUAL_INT(7, best->rotor_indices[2]);
+    TEST_ASSERT_EQUAL_INT(19, best->rotor_indices[1]);
+    TEST_ASSERT_EQUAL_INT(3, best->rotor_indices[0]);
+    TEST_ASSERT_EQUAL_STRING("B", best->reflector->name);
+    free(text);
+}
+
+void test_enigma_crack_auto_WithPlugboardNotDefined(void) {
+    char*  text   = auto_encrypt(0, 0, 0, "AQEMTZ");
+    size_t length = strlen(autoPlaintext);
+    float  bigrams[ENIGMA_BIIDX(25, 25) + 1];
+
+    // Score bigrams by their log frequency in the plaintext itself
+    for (size_t i = 0; i < sizeof(bigrams) / sizeof(bigrams[0]); i++) {
+        bigrams[i] = 0.0f;
+    }
+    for (size_t i = 1; i < length; i++) {
+        int prev = autoPlaintext[i - 1] - 'A';
+        int cur  = autoPlaintext[i] - 'A';
+        bigrams[ENIGMA_BIIDX(prev, cur)] += 1.0f;
+    }
+    for (size_t i = 0; i < sizeof(bigrams) / sizeof(bigrams[0]); i++) {
+        bigrams[i] = logf((bigrams[i] + 0.1f) / length);
+    }
+    cfg.ngrams        = bigrams;
+    cfg.n             = 2;
+    cfg.ngrams_length = sizeof(bigrams) / sizeof(bigrams[0]);
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS,
+        enigma_crack_auto(&cfg,
+                          ENIGMA_ROTORS_DEFINED | ENIGMA_ROTOR_POSITIONS_DEFINED
+                              | ENIGMA_REFLECTOR_DEFINED,
+                          ENIGMA_CRACK_BEAM_WIDTH),
+        success);
+    TEST_ASSERT_TRUE(scores.score_count > 0);
+
+    // The pairs may be found in any order, so the best plugboard is checked by decoding
+    enigma_score_list_sort(&scores);
+    Enigma best      = scores.scores[0].enigma;
+    char*  plaintext = malloc(length + 1);
+    enigma_encode_string(&best, text, plaintext, length);
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(
+        autoPlaintext, plaintext, length, "Expected the plaintext to be recovered");
+    TEST_ASSERT_EQUAL_size_t(6, strlen(best.plugboard));
+
+    free(plaintext);
+    free(text);
+}
+
+void test_enigma_crack_auto_WithInvalidArguments(void) {
+    EnigmaCheckpoint checkpoint;
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_crack_auto(NULL, 0, 1), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_crack_auto(&cfg, 0, 0), failure);
+
+    cfg.checkpoint = &checkpoint;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_crack_auto(&cfg, 0, 1), failure);
+    cfg.checkpoint  = NULL;
+    cfg.shard_count = 2;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_crack_auto(&cfg, 0, 1), failure);
+    cfg.shard_count = 0;
+    cfg.score_list  = NULL;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_crack_auto(&cfg, 0, 1), failure);
+    cfg.score_list = &scores;
+}
+
+void test_enigma_crack_beam_WithSeeds(void) {
+    char*           text        = auto_encrypt(7, 19, 3, "");
+    EnigmaScoreList seeds       = { 0 };
+    EnigmaScore     seed        = { 0 };
+    char            orders[][9] = { "II I III", "I II III", "III II I" };
+
+    // Only one of the rotor orders is right
+    for (int i = 0; i < 3; i++) {
+        enigma_init_default_config(&seed.enigma);
+        enigma_load_rotor_config(&seed.enigma, orders[i]);
+        enigma_score_list_push(&seeds, &seed);
+    }
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS,
+        enigma_crack_beam(&cfg, &seeds, 4, enigma_crack_rotor_positions, enigma_ioc_score),
+        success);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(4, scores.score_count, "Expected the beam width");
+    for (int i = 1; i < scores.score_count; i++) {
+        TEST_ASSERT_TRUE_MESSAGE(scores.scores[i - 1].score >= scores.scores[i].score,
+                                 "Expected the best score first");
+    }
+
+    Enigma* best = &scores.scores[0].enigma;
+    TEST_ASSERT_EQUAL_STRING("I", best->rotors[2]->name);
+    TEST_ASSERT_EQUAL_STRING("II", best->rotors[1]->name);
+    TEST_ASSERT_EQUAL_STRING("III", best->rotors[0]->name);
+    TEST_ASSERT_EQUAL_INT(7, best->rotor_indices[2]);
+    TEST_ASSERT_EQUAL_INT(19, best->rotor_indices[1]);
+    TEST_ASSERT_EQUAL_INT(3, best->rotor_indices[0]);
+
+    free(seeds.scores);
+    free(text);
+}
+
+void test_enigma_crack_beam_WithDuplicateSeeds(void) {
+    EnigmaExecutor* executor = enigma_executor_new(4);
+    EnigmaScoreList seeds    = { 0 };
+    EnigmaScore     seed     = { .enigma = cfg.enigma };
+    EnigmaKey       keys[5];
+
+    // Seeds differing only in the rotor positions find the same candidates
+    cfg.ciphertext        = alphaText;
+    cfg.ciphertext_length = strlen(alphaText);
+    cfg.executor          = executor;
+    for (int i = 0; i < 3; i++) {
+        seed.enigma.rotor_indices[0] = i;
+        enigma_score_list_push(&seeds, &seed);
+    }
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS,
+        enigma_crack_beam(&cfg, &seeds, 5, enigma_crack_rotor_positions, enigma_ioc_score),
+        success);
+    TEST_ASSERT_EQUAL_INT(5, scores.score_count);
+    for (int i = 0; i < 5; i++) {
+        enigma_key_from_enigma(&keys[i], &scores.scores[i].enigma);
+        for (int j = 0; j < i; j++) {
+            TEST_ASSERT_NOT_EQUAL_INT_MESSAGE(
+                0, enigma_key_compare(&keys[i], &keys[j]), "Expected distinct configurations");
+        }
+    }
+
+    cfg.executor = NULL;
+    free(seeds.scores);
+    enigma_executor_free(executor);
+}
+
+void test_enigma_crack_beam_WithInvalidArguments(void) {
+    EnigmaScoreList  seeds = { 0 };
+    EnigmaCheckpoint checkpoint;
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE,
+        enigma_crack_beam(NULL, &seeds, 1, enigma_crack_rotors, enigma_ioc_score),
+        failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE,
+        enigma_crack_beam(&cfg, NULL, 1, enigma_crack_rotors, enigma_ioc_score),
+        failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE,
+        enigma_crack_beam(&cfg, &seeds, 0, enigma_crack_rotors, enigma_ioc_score),
+        failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_crack_beam(&cfg, &seeds, 1, NULL, enigma_ioc_score), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_crack_beam(&cfg, &seeds, 1, enigma_crack_rotors, NULL), failure);
+
+    cfg.checkpoint = &checkpoint;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE,
+        enigma_crack_beam(&cfg, &seeds, 1, enigma_crack_rotors, enigma_ioc_score),
+        failure);
+    cfg.checkpoint = NULL;
+}
+
 void test_enigma_crack_plugboard_WithValidArguments_WithEmptyPlugboard(void) {
     int ret = enigma_crack_plugboard(&cfg, mock_score_function);
     TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, ret, success);
@@ -351,6 +565,70 @@ void test_enigma_crack_reflector_WithInvalidArguments(void) {
                                   failure);
 }
 
+/**
+ * Score a decryption by the number of letters matching autoPlaintext.
+ */
+static float auto_match_score(const EnigmaCrackParams* config, const char* plaintext) {
+    float score = 0.0f;
+    for (size_t i = 0; i < config->ciphertext_length; i++) {
+        score += plaintext[i] == autoPlaintext[i];
+    }
+
+    return score;
+}
+
+void test_enigma_crack_ring_settings_WithValidArguments(void) {
+    size_t length       = strlen(autoPlaintext);
+    char*  text         = malloc(length + 1);
+    int    rings[3]     = { 3, 17, 9 };
+    int    positions[3] = { 12, 22, 4 };
+
+    for (int i = 0; i < 3; i++) {
+        enigma_set_ring_setting(&cfg.enigma, i, rings[i]);
+        enigma_set_rotor_index(&cfg.enigma, i, positions[i]);
+    }
+    enigma_encode_string(&cfg.enigma, autoPlaintext, text, length);
+    cfg.ciphertext        = text;
+    cfg.ciphertext_length = length;
+
+    // Start as a search with every ring at 'A' might: the right fast rotor offset, but the
+    // middle and left rotors one step off
+    enigma_init_default_config(&cfg.enigma);
+    enigma_set_rotor_index(&cfg.enigma, 0, positions[0] - rings[0]);
+    enigma_set_rotor_index(&cfg.enigma, 1, positions[1] - rings[1] + 1);
+    enigma_set_rotor_index(&cfg.enigma, 2, positions[2] - rings[2] + ENIGMA_ALPHA_SIZE - 1);
+    enigma_score_list_set_top_k(&scores, 1);
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS, enigma_crack_ring_settings(&cfg, auto_match_score), success);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(1, scores.score_count, "Expected the best score");
+
+    Enigma best      = scores.scores[0].enigma;
+    char*  plaintext = malloc(length + 1);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        rings[0], best.ring_settings[0], "Expected the fast ring to be recovered");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, best.ring_settings[2], "Expected the left ring to be folded");
+    enigma_encode_string(&best, text, plaintext, length);
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(
+        autoPlaintext, plaintext, length, "Expected the plaintext to be recovered");
+
+    free(plaintext);
+    free(text);
+}
+
+void test_enigma_crack_ring_settings_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_crack_ring_settings(NULL, NULL), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_crack_ring_settings(NULL, mock_score_function),
+                                  failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_crack_ring_settings(&cfg, NULL), failure);
+
+    cfg.enigma.ring_settings[1] = ENIGMA_ALPHA_SIZE;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_crack_ring_settings(&cfg, mock_score_function),
+                                  failure);
+}
+
 void test_enigma_crack_rotor_WithValidArguments(void) {
     int rot = 2;
     int ret = enigma_crack_rotor(&cfg, rot, mock_score_function);
@@ -539,6 +817,72 @@ void test_enigma_crack_rotor_positions_WithValidArguments_WithFourRotors(void) {
         TEST_ASSERT_NOT_EQUAL_INT_MESSAGE(4, cmp, "Expected at least one rotor position to change");
     }
 }
+float ioc_text_score(const EnigmaCrackParams* config, const char* plaintext) {
+    return enigma_ioc_score(config, plaintext);
+}
+
+void test_enigma_crack_rotor_positions_WithIndexScoreFunction(void) {
+    cfg.ciphertext        = alphaText;
+    cfg.ciphertext_length = strlen(alphaText);
+
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_crack_rotor_positions(&cfg, ioc_text_score));
+    int          count    = scores.score_count;
+    EnigmaScore* expected = malloc(count * sizeof(EnigmaScore));
+    memcpy(expected, scores.scores, count * sizeof(EnigmaScore));
+
+    scores.score_count = 0;
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_crack_rotor_positions(&cfg, enigma_ioc_score));
+    TEST_ASSERT_EQUAL_INT_MESSAGE(count, scores.score_count, "Expected score counts to match");
+    for (int i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL_FLOAT_MESSAGE(expected[i].score,
+                                        scores.scores[i].score,
+                                        "Expected index scores to match text scores");
+        TEST_ASSERT_EQUAL_INT_ARRAY(expected[i].enigma.rotor_indices,
+                                    scores.scores[i].enigma.rotor_indices,
+                                    4);
+    }
+
+    free(expected);
+}
+
+void test_enigma_crack_rotor_positions_WithInvalidCiphertext(void) {
+    cfg.ciphertext        = "DM?";
+    cfg.ciphertext_length = strlen(cfg.ciphertext);
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_crack_rotor_positions(&cfg, mock_score_function),
+                                  failure);
+    TEST_ASSERT_EQUAL_INT(0, scores.score_count);
+}
+
+void test_enigma_crack_rotor_positions_WithLowercaseCiphertext(void) {
+    char lower[64];
+    for (size_t i = 0; i <= strlen(alphaText); i++) {
+        lower[i] = tolower(alphaText[i]);
+    }
+
+    cfg.ciphertext        = alphaText;
+    cfg.ciphertext_length = strlen(alphaText);
+    enigma_score_list_set_top_k(&scores, 5);
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_crack_rotor_positions(&cfg, ioc_text_score));
+    enigma_score_list_sort(&scores);
+    EnigmaScore expected[5];
+    memcpy(expected, scores.scores, sizeof(expected));
+
+    // Lowercase ciphertext is read as uppercase
+    scores.score_count = 0;
+    cfg.ciphertext     = lower;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS, enigma_crack_rotor_positions(&cfg, ioc_text_score), success);
+    TEST_ASSERT_EQUAL_INT(5, scores.score_count);
+    enigma_score_list_sort(&scores);
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL_FLOAT(expected[i].score, scores.scores[i].score);
+        TEST_ASSERT_EQUAL_INT_ARRAY(
+            expected[i].enigma.rotor_indices, scores.scores[i].enigma.rotor_indices, 4);
+    }
+}
+
 void test_enigma_crack_rotor_positions_WithInvalidArguments(void) {
     TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
                                   enigma_crack_rotor_positions(NULL, NULL),
@@ -551,6 +895,442 @@ void test_enigma_crack_rotor_positions_WithInvalidArguments(void) {
                                   failure);
 }
 
+int crack_plugboard(EnigmaCrackParams* params) {
+    return enigma_crack_plugboard(params, enigma_ioc_score);
+}
+
+int crack_reflector(EnigmaCrackParams* params) {
+    return enigma_crack_reflector(params, enigma_ioc_score);
+}
+
+int crack_rotor(EnigmaCrackParams* params) {
+    return enigma_crack_rotor(params, 1, enigma_ioc_score);
+}
+
+int crack_rotors(EnigmaCrackParams* params) {
+    return enigma_crack_rotors(params, enigma_ioc_score);
+}
+
+int crack_rotor_position(EnigmaCrackParams* params) {
+    return enigma_crack_rotor_position(params, 2, enigma_ioc_score);
+}
+
+int crack_rotor_positions(EnigmaCrackParams* params) {
+    return enigma_crack_rotor_positions(params, ioc_text_score);
+}
+
+void test_enigma_crack_WithExecutor(void) {
+    int (*crackFuncs[])(EnigmaCrackParams*) = {
+        crack_plugboard, crack_reflector,      crack_rotor,
+        crack_rotors,    crack_rotor_position, crack_rotor_positions,
+    };
+    EnigmaExecutor* executor = enigma_executor_new(4);
+
+    cfg.ciphertext        = alphaText;
+    cfg.ciphertext_length = strlen(alphaText);
+    enigma_set_plugboard(&cfg.enigma, "QWER");
+
+    for (size_t f = 0; f < sizeof(crackFuncs) / sizeof(crackFuncs[0]); f++) {
+        scores.score_count = 0;
+        cfg.executor       = NULL;
+        TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, crackFuncs[f](&cfg), success);
+        int          count    = scores.score_count;
+        EnigmaScore* expected = malloc(count * sizeof(EnigmaScore));
+        memcpy(expected, scores.scores, count * sizeof(EnigmaScore));
+
+        // Keep a score from before the call to check that the workers' scores are appended
+        scores.score_count = 1;
+        cfg.executor       = executor;
+        TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, crackFuncs[f](&cfg), success);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(
+            count + 1, scores.score_count, "Expected score counts to match");
+        for (int i = 0; i < count; i++) {
+            EnigmaScore* actual = &scores.scores[i + 1];
+            TEST_ASSERT_EQUAL_FLOAT_MESSAGE(
+                expected[i].score, actual->score, "Expected scores in candidate order");
+            TEST_ASSERT_EQUAL_MEMORY_MESSAGE(&expected[i].enigma,
+                                             &actual->enigma,
+                                             sizeof(Enigma),
+                                             "Expected candidates in candidate order");
+        }
+
+        free(expected);
+    }
+
+    enigma_executor_free(executor);
+}
+
+void test_enigma_crack_WithTopK(void) {
+    int (*crackFuncs[])(EnigmaCrackParams*) = {
+        crack_plugboard, crack_reflector,      crack_rotor,
+        crack_rotors,    crack_rotor_position, crack_rotor_positions,
+    };
+    EnigmaExecutor* executor    = enigma_executor_new(4);
+    EnigmaExecutor* executors[] = { NULL, executor };
+
+    cfg.ciphertext        = alphaText;
+    cfg.ciphertext_length = strlen(alphaText);
+
+    for (size_t f = 0; f < sizeof(crackFuncs) / sizeof(crackFuncs[0]); f++) {
+        scores.score_count = 0;
+        scores.top_k       = 0;
+        cfg.executor       = NULL;
+        crackFuncs[f](&cfg);
+        enigma_score_list_sort(&scores);
+        int    count = scores.score_count < 5 ? scores.score_count : 5;
+        float* best  = malloc(count * sizeof(float));
+        for (int i = 0; i < count; i++) {
+            best[i] = scores.scores[i].score;
+        }
+
+        // The same best scores are kept with and without an executor
+        for (size_t e = 0; e < 2; e++) {
+            scores.score_count = 0;
+            enigma_score_list_set_top_k(&scores, 5);
+            cfg.executor = executors[e];
+            TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, crackFuncs[f](&cfg), success);
+            TEST_ASSERT_EQUAL_INT_MESSAGE(count, scores.score_count, "Expected top-K scores");
+
+            enigma_score_list_sort(&scores);
+            for (int i = 0; i < count; i++) {
+                TEST_ASSERT_EQUAL_FLOAT_MESSAGE(
+                    best[i], scores.scores[i].score, "Expected the best scores");
+            }
+        }
+
+        free(best);
+    }
+
+    enigma_executor_free(executor);
+}
+
+void test_enigma_crack_WithSink(void) {
+    int (*crackFuncs[])(EnigmaCrackParams*) = {
+        crack_plugboard, crack_reflector,      crack_rotor,
+        crack_rotors,    crack_rotor_position, crack_rotor_positions,
+    };
+    EnigmaExecutor* executor    = enigma_executor_new(4);
+    EnigmaExecutor* executors[] = { NULL, executor };
+
+    cfg.ciphertext        = alphaText;
+    cfg.ciphertext_length = strlen(alphaText);
+
+    for (size_t f = 0; f < sizeof(crackFuncs) / sizeof(crackFuncs[0]); f++) {
+        scores.score_count = 0;
+        cfg.score_list     = &scores;
+        cfg.sink           = NULL;
+        cfg.executor       = NULL;
+        crackFuncs[f](&cfg);
+
+        // Every score reaches the sink, and the score list is not used
+        for (size_t e = 0; e < 2; e++) {
+            EnigmaSink* sink = enigma_sink_new_count();
+            cfg.score_list   = NULL;
+            cfg.sink         = sink;
+            cfg.executor     = executors[e];
+            TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, crackFuncs[f](&cfg), success);
+            TEST_ASSERT_EQUAL_UINT_MESSAGE(
+                scores.score_count, enigma_sink_get_count(sink), "Expected every score");
+            enigma_sink_free(sink);
+        }
+    }
+
+    cfg.score_list = &scores;
+    cfg.sink       = NULL;
+    enigma_executor_free(executor);
+}
+
+void test_enigma_crack_WithScoreBounds(void) {
+    EnigmaExecutor* executor    = enigma_executor_new(4);
+    EnigmaExecutor* executors[] = { NULL, executor };
+
+    cfg.ciphertext              = alphaText;
+    cfg.ciphertext_length       = strlen(alphaText);
+    crack_rotor_positions(&cfg);
+    int          count = scores.score_count;
+    EnigmaScore* all   = malloc(count * sizeof(EnigmaScore));
+    memcpy(all, scores.scores, count * sizeof(EnigmaScore));
+
+    // Keep the middle of the score range
+    float min = all[0].score;
+    float max = all[0].score;
+    for (int i = 1; i < count; i++) {
+        min = all[i].score < min ? all[i].score : min;
+        max = all[i].score > max ? all[i].score : max;
+    }
+    cfg.min_score = min + (max - min) / 4;
+    cfg.max_score = max - (max - min) / 4;
+
+    for (size_t e = 0; e < 2; e++) {
+        scores.score_count = 0;
+        cfg.executor       = executors[e];
+        TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, crack_rotor_positions(&cfg), success);
+
+        // Only in-bound scores are appended, in candidate order
+        int kept = 0;
+        for (int i = 0; i < count; i++) {
+            if (all[i].score < cfg.min_score || all[i].score > cfg.max_score) {
+                continue;
+            }
+            TEST_ASSERT_TRUE_MESSAGE(kept < scores.score_count, "Expected in-bound scores");
+            TEST_ASSERT_EQUAL_FLOAT(all[i].score, scores.scores[kept].score);
+            kept++;
+        }
+        TEST_ASSERT_EQUAL_INT_MESSAGE(kept, scores.score_count, "Expected no out-of-bound scores");
+        TEST_ASSERT_TRUE(kept > 0 && kept < count);
+    }
+
+    free(all);
+    enigma_executor_free(executor);
+}
+
+void test_enigma_crack_WithTargetScore(void) {
+    EnigmaExecutor* executor    = enigma_executor_new(4);
+    EnigmaExecutor* executors[] = { NULL, executor };
+
+    cfg.ciphertext              = alphaText;
+    cfg.ciphertext_length       = strlen(alphaText);
+    crack_rotor_positions(&cfg);
+    int count = scores.score_count;
+
+    // The first candidate reaches the target, so the search ends soon after it. With an
+    // executor, another worker may reach the target first.
+    cfg.target_score = scores.scores[0].score;
+    for (size_t e = 0; e < 2; e++) {
+        scores.score_count = 0;
+        cfg.executor       = executors[e];
+        TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, crack_rotor_positions(&cfg), success);
+        TEST_ASSERT_TRUE_MESSAGE(scores.score_count < count / 10, "Expected the search to stop");
+
+        int reached = 0;
+        for (int i = 0; i < scores.score_count; i++) {
+            reached |= scores.scores[i].score >= cfg.target_score;
+        }
+        TEST_ASSERT_TRUE_MESSAGE(reached, "Expected a score reaching the target to be kept");
+    }
+
+    enigma_executor_free(executor);
+}
+
+void test_enigma_crack_WithCheckpoint(void) {
+    const char*     path        = "crack_checkpoint_test.bin";
+    EnigmaExecutor* executor    = enigma_executor_new(4);
+    EnigmaExecutor* executors[] = { NULL, executor };
+    float           best[5];
+
+    cfg.ciphertext              = alphaText;
+    cfg.ciphertext_length       = strlen(alphaText);
+    enigma_score_list_set_top_k(&scores, 5);
+    crack_rotor_positions(&cfg);
+    enigma_score_list_sort(&scores);
+    for (int i = 0; i < 5; i++) {
+        best[i] = scores.scores[i].score;
+    }
+
+    for (size_t e = 0; e < 2; e++) {
+        // Interrupt the search by reaching a target score, then resume it without the target
+        EnigmaCheckpoint* checkpoint = enigma_checkpoint_new(path, 0);
+        scores.score_count           = 0;
+        cfg.executor                 = executors[e];
+        cfg.checkpoint               = checkpoint;
+        cfg.target_score             = best[4];
+        TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, crack_rotor_positions(&cfg), success);
+        size_t done = enigma_checkpoint_get_done_count(checkpoint);
+        TEST_ASSERT_TRUE_MESSAGE(done < enigma_checkpoint_get_range_count(checkpoint),
+                                 "Expected the search to stop");
+        enigma_checkpoint_free(checkpoint);
+
+        // A search of the same size over another ciphertext or shard does not resume it
+        checkpoint = enigma_checkpoint_load(path, 0);
+        TEST_ASSERT_NOT_NULL(checkpoint);
+        cfg.checkpoint        = checkpoint;
+        cfg.target_score      = 0.0f;
+        cfg.ciphertext_length = strlen(alphaText) - 1;
+        TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, crack_rotor_positions(&cfg), failure);
+        cfg.ciphertext_length = strlen(alphaText);
+        cfg.shard_count       = 2;
+        TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, crack_rotor_positions(&cfg), failure);
+        cfg.shard_count = 0;
+        TEST_ASSERT_EQUAL_size_t(done, enigma_checkpoint_get_done_count(checkpoint));
+        scores.score_count = 0;
+        TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, crack_rotor_positions(&cfg), success);
+        TEST_ASSERT_EQUAL_size_t(enigma_checkpoint_get_range_count(checkpoint),
+                                 enigma_checkpoint_get_done_count(checkpoint));
+
+        // The resumed search keeps the same best scores as an uninterrupted one
+        TEST_ASSERT_EQUAL_INT_MESSAGE(5, scores.score_count, "Expected top-K scores");
+        enigma_score_list_sort(&scores);
+        for (int i = 0; i < 5; i++) {
+            TEST_ASSERT_EQUAL_FLOAT_MESSAGE(
+                best[i], scores.scores[i].score, "Expected the best scores");
+        }
+        enigma_checkpoint_free(checkpoint);
+    }
+
+    cfg.checkpoint = NULL;
+    remove(path);
+    enigma_executor_free(executor);
+}
+
+void test_enigma_crack_WithShards(void) {
+    int (*crackFuncs[])(EnigmaCrackParams*) = {
+        crack_plugboard, crack_reflector,      crack_rotor,
+        crack_rotors,    crack_rotor_position, crack_rotor_positions,
+    };
+    EnigmaExecutor* executor    = enigma_executor_new(4);
+    EnigmaExecutor* executors[] = { NULL, executor };
+
+    cfg.ciphertext              = alphaText;
+    cfg.ciphertext_length       = strlen(alphaText);
+
+    for (size_t f = 0; f < sizeof(crackFuncs) / sizeof(crackFuncs[0]); f++) {
+        scores.score_count = 0;
+        cfg.shard_count    = 0;
+        cfg.executor       = NULL;
+        crackFuncs[f](&cfg);
+        int          count    = scores.score_count;
+        EnigmaScore* expected = malloc((count ? count : 1) * sizeof(EnigmaScore));
+        memcpy(expected, scores.scores, count * sizeof(EnigmaScore));
+
+        // The shards run in order give every candidate of the unsharded search once
+        for (size_t e = 0; e < 2; e++) {
+            scores.score_count = 0;
+            cfg.executor       = executors[e];
+            for (int s = 0; s < 3; s++) {
+                enigma_crack_set_shard(&cfg, s, 3);
+                TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, crackFuncs[f](&cfg), success);
+            }
+            TEST_ASSERT_EQUAL_INT_MESSAGE(count, scores.score_count, "Expected every candidate");
+            for (int i = 0; i < count; i++) {
+                TEST_ASSERT_EQUAL_FLOAT(expected[i].score, scores.scores[i].score);
+                TEST_ASSERT_EQUAL_MEMORY(
+                    &expected[i].enigma, &scores.scores[i].enigma, sizeof(Enigma));
+            }
+        }
+
+        free(expected);
+    }
+
+    cfg.shard_count = 0;
+    enigma_executor_free(executor);
+}
+
+static int cancel_sink(EnigmaSink* sink, const EnigmaScore* score) {
+    return enigma_progress_cancel(sink->data);
+}
+
+void test_enigma_crack_WithProgress(void) {
+    int (*crackFuncs[])(EnigmaCrackParams*) = {
+        crack_plugboard, crack_reflector,      crack_rotor,
+        crack_rotors,    crack_rotor_position, crack_rotor_positions,
+    };
+    EnigmaExecutor* executor    = enigma_executor_new(4);
+    EnigmaExecutor* executors[] = { NULL, executor };
+    EnigmaProgress  progress;
+
+    cfg.ciphertext              = alphaText;
+    cfg.ciphertext_length       = strlen(alphaText);
+
+    for (size_t f = 0; f < sizeof(crackFuncs) / sizeof(crackFuncs[0]); f++) {
+        scores.score_count = 0;
+        cfg.executor       = NULL;
+        cfg.progress       = NULL;
+        crackFuncs[f](&cfg);
+        int          count    = scores.score_count;
+        EnigmaScore* expected = malloc((count ? count : 1) * sizeof(EnigmaScore));
+        memcpy(expected, scores.scores, count * sizeof(EnigmaScore));
+
+        // Every candidate is counted once, and the scores are unchanged
+        for (size_t e = 0; e < 2; e++) {
+            enigma_progress_reset(&progress);
+            scores.score_count = 0;
+            cfg.executor       = executors[e];
+            cfg.progress       = &progress;
+            TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, crackFuncs[f](&cfg), success);
+            TEST_ASSERT_TRUE_MESSAGE(enigma_progress_get_total(&progress) > 0,
+                                     "Expected a total");
+            TEST_ASSERT_EQUAL_size_t(enigma_progress_get_total(&progress),
+                                     enigma_progress_get_searched(&progress));
+            TEST_ASSERT_EQUAL_size_t(0, enigma_progress_get_remaining(&progress));
+            TEST_ASSERT_EQUAL_size_t(count, enigma_progress_get_candidates(&progress));
+            TEST_ASSERT_EQUAL_size_t(count * cfg.ciphertext_length,
+                                     enigma_progress_get_characters(&progress));
+            TEST_ASSERT_EQUAL_INT_MESSAGE(count, scores.score_count, "Expected every candidate");
+            for (int i = 0; i < count; i++) {
+                TEST_ASSERT_EQUAL_FLOAT(expected[i].score, scores.scores[i].score);
+            }
+        }
+
+        free(expected);
+    }
+
+    cfg.progress = NULL;
+    enigma_executor_free(executor);
+}
+
+void test_enigma_crack_WithProgress_Cancelled(void) {
+    EnigmaExecutor* executor    = enigma_executor_new(4);
+    EnigmaExecutor* executors[] = { NULL, executor };
+    EnigmaProgress  progress;
+    EnigmaSink*     sink        = enigma_sink_new(cancel_sink, &progress);
+
+    cfg.ciphertext              = alphaText;
+    cfg.ciphertext_length       = strlen(alphaText);
+    cfg.progress                = &progress;
+
+    for (size_t e = 0; e < 2; e++) {
+        cfg.executor = executors[e];
+
+        // A search cancelled before it starts runs nothing
+        enigma_progress_reset(&progress);
+        enigma_progress_cancel(&progress);
+        scores.score_count = 0;
+        TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, crack_rotor_positions(&cfg), success);
+        TEST_ASSERT_EQUAL_INT(0, scores.score_count);
+        TEST_ASSERT_EQUAL_size_t(0, enigma_progress_get_searched(&progress));
+        TEST_ASSERT_TRUE(enigma_progress_get_remaining(&progress) > 0);
+
+        // A search cancelled by its first score stops at the next range boundary
+        enigma_progress_reset(&progress);
+        cfg.sink = sink;
+        TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, crack_rotor_positions(&cfg), success);
+        TEST_ASSERT_EQUAL_INT(1, enigma_progress_is_cancelled(&progress));
+        TEST_ASSERT_TRUE_MESSAGE(enigma_progress_get_remaining(&progress) > 0,
+                                 "Expected the search to stop");
+        cfg.sink = NULL;
+    }
+
+    cfg.progress = NULL;
+    enigma_sink_free(sink);
+    enigma_executor_free(executor);
+}
+
+void test_enigma_score_append_WithScoreBounds(void) {
+    Enigma enigma;
+    enigma_init_default_config(&enigma);
+    cfg.min_score = 0.1f;
+    cfg.max_score = 0.2f;
+
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_score_append(&cfg, &enigma, helloWorld, 0.05f));
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_score_append(&cfg, &enigma, helloWorld, 0.15f));
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_score_append(&cfg, &enigma, helloWorld, 0.25f));
+    TEST_ASSERT_EQUAL_INT_MESSAGE(1, scores.score_count, "Expected out-of-bound scores dropped");
+    TEST_ASSERT_EQUAL_FLOAT(0.15f, scores.scores[0].score);
+}
+
+void test_enigma_crack_WithExecutor_WithInvalidCiphertext(void) {
+    EnigmaExecutor* executor = enigma_executor_new(4);
+
+    cfg.ciphertext        = "DM?";
+    cfg.ciphertext_length = strlen(cfg.ciphertext);
+    cfg.executor          = executor;
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, crack_rotors(&cfg), failure);
+    TEST_ASSERT_EQUAL_INT(0, scores.score_count);
+
+    enigma_executor_free(executor);
+}
+
 void test_enigma_dict_match_WithMatchingPlaintext_Not_X_Separated(void) {
     const char* plaintext = "HELLOXWORLDXFOOXBAR";
     cfg.ciphertext_length = strlen(plaintext);
@@ -613,6 +1393,54 @@ void test_enigma_dict_match_WithNonMatchingPlaintext_Not_X_Separated(void) {
     free(cfg.dictionary);
 }
 
+void test_enigma_dict_match_indices(void) {
+    const char* texts[]    = { "HELLOXWORLDXFOOXBAR", "HELLOWORLD", "XHELLOX", "HELLOXBAZX" };
+    const char* dictString = "BAR\nBAZ\nFOO\nGOODBYE\nHELLO\nTEST\nWORLD";
+    uint8_t     indices[32];
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS,
+                                  enigma_load_dict_s(&cfg, dictString, strlen(dictString)),
+                                  "Expected enigma_load_dict_s to succeed");
+
+    for (int separated = 0; separated < 2; separated++) {
+        cfg.flags = separated ? ENIGMA_FLAG_X_SEPARATED : 0;
+        for (size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); i++) {
+            cfg.ciphertext_length = strlen(texts[i]);
+            enigma_text_to_indices(texts[i], indices, cfg.ciphertext_length);
+            TEST_ASSERT_EQUAL_INT_MESSAGE(enigma_dict_match(&cfg, texts[i]),
+                                          enigma_dict_match_indices(&cfg, indices),
+                                          "Expected index match to agree with text match");
+        }
+    }
+
+    free(cfg.dictionary);
+}
+
+void test_enigma_dict_match_indices_WithNullArguments(void) {
+    uint8_t indices[1] = { 0 };
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_dict_match_indices(NULL, NULL), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_dict_match_indices(&cfg, NULL), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_dict_match_indices(&cfg, indices),
+                                  failure);
+}
+
+void test_enigma_index_score_function(void) {
+    TEST_ASSERT_TRUE(enigma_index_score_function(enigma_ioc_score) == enigma_ioc_score_indices);
+    TEST_ASSERT_TRUE(enigma_index_score_function(enigma_quadgram_score)
+                     == enigma_quadgram_score_indices);
+    TEST_ASSERT_NULL(enigma_index_score_function(mock_score_function));
+    TEST_ASSERT_NULL(enigma_index_score_function(NULL));
+}
+
+void test_enigma_batch_score_function(void) {
+    TEST_ASSERT_TRUE(enigma_batch_score_function(enigma_ioc_score) == enigma_ioc_score_batch);
+    TEST_ASSERT_TRUE(enigma_batch_score_function(enigma_quadgram_score)
+                     == enigma_quadgram_score_batch);
+    TEST_ASSERT_NULL(enigma_batch_score_function(mock_score_function));
+    TEST_ASSERT_NULL(enigma_batch_score_function(NULL));
+}
+
 void test_enigma_dict_match_WithNullArguments(void) {
     TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_dict_match(NULL, NULL), failure);
     TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_dict_match(&cfg, "HELLO"), failure);
@@ -1137,6 +1965,85 @@ void test_enigma_crack_set_target_score_WithInvalidArguments(void) {
     TEST_ASSERT_EQUAL_INT(-1, enigma_crack_set_target_score(NULL, 7.89f));
 }
 
+void test_enigma_crack_set_executor(void) {
+    EnigmaExecutor* executor = enigma_executor_new(1);
+
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_crack_set_executor(&cfg, executor));
+    TEST_ASSERT_EQUAL_PTR(executor, enigma_crack_get_executor(&cfg));
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_crack_set_executor(&cfg, NULL));
+    TEST_ASSERT_NULL(enigma_crack_get_executor(&cfg));
+
+    enigma_executor_free(executor);
+}
+
+void test_enigma_crack_set_executor_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT(-1, enigma_crack_set_executor(NULL, NULL));
+    TEST_ASSERT_NULL(enigma_crack_get_executor(NULL));
+}
+
+void test_enigma_crack_set_sink(void) {
+    EnigmaSink* sink = enigma_sink_new_count();
+
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_crack_set_sink(&cfg, sink));
+    TEST_ASSERT_EQUAL_PTR(sink, enigma_crack_get_sink(&cfg));
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_crack_set_sink(&cfg, NULL));
+    TEST_ASSERT_NULL(enigma_crack_get_sink(&cfg));
+
+    enigma_sink_free(sink);
+}
+
+void test_enigma_crack_set_sink_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT(-1, enigma_crack_set_sink(NULL, NULL));
+    TEST_ASSERT_NULL(enigma_crack_get_sink(NULL));
+}
+
+void test_enigma_crack_set_checkpoint(void) {
+    EnigmaCheckpoint* checkpoint = enigma_checkpoint_new("unused.bin", 0);
+
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_crack_set_checkpoint(&cfg, checkpoint));
+    TEST_ASSERT_EQUAL_PTR(checkpoint, enigma_crack_get_checkpoint(&cfg));
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_crack_set_checkpoint(&cfg, NULL));
+    TEST_ASSERT_NULL(enigma_crack_get_checkpoint(&cfg));
+
+    enigma_checkpoint_free(checkpoint);
+}
+
+void test_enigma_crack_set_checkpoint_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT(-1, enigma_crack_set_checkpoint(NULL, NULL));
+    TEST_ASSERT_NULL(enigma_crack_get_checkpoint(NULL));
+}
+
+void test_enigma_crack_set_shard(void) {
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_crack_set_shard(&cfg, 2, 4));
+    TEST_ASSERT_EQUAL_INT(2, enigma_crack_get_shard(&cfg));
+    TEST_ASSERT_EQUAL_INT(4, enigma_crack_get_shard_count(&cfg));
+}
+
+void test_enigma_crack_set_shard_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT(-1, enigma_crack_set_shard(NULL, 0, 1));
+    TEST_ASSERT_EQUAL_INT(-1, enigma_crack_set_shard(&cfg, 0, 0));
+    TEST_ASSERT_EQUAL_INT(-1, enigma_crack_set_shard(&cfg, -1, 2));
+    TEST_ASSERT_EQUAL_INT(-1, enigma_crack_set_shard(&cfg, 2, 2));
+    TEST_ASSERT_EQUAL_INT(-1, enigma_crack_get_shard(NULL));
+    TEST_ASSERT_EQUAL_INT(-1, enigma_crack_get_shard_count(NULL));
+}
+
+void test_enigma_crack_set_progress(void) {
+    EnigmaProgress* progress = enigma_progress_new();
+
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_crack_set_progress(&cfg, progress));
+    TEST_ASSERT_EQUAL_PTR(progress, enigma_crack_get_progress(&cfg));
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_crack_set_progress(&cfg, NULL));
+    TEST_ASSERT_NULL(enigma_crack_get_progress(&cfg));
+
+    enigma_progress_free(progress);
+}
+
+void test_enigma_crack_set_progress_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT(-1, enigma_crack_set_progress(NULL, NULL));
+    TEST_ASSERT_NULL(enigma_crack_get_progress(NULL));
+}
+
 void test_enigma_crack_set_known_plaintext(void) {
     const char* known = "HELLO";
     int         ret   = enigma_crack_set_known_plaintext(&cfg, known, 5);
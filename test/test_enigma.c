@@ -2,6 +2,7 @@
 #include "enigma/enigma.h"
 #include "unity.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 extern void enigma_rotate(int*);
@@ -54,6 +55,21 @@ void test_enigma_encode_string(void) {
     TEST_ASSERT_EQUAL_STRING_MESSAGE("ILBDA", output, "Expected encoded string to match");
 }
 
+void test_enigma_encode_string_WithRingSettings(void) {
+    const char* input     = "AAAAA";
+    char        output[6] = { 0 };
+
+    enigma_init_default_config(&enigma);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT_MESSAGE(
+            ENIGMA_SUCCESS, enigma_set_ring_setting(&enigma, i, 1), success);
+    }
+    int ret = enigma_encode_string(&enigma, input, output, strlen(input));
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, ret, success);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("EWTYX", output, "Expected encoded string to match");
+}
+
 void test_enigma_encode_string_WithInvalidArguments(void) {
     char s[2];
     TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
@@ -73,6 +89,446 @@ void test_enigma_encode_string_WithInvalidArguments(void) {
                                   failure);
 }
 
+void test_enigma_scrambler_encode_string(void) {
+    const char*     input        = "THEQUICKBROWNFOXJUMPSOVERTHELAZYDOG"
+                                   "THEQUICKBROWNFOXJUMPSOVERTHELAZYDOG";
+    int             len          = strlen(input);
+    char            expected[71] = { 0 };
+    char            output[71]   = { 0 };
+    EnigmaScrambler scrambler;
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS,
+                                  enigma_scrambler_init(&scrambler, &enigma),
+                                  success);
+    TEST_ASSERT_TRUE(enigma_scrambler_matches(&scrambler, &enigma));
+
+    Enigma copy = enigma;
+    enigma_encode_string(&copy, input, expected, len);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS,
+                                  enigma_scrambler_encode_string(&scrambler,
+                                                                 &enigma,
+                                                                 input,
+                                                                 output,
+                                                                 len),
+                                  success);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, output, "Expected cached encoding to match");
+    TEST_ASSERT_EQUAL_INT_ARRAY(copy.rotor_indices, enigma.rotor_indices, ENIGMA_MAX_ROTOR_COUNT);
+
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_scrambler_free(&scrambler));
+    TEST_ASSERT_NULL(scrambler.permutations);
+}
+
+void test_enigma_encode_string_WithPlugboard(void) {
+    const char* input      = "HELLO";
+    char        output[6]  = { 0 };
+    char        decoded[6] = { 0 };
+
+    enigma_init_default_config(&enigma);
+    enigma_set_plugboard(&enigma, "HXEQ");
+    Enigma copy = enigma;
+
+    enigma_encode_string(&enigma, input, output, strlen(input));
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("GNBDA", output, "Expected encoded string to match");
+
+    enigma_encode_string(&copy, output, decoded, strlen(output));
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(input, decoded, "Expected encoding to be reciprocal");
+}
+
+void test_enigma_scrambler_matches(void) {
+    EnigmaScrambler scrambler;
+    enigma_init_default_config(&enigma);
+    enigma_scrambler_init(&scrambler, &enigma);
+
+    enigma.rotor_indices[0] = 5;
+    strcpy(enigma.plugboard, "ABCD");
+    TEST_ASSERT_TRUE(enigma_scrambler_matches(&scrambler, &enigma));
+
+    enigma.reflector = &enigma_UKW_C;
+    TEST_ASSERT_FALSE(enigma_scrambler_matches(&scrambler, &enigma));
+
+    enigma_scrambler_free(&scrambler);
+    TEST_ASSERT_FALSE(enigma_scrambler_matches(&scrambler, &enigma));
+}
+
+void test_enigma_scrambler_WithInvalidArguments(void) {
+    EnigmaScrambler scrambler;
+    char            s[2] = "A";
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_scrambler_init(NULL, &enigma), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_scrambler_init(&scrambler, NULL), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_scrambler_free(NULL), failure);
+    TEST_ASSERT_FALSE(enigma_scrambler_matches(NULL, &enigma));
+
+    enigma_scrambler_init(&scrambler, &enigma);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_scrambler_encode_string(NULL, &enigma, s, s, 1),
+                                  failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_scrambler_encode_string(&scrambler, NULL, s, s, 1),
+                                  failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_scrambler_encode_string(&scrambler, &enigma, NULL, s, 1),
+                                  failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_scrambler_encode_string(&scrambler, &enigma, s, NULL, 1),
+                                  failure);
+    enigma_scrambler_free(&scrambler);
+}
+
+void test_enigma_seek(void) {
+    const size_t offsets[] = { 0, 1, 25, 26, 27, 650, 676, 17575, 17576, 100003 };
+    for (size_t i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++) {
+        Enigma expected = enigma;
+        Enigma actual   = enigma;
+        for (size_t j = 0; j < offsets[i]; j++) {
+            enigma_rotate_rotors(&expected);
+        }
+
+        TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, enigma_seek(&actual, offsets[i]), success);
+        TEST_ASSERT_EQUAL_INT_ARRAY_MESSAGE(expected.rotor_indices,
+                                            actual.rotor_indices,
+                                            ENIGMA_MAX_ROTOR_COUNT,
+                                            "Expected rotor indices to match stepping");
+    }
+}
+
+void test_enigma_seek_WithDoubleStep(void) {
+    Enigma expected;
+    enigma_init_default_config(&enigma);
+    enigma.rotor_indices[1] = 3;
+    expected                = enigma;
+
+    for (int i = 0; i < 60; i++) {
+        Enigma actual = enigma;
+        enigma_seek(&actual, i);
+        TEST_ASSERT_EQUAL_INT_ARRAY(expected.rotor_indices,
+                                    actual.rotor_indices,
+                                    ENIGMA_MAX_ROTOR_COUNT);
+        enigma_rotate_rotors(&expected);
+    }
+}
+
+void test_enigma_seek_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_seek(NULL, 1), failure);
+
+    enigma.rotor_count = 2;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_seek(&enigma, 1), failure);
+}
+
+void test_enigma_key(void) {
+    EnigmaKey key;
+    Enigma    copy;
+
+    enigma_init_default_config(&enigma);
+    enigma.rotor_count = 4;
+    enigma.rotors[3]   = &enigma_rotor_VIII;
+    enigma_set_rotor_index(&enigma, 3, 25);
+    enigma_set_reflector(&enigma, 2);
+    enigma_set_plugboard(&enigma, "QAZWSXEDCRFVTGBYHNUJ");
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(16, sizeof(EnigmaKey), "Expected keys to be 16 bytes");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, enigma_key_from_enigma(&key, &enigma), success);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, enigma_key_to_enigma(&key, &copy), success);
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(4, copy.rotor_count, "Expected rotor count to match");
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(
+            enigma.rotors[i]->name, copy.rotors[i]->name, "Expected rotors to match");
+        TEST_ASSERT_EQUAL_INT_MESSAGE(
+            enigma.rotor_indices[i], copy.rotor_indices[i], "Expected rotor indices to match");
+    }
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(
+        enigma.reflector->name, copy.reflector->name, "Expected reflectors to match");
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(enigma.plugboard_offsets,
+                                     copy.plugboard_offsets,
+                                     sizeof(copy.plugboard_offsets),
+                                     "Expected plugboards to match");
+}
+
+void test_enigma_key_WithRingSettings(void) {
+    EnigmaKey   key;
+    Enigma      copy;
+    const char* input = "THEQUICKBROWNFOXJUMPSOVERTHELAZYDOGTHEQUICKBROWNFOXJUMPSOVERTHELAZYDOG";
+    char        expected[80];
+    char        actual[80];
+
+    enigma_init_default_config(&enigma);
+    enigma.rotor_count = 4;
+    enigma.rotors[3]   = &enigma_rotor_VIII;
+    for (int i = 0; i < 4; i++) {
+        enigma_set_rotor_index(&enigma, i, 3 * i + 20);
+        enigma_set_ring_setting(&enigma, i, 7 * i + 5);
+    }
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, enigma_key_from_enigma(&key, &enigma), success);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, enigma_key_to_enigma(&key, &copy), success);
+
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL_INT_MESSAGE(enigma.ring_settings[i],
+                                      copy.ring_settings[i],
+                                      "Expected stepping rings to match");
+    }
+    for (int i = 2; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT_MESSAGE(0, copy.ring_settings[i], "Expected ring to be folded");
+    }
+
+    enigma_encode_string(&enigma, input, expected, strlen(input));
+    enigma_encode_string(&copy, input, actual, strlen(input));
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(
+        expected, actual, strlen(input), "Expected folded key to encode the same way");
+
+    key.rings[1] = ENIGMA_ALPHA_SIZE;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_key_to_enigma(&key, &copy), failure);
+}
+
+void test_enigma_key_compare(void) {
+    EnigmaKey a;
+    EnigmaKey b;
+
+    enigma_init_default_config(&enigma);
+    enigma_set_plugboard(&enigma, "ABCD");
+    enigma_key_from_enigma(&a, &enigma);
+    enigma_set_plugboard(&enigma, "CDBA");
+    enigma_key_from_enigma(&b, &enigma);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        0, enigma_key_compare(&a, &b), "Expected keys of the same configuration to be equal");
+
+    enigma_set_rotor_index(&enigma, 1, 5);
+    enigma_key_from_enigma(&b, &enigma);
+    TEST_ASSERT_NOT_EQUAL_INT_MESSAGE(
+        0, enigma_key_compare(&a, &b), "Expected keys of different configurations to differ");
+    TEST_ASSERT_TRUE_MESSAGE((enigma_key_compare(&a, &b) < 0) == (enigma_key_compare(&b, &a) > 0),
+                             "Expected key order to be antisymmetric");
+}
+
+void test_enigma_key_WithInvalidArguments(void) {
+    EnigmaKey   key;
+    EnigmaRotor custom = enigma_rotor_I;
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_key_from_enigma(NULL, &enigma), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_key_from_enigma(&key, NULL), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_key_to_enigma(NULL, &enigma), failure);
+
+    enigma_init_default_config(&enigma);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, enigma_key_from_enigma(&key, &enigma), success);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_key_to_enigma(&key, NULL), failure);
+
+    key.plugboard = UINT64_MAX;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_key_to_enigma(&key, &enigma), failure);
+
+    custom.fwd_indices[0] = custom.fwd_indices[1];
+    enigma.rotors[0]      = &custom;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_key_from_enigma(&key, &enigma), failure);
+}
+
+void test_enigma_encode_string_parallel(void) {
+    const int length   = ENIGMA_PARALLEL_MIN_CHUNK * 3 + 17;
+    char*     input    = malloc(length + 1);
+    char*     expected = malloc(length + 1);
+    char*     output   = malloc(length + 1);
+
+    for (int i = 0; i < length; i++) {
+        input[i] = 'A' + rand() % ENIGMA_ALPHA_SIZE;
+    }
+    input[length] = '\0';
+
+    Enigma serial = enigma;
+    enigma_encode_string(&serial, input, expected, length);
+
+    const int threads[] = { 1, 2, 3, 8 };
+    for (size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); i++) {
+        Enigma parallel = enigma;
+        memset(output, 0, length + 1);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(
+            ENIGMA_SUCCESS,
+            enigma_encode_string_parallel(&parallel, input, output, length, threads[i]),
+            success);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, output, "Expected output to match serial");
+        TEST_ASSERT_EQUAL_INT_ARRAY_MESSAGE(serial.rotor_indices,
+                                            parallel.rotor_indices,
+                                            ENIGMA_MAX_ROTOR_COUNT,
+                                            "Expected final rotor state to match serial");
+    }
+
+    free(input);
+    free(expected);
+    free(output);
+}
+
+void test_enigma_encode_string_parallel_WithInvalidArguments(void) {
+    char s[4] = "AB1";
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_encode_string_parallel(NULL, s, s, 3, 2),
+                                  failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_encode_string_parallel(&enigma, NULL, s, 3, 2),
+                                  failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_encode_string_parallel(&enigma, s, NULL, 3, 2),
+                                  failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_encode_string_parallel(&enigma, s, s, 3, 0),
+                                  failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_encode_string_parallel(&enigma, s, s, 3, 2),
+                                  failure);
+}
+
+void test_enigma_encode_string_executor(void) {
+    const int length   = ENIGMA_PARALLEL_MIN_CHUNK * 3 + 17;
+    char*     input    = malloc(length + 1);
+    char*     expected = malloc(length + 1);
+    char*     output   = malloc(length + 1);
+
+    for (int i = 0; i < length; i++) {
+        input[i] = 'A' + rand() % ENIGMA_ALPHA_SIZE;
+    }
+    input[length] = '\0';
+
+    Enigma serial = enigma;
+    enigma_encode_string(&serial, input, expected, length);
+
+    // The same executor is reused, with more workers than chunks
+    EnigmaExecutor* executor = enigma_executor_new(4);
+    TEST_ASSERT_NOT_NULL(executor);
+    Enigma parallel = enigma;
+    for (int i = 0; i < 2; i++) {
+        memset(output, 0, length + 1);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(
+            ENIGMA_SUCCESS,
+            enigma_encode_string_executor(&parallel, input, output, length, executor),
+            success);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, output, "Expected output to match serial");
+        TEST_ASSERT_EQUAL_INT_ARRAY_MESSAGE(serial.rotor_indices,
+                                            parallel.rotor_indices,
+                                            ENIGMA_MAX_ROTOR_COUNT,
+                                            "Expected final rotor state to match serial");
+        enigma_encode_string(&serial, input, expected, length);
+    }
+    enigma_executor_free(executor);
+
+    free(input);
+    free(expected);
+    free(output);
+}
+
+void test_enigma_encode_string_executor_WithInvalidArguments(void) {
+    char            s[4]     = "AB1";
+    EnigmaExecutor* executor = enigma_executor_new(1);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_encode_string_executor(NULL, s, s, 3, executor),
+                                  failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_encode_string_executor(&enigma, NULL, s, 3, executor),
+                                  failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_encode_string_executor(&enigma, s, NULL, 3, executor),
+                                  failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_encode_string_executor(&enigma, s, s, 3, NULL),
+                                  failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_encode_string_executor(&enigma, s, s, 3, executor),
+                                  failure);
+    enigma_executor_free(executor);
+}
+
+void test_enigma_encode_indices(void) {
+    const char* input = "THEQUICKBROWNFOXJUMPSOVERTHELAZYDOG";
+    int         len   = strlen(input);
+    char        expected[36];
+    char        output[36];
+    uint8_t     indices[35];
+
+    Enigma copy = enigma;
+    enigma_encode_string(&copy, input, expected, len);
+
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_text_to_indices(input, indices, len));
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS,
+                                  enigma_encode_indices(&enigma, indices, indices, len),
+                                  success);
+
+    // Lowercase text gives the same indices as uppercase
+    uint8_t lower[3];
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_text_to_indices("tHe", lower, 3));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(((const uint8_t[]) { 19, 7, 4 }), lower, 3);
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_indices_to_text(indices, output, len));
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, output, "Expected index encoding to match");
+    TEST_ASSERT_EQUAL_INT_ARRAY(copy.rotor_indices, enigma.rotor_indices, ENIGMA_MAX_ROTOR_COUNT);
+}
+
+void test_enigma_encode_index(void) {
+    Enigma copy = enigma;
+    TEST_ASSERT_EQUAL_INT(enigma_encode(&copy, 'Q') - 'A', enigma_encode_index(&enigma, 'Q' - 'A'));
+    TEST_ASSERT_EQUAL_INT(ENIGMA_FAILURE, enigma_encode_index(&enigma, ENIGMA_ALPHA_SIZE));
+    TEST_ASSERT_EQUAL_INT(ENIGMA_FAILURE, enigma_encode_index(NULL, 0));
+}
+
+void test_enigma_encode_indices_WithInvalidArguments(void) {
+    uint8_t indices[2] = { 0, ENIGMA_ALPHA_SIZE };
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_encode_indices(NULL, indices, indices, 1),
+                                  failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_encode_indices(&enigma, NULL, indices, 1),
+                                  failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_encode_indices(&enigma, indices, NULL, 1),
+                                  failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_encode_indices(&enigma, indices, indices, 2),
+                                  failure);
+}
+
+void test_enigma_text_to_indices_WithInvalidArguments(void) {
+    uint8_t indices[4];
+    char    text[4];
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_text_to_indices("A?C", indices, 3),
+                                  failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_text_to_indices(NULL, indices, 3),
+                                  failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_text_to_indices("ABC", NULL, 3), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_indices_to_text(NULL, text, 0), failure);
+}
+
+void test_enigma_encode_string_WithLowercaseInput(void) {
+    char   upper[6] = { 0 };
+    char   lower[6] = { 0 };
+    Enigma copy     = enigma;
+
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_encode_string(&enigma, "HELLO", upper, 5));
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_encode_string(&copy, "hElLo", lower, 5));
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(upper, lower, "Expected lowercase input to be normalized");
+}
+
+void test_enigma_encode_string_WithInvalidCharacter(void) {
+    char   output[6] = { 0 };
+    Enigma copy      = enigma;
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
+                                  enigma_encode_string(&enigma, "HEL O", output, 5),
+                                  failure);
+    TEST_ASSERT_EQUAL_INT_ARRAY_MESSAGE(copy.rotor_indices,
+                                        enigma.rotor_indices,
+                                        ENIGMA_MAX_ROTOR_COUNT,
+                                        "Expected rotors to be untouched");
+}
+
+void test_enigma_encode_string_unchecked(void) {
+    const char* input = "THEQUICKBROWNFOXJUMPSOVERTHELAZYDOG";
+    char        expected[36];
+    char        output[36];
+    Enigma      copy = enigma;
+
+    enigma_encode_string(&copy, input, expected, strlen(input));
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS,
+                          enigma_encode_string_unchecked(&enigma, input, output, strlen(input)));
+    TEST_ASSERT_EQUAL_STRING(expected, output);
+    TEST_ASSERT_EQUAL_INT_ARRAY(copy.rotor_indices, enigma.rotor_indices, ENIGMA_MAX_ROTOR_COUNT);
+}
+
 void test_enigma_init_rotors(void) {
     const EnigmaRotor rotor_array[3] = { enigma_rotor_III, enigma_rotor_II, enigma_rotor_I };
 
@@ -184,6 +640,7 @@ void test_rotate_rotors(void) {
     rotor2.fwd_indices[17]  = 25;
     rotor2.notches[0]       = 25;
     rotor2.notches_count    = 1;
+    enigma_rotor_update_turnovers(&rotor2);
     enigma_rotate_rotors(&enigma);
 
     TEST_ASSERT_EQUAL_INT_MESSAGE(10, enigma.rotor_indices[0], "Expected first rotor to rotate");
@@ -305,6 +762,16 @@ void test_enigma_get_rotor_index(void) {
 void test_enigma_get_rotor_index_WithInvalidArgument(void) {
     TEST_ASSERT_EQUAL_INT(ENIGMA_FAILURE, enigma_get_rotor_index(NULL, 0));
 }
+
+void test_enigma_get_ring_setting(void) {
+    enigma.ring_settings[1] = 9;
+    TEST_ASSERT_EQUAL_INT(9, enigma_get_ring_setting(&enigma, 1));
+}
+
+void test_enigma_get_ring_setting_WithInvalidArgument(void) {
+    TEST_ASSERT_EQUAL_INT(ENIGMA_FAILURE, enigma_get_ring_setting(NULL, 0));
+    TEST_ASSERT_EQUAL_INT(ENIGMA_FAILURE, enigma_get_ring_setting(&enigma, 4));
+}
 void test_enigma_set_plugboard(void) {
     const char* plugboard = "QWERTY";
     int         ret       = enigma_set_plugboard(&enigma, plugboard);
@@ -312,6 +779,35 @@ void test_enigma_set_plugboard(void) {
     TEST_ASSERT_EQUAL_STRING(plugboard, enigma.plugboard);
 }
 
+void test_enigma_set_plugboard_FillsPermutationTable(void) {
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_set_plugboard(&enigma, "azQW"));
+    TEST_ASSERT_EQUAL_STRING("AZQW", enigma.plugboard);
+    TEST_ASSERT_EQUAL_INT('Z' - 'A', enigma.plugboard_offsets['A' - 'A']);
+    TEST_ASSERT_EQUAL_INT('A' - 'Z', enigma.plugboard_offsets['Z' - 'A']);
+    TEST_ASSERT_EQUAL_INT('W' - 'Q', enigma.plugboard_offsets['Q' - 'A']);
+    TEST_ASSERT_EQUAL_INT('Q' - 'W', enigma.plugboard_offsets['W' - 'A']);
+    TEST_ASSERT_EQUAL_INT(0, enigma.plugboard_offsets['B' - 'A']);
+
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_set_plugboard(&enigma, ""));
+    TEST_ASSERT_EQUAL_STRING("", enigma.plugboard);
+    for (int i = 0; i < ENIGMA_ALPHA_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0, enigma.plugboard_offsets[i]);
+    }
+}
+
+void test_enigma_set_plugboard_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_set_plugboard(&enigma, "ABCD"));
+
+    TEST_ASSERT_EQUAL_INT(ENIGMA_FAILURE, enigma_set_plugboard(NULL, "AB"));
+    TEST_ASSERT_EQUAL_INT(ENIGMA_FAILURE, enigma_set_plugboard(&enigma, NULL));
+    TEST_ASSERT_EQUAL_INT(ENIGMA_FAILURE, enigma_set_plugboard(&enigma, "ABC"));
+    TEST_ASSERT_EQUAL_INT(ENIGMA_FAILURE, enigma_set_plugboard(&enigma, "AB1D"));
+    TEST_ASSERT_EQUAL_INT(ENIGMA_FAILURE, enigma_set_plugboard(&enigma, "ABCA"));
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("ABCD",
+                                     enigma.plugboard,
+                                     "Expected plugboard to be unchanged on failure");
+}
+
 void test_enigma_set_reflector(void) {
     int ret = enigma_set_reflector(&enigma, 0); // assuming 0 is a valid reflector index
     TEST_ASSERT_EQUAL_INT(0, ret);
@@ -342,3 +838,17 @@ void test_enigma_set_rotor_index(void) {
     TEST_ASSERT_EQUAL_INT(0, ret);
     TEST_ASSERT_EQUAL_INT(15, enigma.rotor_indices[2]);
 }
+
+void test_enigma_set_ring_setting(void) {
+    enigma.rotor_count = 3;
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_set_ring_setting(&enigma, 2, 25));
+    TEST_ASSERT_EQUAL_INT(25, enigma.ring_settings[2]);
+}
+
+void test_enigma_set_ring_setting_WithInvalidArguments(void) {
+    enigma.rotor_count = 3;
+    TEST_ASSERT_EQUAL_INT(ENIGMA_FAILURE, enigma_set_ring_setting(NULL, 0, 0));
+    TEST_ASSERT_EQUAL_INT(ENIGMA_FAILURE, enigma_set_ring_setting(&enigma, 3, 0));
+    TEST_ASSERT_EQUAL_INT(ENIGMA_FAILURE, enigma_set_ring_setting(&enigma, 0, -1));
+    TEST_ASSERT_EQUAL_INT(ENIGMA_FAILURE, enigma_set_ring_setting(&enigma, 0, ENIGMA_ALPHA_SIZE));
+}
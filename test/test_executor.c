@@ -0,0 +1,74 @@
+#include "enigma/common.h"
+#include "enigma/executor.h"
+#include "unity.h"
+
+#include <string.h>
+
+#define THREAD_COUNT 4
+
+const char* success = "Expected success";
+const char* failure = "Expected failure";
+
+int         runs[THREAD_COUNT];
+
+void        setUp(void) { memset(runs, 0, sizeof(runs)); }
+void        tearDown(void) {}
+
+static void count_run(void* arg, int index) {
+    int* counts = arg;
+    counts[index]++;
+}
+
+void test_enigma_executor_new(void) {
+    EnigmaExecutor* executor = enigma_executor_new(THREAD_COUNT);
+    TEST_ASSERT_NOT_NULL(executor);
+    TEST_ASSERT_EQUAL_INT(THREAD_COUNT, enigma_executor_get_thread_count(executor));
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, enigma_executor_free(executor), success);
+}
+
+void test_enigma_executor_new_WithInvalidArguments(void) {
+    TEST_ASSERT_NULL(enigma_executor_new(0));
+    TEST_ASSERT_NULL(enigma_executor_new(-1));
+}
+
+void test_enigma_executor_free_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_executor_free(NULL), failure);
+}
+
+void test_enigma_executor_run(void) {
+    EnigmaExecutor* executor = enigma_executor_new(THREAD_COUNT);
+
+    // The pool is reused, and every worker runs every job once
+    for (int job = 0; job < 3; job++) {
+        TEST_ASSERT_EQUAL_INT_MESSAGE(
+            ENIGMA_SUCCESS, enigma_executor_run(executor, count_run, runs), success);
+    }
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        TEST_ASSERT_EQUAL_INT_MESSAGE(3, runs[i], "Expected each worker to run each job");
+    }
+
+    enigma_executor_free(executor);
+}
+
+void test_enigma_executor_run_WithOneThread(void) {
+    EnigmaExecutor* executor = enigma_executor_new(1);
+
+    enigma_executor_run(executor, count_run, runs);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(1, runs[0], "Expected the calling thread to run the job");
+
+    enigma_executor_free(executor);
+}
+
+void test_enigma_executor_run_WithInvalidArguments(void) {
+    EnigmaExecutor* executor = enigma_executor_new(1);
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_executor_run(NULL, count_run, runs), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_executor_run(executor, NULL, runs), failure);
+
+    enigma_executor_free(executor);
+}
+
+void test_enigma_executor_get_thread_count_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_executor_get_thread_count(NULL), failure);
+}
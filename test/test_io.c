@@ -50,6 +50,24 @@ void              test_enigma_load_config(void) {
                                      "Expected plugboard to match config string");
 }
 
+void test_enigma_load_config_WithRingSettings(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS, enigma_load_config(&enigma, "I II III|XYZ|B|None|BCD"), success);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT_MESSAGE(
+            i + 1, enigma.ring_settings[i], "Expected ring setting to match config string");
+    }
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS, enigma_load_config(&enigma, "I II III|XYZ|B|None"), success);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT_MESSAGE(
+            0, enigma.ring_settings[i], "Expected ring setting to default to 'A'");
+    }
+
+    TEST_ASSERT_EQUAL_INT(ENIGMA_FAILURE, enigma_load_config(&enigma, "I II III|XYZ|B|None|B1D"));
+}
+
 void test_enigma_load_config_WithLengthyString(void) {
     char* configStr = malloc(100);
     for (int i = 0; i < 99; i++) {
@@ -126,6 +144,9 @@ void test_enigma_load_custom_rotor(void) {
     TEST_ASSERT_EQUAL_INT_MESSAGE(rotorNotches[1],
                                   rotor.notches[1],
                                   "Expected notches to match config");
+    TEST_ASSERT_EQUAL_INT_MESSAGE((1 << 16) | (1 << 4),
+                                  rotor.turnovers,
+                                  "Expected turnovers to match notches");
 
     result = enigma_load_custom_rotor(&rotor, invalidRotorAlphabet, rotorName, rotorNotches, 2);
     TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, result, failure);
@@ -301,6 +322,28 @@ void test_enigma_load_reflector_config(void) {
     TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, result, failure);
 }
 
+void test_enigma_load_ring_settings(void) {
+    enigma.rotor_count = 3;
+    memset(enigma.ring_settings, 0, sizeof(enigma.ring_settings));
+
+    int result         = enigma_load_ring_settings(&enigma, "bz");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, result, success);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(1, enigma.ring_settings[0], "Expected ring setting to be set");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(25, enigma.ring_settings[1], "Expected ring setting to be set");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, enigma.ring_settings[2], "Expected ring to be unchanged");
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_load_ring_settings(&enigma, "A?C"), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_load_ring_settings(&enigma, "ABCD"), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_load_ring_settings(&enigma, NULL), failure);
+
+    enigma.rotor_count = 0;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_load_ring_settings(&enigma, "A"), failure);
+    memset(enigma.ring_settings, 0, sizeof(enigma.ring_settings));
+}
+
 void test_enigma_load_rotor_config(void) {
     char buf[64];
     strcpy(buf, "I II III");
@@ -364,3 +407,13 @@ void test_enigma_print_config(void) {
                                      buf,
                                      "Expected configuration string to be printed properly");
 }
+
+void test_enigma_print_config_WithRingSettings(void) {
+    char buf[128];
+
+    TEST_ASSERT_EQUAL_INT(ENIGMA_SUCCESS, enigma_load_config(&enigma, "I II III|ABC|B|None|XAZ"));
+    enigma_print_config(&enigma, buf);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("I II III|ABC|B|None|XAZ",
+                                     buf,
+                                     "Expected ring settings to be printed");
+}
@@ -1,4 +1,5 @@
 #include "enigma/crack.h"
+#include "enigma/enigma.h"
 #include "enigma/ioc.h"
 #include "unity.h"
 
@@ -17,3 +18,37 @@ void test_enigma_ioc_score(void) {
 
     TEST_ASSERT_EQUAL_FLOAT_MESSAGE(score, score2, "Expected IOC scores to be equal");
 }
+
+void test_enigma_ioc_score_indices(void) {
+    EnigmaCrackParams cfg;
+    const char*       text = "HELLOWORLD";
+    uint8_t           indices[10];
+    cfg.ciphertext_length = strlen(text);
+    enigma_text_to_indices(text, indices, strlen(text));
+
+    TEST_ASSERT_EQUAL_FLOAT_MESSAGE(enigma_ioc_score(&cfg, text),
+                                    enigma_ioc_score_indices(&cfg, indices),
+                                    "Expected IOC scores to be equal");
+}
+
+void test_enigma_ioc_score_batch(void) {
+    EnigmaCrackParams cfg;
+    const char*       texts[] = { "HELLOWORLD", "ABCDEFGHIJ", "AAAAABBBBB",
+                                  "ZZZZZZZZZZ", "ENIGMAXXXX", "QWERTYUIOP",
+                                  "MISSISSIPP", "BANANABANA", "ATTACKDAWN" };
+    int               count   = sizeof(texts) / sizeof(texts[0]);
+    uint8_t           indices[9 * 10];
+    float             scores[9];
+    cfg.ciphertext_length = 10;
+    for (int i = 0; i < count; i++) {
+        enigma_text_to_indices(texts[i], indices + i * 10, 10);
+    }
+
+    // More candidates than ENIGMA_SCORE_BATCH_LANES, so the last lane group is partial
+    enigma_ioc_score_batch(&cfg, indices, count, scores);
+    for (int i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL_FLOAT_MESSAGE(enigma_ioc_score_indices(&cfg, indices + i * 10),
+                                        scores[i],
+                                        "Expected IOC scores to be equal");
+    }
+}
@@ -0,0 +1,149 @@
+#include "enigma/common.h"
+#include "enigma/enigma.h"
+#include "enigma/kernel.h"
+#include "unity.h"
+
+#include <string.h>
+
+const char* success = "Expected success";
+const char* failure = "Expected failure";
+
+Enigma      enigma;
+uint8_t     input[200];
+
+void        setUp(void) {
+    enigma_init_default_config(&enigma);
+    enigma_set_plugboard(&enigma, "AZBYCXDW");
+
+    for (size_t i = 0; i < sizeof(input); i++) {
+        input[i] = (i * 7 + i / 3) % ENIGMA_ALPHA_SIZE;
+    }
+}
+
+void tearDown(void) {}
+
+/**
+ * Encode `input` with the kernel and with enigma_encode_index(), and compare the output and
+ * the final rotor positions.
+ */
+static void assert_kernel_matches(void) {
+    Enigma  expected = enigma;
+    uint8_t expectedOutput[sizeof(input)];
+    uint8_t output[sizeof(input)];
+
+    for (size_t i = 0; i < sizeof(input); i++) {
+        expectedOutput[i] = enigma_encode_index(&expected, input[i]);
+    }
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS,
+        enigma_kernel_encode_indices(&enigma, input, output, sizeof(input)),
+        success);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(expectedOutput,
+                                          output,
+                                          sizeof(input),
+                                          "Expected output to match enigma_encode_index()");
+    TEST_ASSERT_EQUAL_INT_ARRAY_MESSAGE(
+        expected.rotor_indices, enigma.rotor_indices, 4, "Expected rotor indices to match");
+}
+
+void test_enigma_kernel_encode_indices(void) {
+    if (!enigma_kernel_count()) {
+        TEST_IGNORE_MESSAGE("Built without kernels");
+    }
+
+    for (int a = 0; a < ENIGMA_ROTOR_COUNT; a++) {
+        for (int b = 0; b < ENIGMA_ROTOR_COUNT; b++) {
+            for (int c = 0; c < ENIGMA_ROTOR_COUNT; c++) {
+                if (a == b || a == c || b == c) {
+                    continue;
+                }
+
+                enigma_set_rotor_count(&enigma, 3 + (a + b + c) % 2);
+                enigma_set_rotor(&enigma, a, 0);
+                enigma_set_rotor(&enigma, b, 1);
+                enigma_set_rotor(&enigma, c, 2);
+                enigma_set_rotor(&enigma, (a + b + c) % ENIGMA_ROTOR_COUNT, 3);
+                enigma_set_reflector(&enigma, (a + c) % ENIGMA_REFLECTOR_COUNT);
+                for (int r = 0; r < 4; r++) {
+                    enigma_set_rotor_index(&enigma, r, (a * 5 + b * 3 + c + r * 11) % 26);
+                }
+                assert_kernel_matches();
+            }
+        }
+    }
+}
+
+void test_enigma_kernel_encode_indices_WithCustomRotor(void) {
+    EnigmaRotor custom = *enigma.rotors[0];
+
+    if (!enigma_kernel_count()) {
+        TEST_IGNORE_MESSAGE("Built without kernels");
+    }
+
+    // Copies of standard rotors still have a kernel
+    enigma.rotors[0] = &custom;
+    assert_kernel_matches();
+
+    // Custom wiring in the first three slots has none
+    custom.fwd_indices[0] = custom.fwd_indices[1];
+    uint8_t output[sizeof(input)];
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE,
+        enigma_kernel_encode_indices(&enigma, input, output, sizeof(input)),
+        failure);
+
+    // Repeated rotors have none either
+    enigma_set_rotor(&enigma, 1, 0);
+    enigma_set_rotor(&enigma, 1, 1);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE,
+        enigma_kernel_encode_indices(&enigma, input, output, sizeof(input)),
+        failure);
+}
+
+void test_enigma_kernel_encode_indices_WithRotorCount(void) {
+    uint8_t output[sizeof(input)];
+    char    expected[sizeof(input)];
+
+    // A two-rotor machine with a third rotor left over in its slot has no kernel
+    enigma_set_rotor_count(&enigma, 2);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE,
+        enigma_kernel_encode_indices(&enigma, input, output, sizeof(input)),
+        failure);
+
+    // The generic path encodes it like enigma_encode()
+    Enigma copy = enigma;
+    for (size_t i = 0; i < sizeof(input); i++) {
+        expected[i] = enigma_encode(&copy, input[i] + 'A') - 'A';
+    }
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS, enigma_encode_indices(&enigma, input, output, sizeof(input)), success);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(
+        expected, output, sizeof(input), "Expected output to match enigma_encode()");
+}
+
+void test_enigma_kernel_encode_indices_WithRingSettings(void) {
+    if (!enigma_kernel_count()) {
+        TEST_IGNORE_MESSAGE("Built without kernels");
+    }
+
+    for (int n = 0; n < 40; n++) {
+        enigma_set_rotor_count(&enigma, 3 + n % 2);
+        enigma_set_rotor(&enigma, n % ENIGMA_ROTOR_COUNT, 0);
+        enigma_set_rotor(&enigma, (n + 3) % ENIGMA_ROTOR_COUNT, 1);
+        enigma_set_rotor(&enigma, (n + 5) % ENIGMA_ROTOR_COUNT, 2);
+        enigma_set_rotor(&enigma, (n + 6) % ENIGMA_ROTOR_COUNT, 3);
+        for (int r = 0; r < enigma.rotor_count; r++) {
+            enigma_set_rotor_index(&enigma, r, (n * 3 + r * 7) % ENIGMA_ALPHA_SIZE);
+            enigma_set_ring_setting(&enigma, r, (n * 11 + r * 5) % ENIGMA_ALPHA_SIZE);
+        }
+        assert_kernel_matches();
+    }
+}
+
+void test_enigma_kernel_count(void) {
+    int count = enigma_kernel_count();
+    TEST_ASSERT_TRUE_MESSAGE(count == 0 || count == 336, "Expected 0 or 336 kernels");
+}
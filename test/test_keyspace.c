@@ -0,0 +1,205 @@
+#include "enigma/common.h"
+#include "enigma/executor.h"
+#include "enigma/keyspace.h"
+#include "unity.h"
+
+#include <string.h>
+
+#define THREAD_COUNT 4
+#define RANGE_COUNT  100
+
+const char*    success = "Expected success";
+const char*    failure = "Expected failure";
+
+EnigmaKeyspace keyspace;
+int            taken[RANGE_COUNT];
+
+void           setUp(void) { memset(taken, 0, sizeof(taken)); }
+void           tearDown(void) {}
+
+static void    take_ranges(void* arg, int index) {
+    EnigmaKeyspace* ks = arg;
+    size_t          range;
+
+    while (enigma_keyspace_next(ks, index, &range) == 1) {
+        taken[range]++;
+    }
+}
+
+void test_enigma_keyspace_init(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS, enigma_keyspace_init(&keyspace, 1000, 10, THREAD_COUNT), success);
+    TEST_ASSERT_EQUAL_size_t(RANGE_COUNT, enigma_keyspace_get_range_count(&keyspace));
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, enigma_keyspace_free(&keyspace), success);
+}
+
+void test_enigma_keyspace_init_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_keyspace_init(NULL, 1000, 10, THREAD_COUNT), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_keyspace_init(&keyspace, 1000, 0, THREAD_COUNT), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_keyspace_init(&keyspace, 1000, 10, 0), failure);
+}
+
+void test_enigma_keyspace_free_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_keyspace_free(NULL), failure);
+}
+
+void test_enigma_keyspace_get_range(void) {
+    size_t first;
+    size_t last;
+
+    enigma_keyspace_init(&keyspace, 995, 10, THREAD_COUNT);
+    TEST_ASSERT_EQUAL_size_t(RANGE_COUNT, enigma_keyspace_get_range_count(&keyspace));
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS, enigma_keyspace_get_range(&keyspace, 3, &first, &last), success);
+    TEST_ASSERT_EQUAL_size_t(30, first);
+    TEST_ASSERT_EQUAL_size_t(40, last);
+
+    // The last range is cut short at the end of the keyspace
+    enigma_keyspace_get_range(&keyspace, RANGE_COUNT - 1, &first, &last);
+    TEST_ASSERT_EQUAL_size_t(990, first);
+    TEST_ASSERT_EQUAL_size_t(995, last);
+
+    enigma_keyspace_free(&keyspace);
+}
+
+void test_enigma_keyspace_get_range_WithInvalidArguments(void) {
+    size_t first;
+    size_t last;
+
+    enigma_keyspace_init(&keyspace, 1000, 10, THREAD_COUNT);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_keyspace_get_range(NULL, 0, &first, &last), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_keyspace_get_range(&keyspace, 0, NULL, &last), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_keyspace_get_range(&keyspace, 0, &first, NULL), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_keyspace_get_range(&keyspace, RANGE_COUNT, &first, &last), failure);
+    enigma_keyspace_free(&keyspace);
+}
+
+void test_enigma_keyspace_next(void) {
+    size_t range;
+
+    enigma_keyspace_init(&keyspace, 1000, 10, THREAD_COUNT);
+
+    // Each worker starts with a contiguous share of the ranges
+    TEST_ASSERT_EQUAL_INT(1, enigma_keyspace_next(&keyspace, 0, &range));
+    TEST_ASSERT_EQUAL_size_t(0, range);
+    TEST_ASSERT_EQUAL_INT(1, enigma_keyspace_next(&keyspace, 1, &range));
+    TEST_ASSERT_EQUAL_size_t(RANGE_COUNT / THREAD_COUNT, range);
+    TEST_ASSERT_EQUAL_INT(1, enigma_keyspace_next(&keyspace, 0, &range));
+    TEST_ASSERT_EQUAL_size_t(1, range);
+
+    enigma_keyspace_free(&keyspace);
+}
+
+void test_enigma_keyspace_next_WithStealing(void) {
+    enigma_keyspace_init(&keyspace, 1000, 10, THREAD_COUNT);
+
+    // A single worker steals the other workers' ranges once its own are done
+    take_ranges(&keyspace, 0);
+    for (int i = 0; i < RANGE_COUNT; i++) {
+        TEST_ASSERT_EQUAL_INT_MESSAGE(1, taken[i], "Expected every range to be taken once");
+    }
+
+    size_t range;
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        TEST_ASSERT_EQUAL_INT(0, enigma_keyspace_next(&keyspace, i, &range));
+    }
+
+    enigma_keyspace_free(&keyspace);
+}
+
+void test_enigma_keyspace_next_WithExecutor(void) {
+    EnigmaExecutor* executor = enigma_executor_new(THREAD_COUNT);
+
+    enigma_keyspace_init(&keyspace, 1000, 10, THREAD_COUNT);
+    enigma_executor_run(executor, take_ranges, &keyspace);
+    for (int i = 0; i < RANGE_COUNT; i++) {
+        TEST_ASSERT_EQUAL_INT_MESSAGE(1, taken[i], "Expected every range to be taken once");
+    }
+
+    enigma_keyspace_free(&keyspace);
+    enigma_executor_free(executor);
+}
+
+void test_enigma_keyspace_next_WithInvalidArguments(void) {
+    size_t range;
+
+    enigma_keyspace_init(&keyspace, 1000, 10, THREAD_COUNT);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_keyspace_next(NULL, 0, &range), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_keyspace_next(&keyspace, 0, NULL), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_keyspace_next(&keyspace, -1, &range), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_keyspace_next(&keyspace, THREAD_COUNT, &range), failure);
+    enigma_keyspace_free(&keyspace);
+}
+
+void test_enigma_keyspace_shard(void) {
+    int owner[RANGE_COUNT];
+
+    // Every range belongs to exactly one shard, and the shards are contiguous
+    for (int s = 0; s < THREAD_COUNT; s++) {
+        memset(taken, 0, sizeof(taken));
+        enigma_keyspace_init(&keyspace, 1000, 10, 2);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(
+            ENIGMA_SUCCESS, enigma_keyspace_shard(&keyspace, NULL, s, THREAD_COUNT), success);
+        take_ranges(&keyspace, 0);
+        for (int i = 0; i < RANGE_COUNT; i++) {
+            if (taken[i]) {
+                owner[i] = s;
+            }
+        }
+        enigma_keyspace_free(&keyspace);
+    }
+    for (int i = 0; i < RANGE_COUNT; i++) {
+        TEST_ASSERT_EQUAL_INT(i * THREAD_COUNT / RANGE_COUNT, owner[i]);
+    }
+}
+
+void test_enigma_keyspace_shard_WithWork(void) {
+    size_t work[RANGE_COUNT];
+    int    counts[THREAD_COUNT] = { 0 };
+
+    // The first half of the ranges hold all the work, so they are split between the shards
+    for (int i = 0; i < RANGE_COUNT; i++) {
+        work[i] = i < RANGE_COUNT / 2 ? 10 : 0;
+    }
+    for (int s = 0; s < THREAD_COUNT; s++) {
+        memset(taken, 0, sizeof(taken));
+        enigma_keyspace_init(&keyspace, 1000, 10, 2);
+        enigma_keyspace_shard(&keyspace, work, s, THREAD_COUNT);
+        take_ranges(&keyspace, 0);
+        for (int i = 0; i < RANGE_COUNT / 2; i++) {
+            counts[s] += taken[i];
+        }
+        enigma_keyspace_free(&keyspace);
+    }
+    for (int s = 0; s < THREAD_COUNT; s++) {
+        TEST_ASSERT_INT_WITHIN_MESSAGE(
+            1, RANGE_COUNT / 2 / THREAD_COUNT, counts[s], "Expected balanced shards");
+    }
+}
+
+void test_enigma_keyspace_shard_WithInvalidArguments(void) {
+    enigma_keyspace_init(&keyspace, 1000, 10, THREAD_COUNT);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_keyspace_shard(NULL, NULL, 0, 2), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_keyspace_shard(&keyspace, NULL, 0, 0), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_keyspace_shard(&keyspace, NULL, -1, 2), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_keyspace_shard(&keyspace, NULL, 2, 2), failure);
+    enigma_keyspace_free(&keyspace);
+}
+
+void test_enigma_keyspace_get_range_count_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_size_t((size_t) ENIGMA_FAILURE, enigma_keyspace_get_range_count(NULL));
+}
@@ -1,4 +1,5 @@
 #include "enigma/crack.h"
+#include "enigma/enigma.h"
 #include "enigma/ngram.h"
 #include "unity.h"
 
@@ -80,3 +81,69 @@ void test_enigma_quadgram_score(void) {
 
     free(cfg.ngrams);
 }
+
+void test_enigma_ngram_score_indices(void) {
+    uint8_t* indices = malloc(cfg.ciphertext_length);
+    cfg.ngrams       = calloc((26 << 15) | (26 << 10) | (26 << 5) | 26, sizeof(float));
+    enigma_text_to_indices(plaintext, indices, cfg.ciphertext_length);
+
+    loadNgrams(2);
+    TEST_ASSERT_EQUAL_FLOAT_MESSAGE(enigma_bigram_score(&cfg, plaintext),
+                                    enigma_bigram_score_indices(&cfg, indices),
+                                    "Expected bigram scores to be equal");
+
+    loadNgrams(3);
+    TEST_ASSERT_EQUAL_FLOAT_MESSAGE(enigma_trigram_score(&cfg, plaintext),
+                                    enigma_trigram_score_indices(&cfg, indices),
+                                    "Expected trigram scores to be equal");
+
+    loadNgrams(4);
+    TEST_ASSERT_EQUAL_FLOAT_MESSAGE(enigma_quadgram_score(&cfg, plaintext),
+                                    enigma_quadgram_score_indices(&cfg, indices),
+                                    "Expected quadgram scores to be equal");
+
+    free(indices);
+    free(cfg.ngrams);
+}
+
+void test_enigma_ngram_score_batch(void) {
+    int      count   = 9;
+    size_t   length  = cfg.ciphertext_length;
+    uint8_t* indices = malloc(count * length);
+    float    scores[9];
+    cfg.ngrams = calloc((26 << 15) | (26 << 10) | (26 << 5) | 26, sizeof(float));
+
+    // Each candidate is the plaintext rotated by a different amount
+    for (int i = 0; i < count; i++) {
+        for (size_t j = 0; j < length; j++) {
+            indices[i * length + j] = I(plaintext[(i * 7 + j) % length]);
+        }
+    }
+
+    loadNgrams(2);
+    enigma_bigram_score_batch(&cfg, indices, count, scores);
+    for (int i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL_FLOAT_MESSAGE(enigma_bigram_score_indices(&cfg, indices + i * length),
+                                        scores[i],
+                                        "Expected bigram scores to be equal");
+    }
+
+    loadNgrams(3);
+    enigma_trigram_score_batch(&cfg, indices, count, scores);
+    for (int i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL_FLOAT_MESSAGE(enigma_trigram_score_indices(&cfg, indices + i * length),
+                                        scores[i],
+                                        "Expected trigram scores to be equal");
+    }
+
+    loadNgrams(4);
+    enigma_quadgram_score_batch(&cfg, indices, count, scores);
+    for (int i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL_FLOAT_MESSAGE(enigma_quadgram_score_indices(&cfg, indices + i * length),
+                                        scores[i],
+                                        "Expected quadgram scores to be equal");
+    }
+
+    free(indices);
+    free(cfg.ngrams);
+}
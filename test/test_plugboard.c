@@ -0,0 +1,274 @@
+#include "enigma/common.h"
+#include "enigma/crack.h"
+#include "enigma/enigma.h"
+#include "enigma/executor.h"
+#include "enigma/ioc.h"
+#include "enigma/ngram.h"
+#include "enigma/plugboard.h"
+#include "enigma/score.h"
+#include "unity.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRIGRAM_COUNT (ENIGMA_TRIIDX(25, 25, 25) + 1)
+
+EnigmaCrackParams cfg;
+EnigmaScoreList   scores;
+float*            trigrams;
+char*             ciphertext;
+
+const char*       plaintext =
+    "ITWASTHEBESTOFTIMESITWASTHEWORSTOFTIMESITWASTHEAGEOFWISDOMITWASTHEAGEOFFOOLISHNESS"
+    "ITWASTHEEPOCHOFBELIEFITWASTHEEPOCHOFINCREDULITYITWASTHESEASONOFLIGHTITWASTHESEASON"
+    "OFDARKNESSITWASTHESPRINGOFHOPEITWASTHEWINTEROFDESPAIRWEHADEVERYTHINGBEFOREUSWEHAD"
+    "NOTHINGBEFOREUSWEWEREALLGOINGDIRECTTOHEAVENWEWEREALLGOINGDIRECTTHEOTHERWAYINSHORT";
+const char* success = "Expected success";
+const char* failure = "Expected failure";
+
+void        setUp(void) {
+    memset(&cfg, 0, sizeof(EnigmaCrackParams));
+    memset(&scores, 0, sizeof(EnigmaScoreList));
+    enigma_init_default_config(&cfg.enigma);
+    enigma_score_list_set_top_k(&scores, 1);
+    cfg.score_list = &scores;
+
+    // Score trigrams by their log frequency in the plaintext itself
+    size_t length = strlen(plaintext);
+    trigrams      = calloc(TRIGRAM_COUNT, sizeof(float));
+    for (size_t i = 2; i < length; i++) {
+        int a = plaintext[i - 2] - 'A';
+        int b = plaintext[i - 1] - 'A';
+        int c = plaintext[i] - 'A';
+        trigrams[ENIGMA_TRIIDX(a, b, c)] += 1.0f;
+    }
+    for (size_t i = 0; i < TRIGRAM_COUNT; i++) {
+        trigrams[i] = logf((trigrams[i] + 0.1f) / length);
+    }
+    cfg.ngrams        = trigrams;
+    cfg.n             = 3;
+    cfg.ngrams_length = TRIGRAM_COUNT;
+
+    ciphertext        = malloc(length + 1);
+    cfg.ciphertext    = ciphertext;
+    cfg.ciphertext_length = length;
+}
+
+void tearDown(void) {
+    free(scores.scores);
+    free(trigrams);
+    free(ciphertext);
+}
+
+/**
+ * Encrypt the plaintext under the default configuration with the given plugboard.
+ */
+void encrypt(const char* plugboard) {
+    Enigma enigma = cfg.enigma;
+    enigma_set_plugboard(&enigma, plugboard);
+    enigma_encode_string(&enigma, plaintext, ciphertext, cfg.ciphertext_length);
+    ciphertext[cfg.ciphertext_length] = '\0';
+}
+
+/**
+ * Decode the ciphertext under the best configuration found.
+ */
+char* decode_best(void) {
+    Enigma enigma = scores.scores[0].enigma;
+    char*  text   = malloc(cfg.ciphertext_length + 1);
+    enigma_encode_string(&enigma, ciphertext, text, cfg.ciphertext_length);
+    text[cfg.ciphertext_length] = '\0';
+    return text;
+}
+
+/**
+ * Score the share of E's, so that only full rescoring can be used.
+ */
+float e_score(const EnigmaCrackParams* config, const char* text) {
+    int count = 0;
+    for (size_t i = 0; i < config->ciphertext_length; i++) {
+        count += text[i] == 'E';
+    }
+    return (float) count / config->ciphertext_length;
+}
+
+void test_enigma_crack_plugboard_anneal(void) {
+    // Too short for hill climbing from an empty plugboard to find all eight pairs
+    EnigmaAnnealParams anneal = { 0 };
+    anneal.restarts           = 16;
+    anneal.seed               = 1;
+    encrypt("AQEMTZBXHKOSCDFG");
+    cfg.ciphertext_length = 60;
+    enigma_score_list_set_top_k(&scores, 4);
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS,
+        enigma_crack_plugboard_anneal(&cfg, &anneal, enigma_trigram_score),
+        success);
+    TEST_ASSERT_EQUAL_INT(4, scores.score_count);
+
+    enigma_score_list_sort(&scores);
+    TEST_ASSERT_EQUAL_STRING("AQBXCDEMFGHKOSTZ", scores.scores[0].enigma.plugboard);
+    for (int i = 1; i < scores.score_count; i++) {
+        TEST_ASSERT_TRUE(scores.scores[i - 1].score >= scores.scores[i].score);
+        TEST_ASSERT_FALSE(
+            strcmp(scores.scores[i - 1].enigma.plugboard, scores.scores[i].enigma.plugboard) == 0);
+    }
+}
+
+void test_enigma_crack_plugboard_anneal_WithExecutor(void) {
+    EnigmaAnnealParams anneal = { 0 };
+    EnigmaScoreList    serial = { 0 };
+    anneal.restarts           = 6;
+    anneal.steps              = 2000;
+    anneal.seed               = 42;
+    encrypt("AQEMTZBXHKOS");
+    cfg.ciphertext_length = 60;
+    cfg.score_list        = &serial;
+    enigma_score_list_set_top_k(&serial, 6);
+    enigma_score_list_set_top_k(&scores, 6);
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS,
+        enigma_crack_plugboard_anneal(&cfg, &anneal, enigma_trigram_score),
+        success);
+
+    // Each restart only depends on the seed and its index, not on the worker running it
+    cfg.score_list = &scores;
+    cfg.executor   = enigma_executor_new(3);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS,
+        enigma_crack_plugboard_anneal(&cfg, &anneal, enigma_trigram_score),
+        success);
+    enigma_executor_free(cfg.executor);
+
+    enigma_score_list_sort(&serial);
+    enigma_score_list_sort(&scores);
+    TEST_ASSERT_EQUAL_INT(serial.score_count, scores.score_count);
+    for (int i = 0; i < scores.score_count; i++) {
+        TEST_ASSERT_EQUAL_FLOAT(serial.scores[i].score, scores.scores[i].score);
+        TEST_ASSERT_EQUAL_STRING(serial.scores[i].enigma.plugboard,
+                                 scores.scores[i].enigma.plugboard);
+    }
+    free(serial.scores);
+}
+
+void test_enigma_crack_plugboard_anneal_WithMoves(void) {
+    // Removing pairs is all that is allowed, so nothing can be plugged into an empty plugboard
+    EnigmaAnnealParams anneal = { 0 };
+    anneal.restarts           = 2;
+    anneal.steps              = 500;
+    anneal.moves              = ENIGMA_PLUGBOARD_MOVE_REMOVE;
+    encrypt("AQEMTZ");
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS, enigma_crack_plugboard_anneal(&cfg, &anneal, enigma_ioc_score), success);
+    TEST_ASSERT_EQUAL_INT(1, scores.score_count);
+    TEST_ASSERT_EQUAL_STRING("", scores.scores[0].enigma.plugboard);
+}
+
+void test_enigma_crack_plugboard_anneal_WithInvalidArguments(void) {
+    EnigmaAnnealParams anneal = { 0 };
+    encrypt("");
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_crack_plugboard_anneal(NULL, NULL, enigma_ioc_score), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_crack_plugboard_anneal(&cfg, NULL, NULL), failure);
+
+    anneal.restarts = -1;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_crack_plugboard_anneal(&cfg, &anneal, enigma_ioc_score), failure);
+
+    anneal.restarts          = 0;
+    anneal.start_temperature = -1.0;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_crack_plugboard_anneal(&cfg, &anneal, enigma_ioc_score), failure);
+
+    anneal.start_temperature = 0.0;
+    anneal.moves             = 16;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_crack_plugboard_anneal(&cfg, &anneal, enigma_ioc_score), failure);
+
+    anneal.moves  = 0;
+    ciphertext[0] = '1';
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_crack_plugboard_anneal(&cfg, &anneal, enigma_ioc_score), failure);
+    TEST_ASSERT_EQUAL_INT(0, scores.score_count);
+}
+
+void test_enigma_crack_plugboard_climb(void) {
+    encrypt("AQEMTZBXHKOS");
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS, enigma_crack_plugboard_climb(&cfg, enigma_trigram_score), success);
+    TEST_ASSERT_EQUAL_INT(1, scores.score_count);
+
+    // The score is computed in full, so it matches the incremental totals only if they agree
+    char* text = decode_best();
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(plaintext, text, "Expected the plaintext to be recovered");
+    TEST_ASSERT_EQUAL_size_t(12, strlen(scores.scores[0].enigma.plugboard));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, enigma_trigram_score(&cfg, text), scores.scores[0].score);
+    free(text);
+}
+
+void test_enigma_crack_plugboard_climb_WithWrongPlugboard(void) {
+    // Recovering the plugboard needs removing, moving and swapping the given pairs
+    char start[] = "AMEQTZCD";
+    encrypt("AQEMTZ");
+    enigma_set_plugboard(&cfg.enigma, start);
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS, enigma_crack_plugboard_climb(&cfg, enigma_trigram_score), success);
+
+    char* text = decode_best();
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(plaintext, text, "Expected the plaintext to be recovered");
+    TEST_ASSERT_EQUAL_STRING("AQEMTZ", scores.scores[0].enigma.plugboard);
+    free(text);
+}
+
+void test_enigma_crack_plugboard_climb_WithOtherScoreFunctions(void) {
+    encrypt("AQEMTZ");
+
+    // IoC is rescored from letter counts, any other function from the whole text
+    float (*funcs[])(const EnigmaCrackParams*, const char*) = { enigma_ioc_score, e_score };
+    for (size_t i = 0; i < sizeof(funcs) / sizeof(funcs[0]); i++) {
+        scores.score_count = 0;
+        float start        = funcs[i](&cfg, ciphertext);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(
+            ENIGMA_SUCCESS, enigma_crack_plugboard_climb(&cfg, funcs[i]), success);
+
+        char* text = decode_best();
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f, funcs[i](&cfg, text), scores.scores[0].score);
+        TEST_ASSERT_TRUE(scores.scores[0].score >= start);
+        TEST_ASSERT_TRUE(strlen(scores.scores[0].enigma.plugboard)
+                         <= 2 * ENIGMA_MAX_PLUGBOARD_SETTINGS);
+        free(text);
+    }
+}
+
+void test_enigma_crack_plugboard_climb_WithInvalidArguments(void) {
+    encrypt("");
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_crack_plugboard_climb(NULL, enigma_trigram_score), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_crack_plugboard_climb(&cfg, NULL), failure);
+
+    // The ciphertext must only hold letters
+    ciphertext[0] = '?';
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_crack_plugboard_climb(&cfg, enigma_trigram_score), failure);
+
+    ciphertext[0] = 'A';
+    strcpy(cfg.enigma.plugboard, "AB1");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_crack_plugboard_climb(&cfg, enigma_trigram_score), failure);
+
+    cfg.enigma.plugboard[0] = '\0';
+    cfg.score_list          = NULL;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_crack_plugboard_climb(&cfg, enigma_trigram_score), failure);
+    TEST_ASSERT_EQUAL_INT(0, scores.score_count);
+}
@@ -0,0 +1,135 @@
+#include "enigma/common.h"
+#include "enigma/crack.h"
+#include "enigma/enigma.h"
+#include "enigma/ioc.h"
+#include "enigma/process.h"
+#include "enigma/score.h"
+#include "enigma/sink.h"
+#include "unity.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define PROCESS_COUNT 3
+#define TOP_K         5
+
+const char*       success   = "Expected success";
+const char*       failure   = "Expected failure";
+const char*       alphaText = "THEXQUICKXBROWNXFOXXJUMPSXOVERXTHEXLAZYXDOG";
+
+EnigmaCrackParams cfg;
+EnigmaScoreList   scores;
+float             best[TOP_K];
+
+void              setUp(void) {
+    memset(&cfg, 0, sizeof(EnigmaCrackParams));
+    memset(&scores, 0, sizeof(EnigmaScoreList));
+    enigma_init_default_config(&cfg.enigma);
+    cfg.ciphertext        = alphaText;
+    cfg.ciphertext_length = strlen(alphaText);
+    cfg.score_list        = &scores;
+    enigma_score_list_set_top_k(&scores, TOP_K);
+
+    // The best scores of a search on the calling thread
+    enigma_crack_rotor_positions(&cfg, enigma_ioc_score);
+    enigma_score_list_sort(&scores);
+    for (int i = 0; i < TOP_K; i++) {
+        best[i] = scores.scores[i].score;
+    }
+    scores.score_count = 0;
+    enigma_score_list_set_top_k(&scores, TOP_K);
+}
+
+void       tearDown(void) { free(scores.scores); }
+
+static void skip_without_processes(void) {
+#ifndef ENIGMA_PROCESSES
+    TEST_IGNORE_MESSAGE("Built without worker processes");
+#endif
+}
+
+static int crack_rotor_positions(EnigmaCrackParams* params, void* arg) {
+    return enigma_crack_rotor_positions(params, enigma_ioc_score);
+}
+
+static int crack_shard(EnigmaCrackParams* params, void* arg) {
+    // Fail in one of the workers
+    if (params->shard == *(int*) arg) {
+        return ENIGMA_FAILURE;
+    }
+    return enigma_crack_rotor_positions(params, enigma_ioc_score);
+}
+
+static void assert_best_scores(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(TOP_K, scores.score_count, "Expected top-K scores");
+    enigma_score_list_sort(&scores);
+    for (int i = 0; i < TOP_K; i++) {
+        TEST_ASSERT_EQUAL_FLOAT_MESSAGE(
+            best[i], scores.scores[i].score, "Expected the best scores");
+    }
+}
+
+void test_enigma_process_crack(void) {
+    skip_without_processes();
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS,
+        enigma_process_crack(&cfg, PROCESS_COUNT, crack_rotor_positions, NULL),
+        success);
+    assert_best_scores();
+
+    // The configurations published by the workers are usable in the caller
+    char plaintext[64] = { 0 };
+    enigma_encode_string(&scores.scores[0].enigma, alphaText, plaintext, cfg.ciphertext_length);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, best[0], enigma_ioc_score(&cfg, plaintext));
+}
+
+void test_enigma_process_crack_WithShards(void) {
+    skip_without_processes();
+    // Each shard is split between the workers, and the shards together cover the keyspace
+    for (int s = 0; s < 2; s++) {
+        enigma_crack_set_shard(&cfg, s, 2);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(
+            ENIGMA_SUCCESS,
+            enigma_process_crack(&cfg, PROCESS_COUNT, crack_rotor_positions, NULL),
+            success);
+    }
+    assert_best_scores();
+}
+
+void test_enigma_process_crack_WithFailingWorker(void) {
+    int failing = 1;
+
+    skip_without_processes();
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_process_crack(&cfg, PROCESS_COUNT, crack_shard, &failing), failure);
+    TEST_ASSERT_TRUE_MESSAGE(scores.score_count > 0, "Expected the other workers' scores");
+}
+
+void test_enigma_process_crack_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE,
+        enigma_process_crack(NULL, PROCESS_COUNT, crack_rotor_positions, NULL),
+        failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_process_crack(&cfg, 0, crack_rotor_positions, NULL), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE, enigma_process_crack(&cfg, PROCESS_COUNT, NULL, NULL), failure);
+
+    // Every score cannot be kept in bounded shared memory
+    scores.top_k = 0;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE,
+        enigma_process_crack(&cfg, PROCESS_COUNT, crack_rotor_positions, NULL),
+        failure);
+    scores.top_k = TOP_K;
+
+    EnigmaSink* sink = enigma_sink_new_count();
+    cfg.sink         = sink;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_FAILURE,
+        enigma_process_crack(&cfg, PROCESS_COUNT, crack_rotor_positions, NULL),
+        failure);
+    cfg.sink = NULL;
+    enigma_sink_free(sink);
+}
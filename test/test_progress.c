@@ -0,0 +1,88 @@
+#include "enigma/common.h"
+#include "enigma/progress.h"
+#include "unity.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+const char*     success = "Expected success";
+const char*     failure = "Expected failure";
+
+EnigmaProgress* progress;
+
+void            setUp(void) { progress = enigma_progress_new(); }
+
+void            tearDown(void) { enigma_progress_free(progress); }
+
+void            test_enigma_progress_new(void) {
+    TEST_ASSERT_NOT_NULL(progress);
+    TEST_ASSERT_EQUAL_size_t(0, enigma_progress_get_total(progress));
+    TEST_ASSERT_EQUAL_size_t(0, enigma_progress_get_searched(progress));
+    TEST_ASSERT_EQUAL_size_t(0, enigma_progress_get_candidates(progress));
+    TEST_ASSERT_EQUAL_size_t(0, enigma_progress_get_characters(progress));
+    TEST_ASSERT_EQUAL_INT(0, enigma_progress_is_cancelled(progress));
+    TEST_ASSERT_TRUE(enigma_progress_get_elapsed(progress) >= 0.0);
+}
+
+void test_enigma_progress_add(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS, enigma_progress_add_total(progress, 100), success);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS, enigma_progress_add(progress, 40, 30, 300), success);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        ENIGMA_SUCCESS, enigma_progress_add(progress, 10, 5, 50), success);
+
+    TEST_ASSERT_EQUAL_size_t(100, enigma_progress_get_total(progress));
+    TEST_ASSERT_EQUAL_size_t(50, enigma_progress_get_searched(progress));
+    TEST_ASSERT_EQUAL_size_t(50, enigma_progress_get_remaining(progress));
+    TEST_ASSERT_EQUAL_size_t(35, enigma_progress_get_candidates(progress));
+    TEST_ASSERT_EQUAL_size_t(350, enigma_progress_get_characters(progress));
+
+    // A later search adds to the total
+    enigma_progress_add_total(progress, 20);
+    TEST_ASSERT_EQUAL_size_t(70, enigma_progress_get_remaining(progress));
+}
+
+void test_enigma_progress_get_eta(void) {
+    // Nothing to estimate from before the first range completes
+    enigma_progress_add_total(progress, 100);
+    TEST_ASSERT_TRUE(enigma_progress_get_eta(progress) < 0.0);
+
+    // Half the indices took the elapsed time, so the other half takes about as long
+    enigma_progress_add(progress, 50, 50, 500);
+    double eta     = enigma_progress_get_eta(progress);
+    double elapsed = enigma_progress_get_elapsed(progress);
+    TEST_ASSERT_TRUE(eta >= 0.0);
+    TEST_ASSERT_TRUE(eta <= elapsed);
+    TEST_ASSERT_TRUE(enigma_progress_get_rate(progress) > 0.0);
+
+    enigma_progress_add(progress, 50, 50, 500);
+    TEST_ASSERT_TRUE(enigma_progress_get_eta(progress) == 0.0);
+}
+
+void test_enigma_progress_cancel(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, enigma_progress_cancel(progress), success);
+    TEST_ASSERT_EQUAL_INT(1, enigma_progress_is_cancelled(progress));
+
+    // Resetting clears the cancellation along with the counters
+    enigma_progress_add(progress, 10, 10, 100);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, enigma_progress_reset(progress), success);
+    TEST_ASSERT_EQUAL_INT(0, enigma_progress_is_cancelled(progress));
+    TEST_ASSERT_EQUAL_size_t(0, enigma_progress_get_searched(progress));
+}
+
+void test_enigma_progress_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_progress_free(NULL), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_progress_reset(NULL), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_progress_add_total(NULL, 1), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_progress_add(NULL, 1, 1, 1), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_progress_cancel(NULL), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_progress_is_cancelled(NULL), failure);
+    TEST_ASSERT_EQUAL_size_t(0, enigma_progress_get_total(NULL));
+    TEST_ASSERT_EQUAL_size_t(0, enigma_progress_get_searched(NULL));
+    TEST_ASSERT_EQUAL_size_t(0, enigma_progress_get_remaining(NULL));
+    TEST_ASSERT_EQUAL_size_t(0, enigma_progress_get_candidates(NULL));
+    TEST_ASSERT_EQUAL_size_t(0, enigma_progress_get_characters(NULL));
+    TEST_ASSERT_TRUE(enigma_progress_get_rate(NULL) == 0.0);
+    TEST_ASSERT_TRUE(enigma_progress_get_eta(NULL) < 0.0);
+}
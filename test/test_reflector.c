@@ -40,6 +40,23 @@ void test_enigma_reflector_generate_indices_WithInvalidArguments(void) {
                                   failure);
 }
 
+void test_enigma_reflector_id(void) {
+    for (int i = 0; i < ENIGMA_REFLECTOR_COUNT; i++) {
+        EnigmaReflector copy = *enigma_reflectors[i];
+        TEST_ASSERT_EQUAL_INT_MESSAGE(
+            i, enigma_reflector_id(enigma_reflectors[i]), "Expected reflector id");
+        TEST_ASSERT_EQUAL_INT_MESSAGE(i, enigma_reflector_id(&copy), "Expected copies to match");
+    }
+
+    EnigmaReflector custom;
+    enigma_reflector_generate_indices(&custom, "BADCFEHGJILKNMPORQTSVUXWZY");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_reflector_id(&custom), failure);
+}
+
+void test_enigma_reflector_id_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT(-1, enigma_reflector_id(NULL));
+}
+
 // --- enigma_reflector_t getter/setter tests ---
 
 void test_enigma_reflector_get_name(void) {
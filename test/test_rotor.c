@@ -23,6 +23,55 @@ void        test_enigma_rotor_generate_indices_WithValidArguments(void) {
     }
 }
 
+void test_enigma_rotor_update_turnovers(void) {
+    for (int i = 0; i < ENIGMA_ALPHA_SIZE; i++) {
+        rotor.fwd_indices[i] = ENIGMA_ALPHA_SIZE - 1 - i;
+    }
+    rotor.notches[0]    = 25;
+    rotor.notches[1]    = 3;
+    rotor.notches_count = 2;
+
+    int ret             = enigma_rotor_update_turnovers(&rotor);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, ret, success);
+    TEST_ASSERT_EQUAL_INT_MESSAGE((1 << 0) | (1 << 22),
+                                  rotor.turnovers,
+                                  "Expected turnovers at the positions wired to a notch");
+
+    rotor.notches_count = 1;
+    enigma_rotor_update_turnovers(&rotor);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(1 << 0, rotor.turnovers, "Expected unused notch to be ignored");
+}
+
+void test_enigma_rotor_update_turnovers_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT(-1, enigma_rotor_update_turnovers(NULL));
+}
+
+void test_enigma_rotor_update_turnovers_WithStandardRotors(void) {
+    for (int i = 0; i < ENIGMA_ROTOR_COUNT; i++) {
+        EnigmaRotor standard = *enigma_rotors[i];
+        enigma_rotor_update_turnovers(&standard);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(standard.turnovers,
+                                      enigma_rotors[i]->turnovers,
+                                      "Expected precomputed turnovers to match the notches");
+    }
+}
+
+void test_enigma_rotor_id(void) {
+    for (int i = 0; i < ENIGMA_ROTOR_COUNT; i++) {
+        EnigmaRotor copy = *enigma_rotors[i];
+        TEST_ASSERT_EQUAL_INT_MESSAGE(i, enigma_rotor_id(enigma_rotors[i]), "Expected rotor id");
+        TEST_ASSERT_EQUAL_INT_MESSAGE(i, enigma_rotor_id(&copy), "Expected copies to match");
+    }
+
+    EnigmaRotor custom = *enigma_rotors[0];
+    custom.turnovers   = 1;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_rotor_id(&custom), failure);
+}
+
+void test_enigma_rotor_id_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT(-1, enigma_rotor_id(NULL));
+}
+
 void test_enigma_rotor_generate_indices_WithInvalidArguments(void) {
     const char* alphabet = "EKMFLGDQVZNTOWYHXUSPAIBRCJ";
     TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE,
@@ -95,6 +144,28 @@ void test_enigma_rotor_get_notches_count_WithInvalidArguments(void) {
     TEST_ASSERT_EQUAL_INT(-1, enigma_rotor_get_notches_count(NULL));
 }
 
+void test_enigma_rotor_get_ring_turnovers(void) {
+    rotor.turnovers = 1 << 7 | 1 << 25;
+    TEST_ASSERT_EQUAL_INT(1 << 7 | 1 << 25, enigma_rotor_get_ring_turnovers(&rotor, 0));
+    TEST_ASSERT_EQUAL_INT(1 << 6 | 1 << 24, enigma_rotor_get_ring_turnovers(&rotor, 1));
+    TEST_ASSERT_EQUAL_INT(1 << 8 | 1 << 0, enigma_rotor_get_ring_turnovers(&rotor, 25));
+}
+
+void test_enigma_rotor_get_ring_turnovers_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT(-1, enigma_rotor_get_ring_turnovers(NULL, 0));
+    TEST_ASSERT_EQUAL_INT(-1, enigma_rotor_get_ring_turnovers(&rotor, -1));
+    TEST_ASSERT_EQUAL_INT(-1, enigma_rotor_get_ring_turnovers(&rotor, 26));
+}
+
+void test_enigma_rotor_get_turnovers(void) {
+    rotor.turnovers = 1 << 7;
+    TEST_ASSERT_EQUAL_INT(1 << 7, enigma_rotor_get_turnovers(&rotor));
+}
+
+void test_enigma_rotor_get_turnovers_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT(-1, enigma_rotor_get_turnovers(NULL));
+}
+
 void test_enigma_rotor_set_name(void) {
     rotor.name = NULL;
     int ret    = enigma_rotor_set_name(&rotor, "RotorY");
@@ -144,12 +215,14 @@ void test_enigma_rotor_set_rev_indices_WithInvalidArguments(void) {
 }
 
 void test_enigma_rotor_set_notches(void) {
-    int notches[2] = { 7, 13 };
-    int ret        = enigma_rotor_set_notches(&rotor, notches, 2);
+    int notches[2]       = { 7, 13 };
+    rotor.fwd_indices[3] = 7;
+    int ret              = enigma_rotor_set_notches(&rotor, notches, 2);
     TEST_ASSERT_EQUAL_INT(0, ret);
     TEST_ASSERT_EQUAL_INT(7, rotor.notches[0]);
     TEST_ASSERT_EQUAL_INT(13, rotor.notches[1]);
     TEST_ASSERT_EQUAL_INT(2, rotor.notches_count);
+    TEST_ASSERT_EQUAL_INT(1 << 3, rotor.turnovers);
 }
 
 void test_enigma_rotor_set_notches_WithInvalidArguments(void) {
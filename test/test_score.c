@@ -37,6 +37,95 @@ void test_enigma_score_sort_WithInvalidArguments(void) {
     TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_score_list_sort(NULL), failure);
 }
 
+void test_enigma_score_sort_WithTopK(void) {
+    EnigmaScore score = { 0 };
+
+    enigma_score_list_set_top_k(&scores, 5);
+    for (int i = 0; i < 20; i++) {
+        score.score = (float) ((i * 7) % 20);
+        enigma_score_list_push(&scores, &score);
+    }
+
+    // Sorting twice must give the same result
+    enigma_score_list_sort(&scores);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, enigma_score_list_sort(&scores), success);
+    TEST_ASSERT_EQUAL_INT(5, scores.score_count);
+    for (int i = 0; i < scores.score_count; i++) {
+        TEST_ASSERT_EQUAL_FLOAT(19.0f - i, scores.scores[i].score);
+    }
+
+    free(scores.scores);
+}
+
+void test_enigma_score_list_push(void) {
+    EnigmaScore score = { 0 };
+
+    // Pushing without a top-K limit keeps every score, in order, growing the array
+    for (int i = 0; i < 100; i++) {
+        score.score = (float) i;
+        TEST_ASSERT_EQUAL_INT_MESSAGE(
+            ENIGMA_SUCCESS, enigma_score_list_push(&scores, &score), success);
+    }
+    TEST_ASSERT_EQUAL_INT(100, scores.score_count);
+    TEST_ASSERT_TRUE(scores.max_scores >= 100);
+    for (int i = 0; i < scores.score_count; i++) {
+        TEST_ASSERT_EQUAL_FLOAT((float) i, scores.scores[i].score);
+    }
+
+    free(scores.scores);
+}
+
+void test_enigma_score_list_push_WithTopK(void) {
+    EnigmaScore score = { 0 };
+
+    enigma_score_list_set_top_k(&scores, 10);
+    for (int i = 0; i < 1000; i++) {
+        score.score = (float) ((i * 37) % 1000);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(
+            ENIGMA_SUCCESS, enigma_score_list_push(&scores, &score), success);
+    }
+
+    // Only the best scores are kept, and the array never grows past top_k
+    TEST_ASSERT_EQUAL_INT(10, scores.score_count);
+    TEST_ASSERT_TRUE(scores.max_scores <= 10);
+    TEST_ASSERT_EQUAL_FLOAT(990.0f, scores.scores[0].score);
+    for (int i = 0; i < scores.score_count; i++) {
+        TEST_ASSERT_TRUE_MESSAGE(scores.scores[i].score >= 990.0f, "Expected only the best scores");
+    }
+
+    free(scores.scores);
+}
+
+void test_enigma_score_list_push_WithInvalidArguments(void) {
+    EnigmaScore score = { 0 };
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_score_list_push(NULL, &score), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_score_list_push(&scores, NULL), failure);
+}
+
+void test_enigma_score_list_accepts(void) {
+    EnigmaScore score = { 0 };
+
+    TEST_ASSERT_EQUAL_INT(1, enigma_score_list_accepts(&scores, -100.0f));
+
+    enigma_score_list_set_top_k(&scores, 2);
+    score.score = 1.0f;
+    enigma_score_list_push(&scores, &score);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        1, enigma_score_list_accepts(&scores, 0.0f), "Expected a list with room to accept");
+    score.score = 2.0f;
+    enigma_score_list_push(&scores, &score);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        0, enigma_score_list_accepts(&scores, 1.0f), "Expected the floor to be rejected");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(
+        1, enigma_score_list_accepts(&scores, 1.5f), "Expected a higher score to be accepted");
+
+    free(scores.scores);
+}
+
+void test_enigma_score_list_accepts_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_score_list_accepts(NULL, 0.0f), failure);
+}
+
 void test_enigma_score_compare(void) {
     EnigmaScore score1;
     EnigmaScore score2;
@@ -211,3 +300,34 @@ void test_enigma_score_list_set_max_scores_WithInvalidArguments(void) {
     TEST_ASSERT_EQUAL_INT(-1, enigma_score_list_set_max_scores(NULL, 1));
     TEST_ASSERT_EQUAL_INT(-1, enigma_score_list_set_max_scores(&scores, -1));
 }
+
+void test_enigma_score_list_get_top_k(void) {
+    scores.top_k = 10;
+    TEST_ASSERT_EQUAL_INT(10, enigma_score_list_get_top_k(&scores));
+}
+
+void test_enigma_score_list_get_top_k_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT(-1, enigma_score_list_get_top_k(NULL));
+}
+
+void test_enigma_score_list_set_top_k(void) {
+    EnigmaScore score = { 0 };
+    for (int i = 0; i < 20; i++) {
+        score.score = (float) i;
+        enigma_score_list_push(&scores, &score);
+    }
+
+    // Scores already in the list are cut down to the best ones
+    int ret = enigma_score_list_set_top_k(&scores, 3);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(3, scores.top_k);
+    TEST_ASSERT_EQUAL_INT(3, scores.score_count);
+    TEST_ASSERT_EQUAL_FLOAT(17.0f, scores.scores[0].score);
+
+    free(scores.scores);
+}
+
+void test_enigma_score_list_set_top_k_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT(-1, enigma_score_list_set_top_k(NULL, 1));
+    TEST_ASSERT_EQUAL_INT(-1, enigma_score_list_set_top_k(&scores, -1));
+}
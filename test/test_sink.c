@@ -0,0 +1,154 @@
+#include "enigma/common.h"
+#include "enigma/enigma.h"
+#include "enigma/executor.h"
+#include "enigma/io.h"
+#include "enigma/score.h"
+#include "enigma/sink.h"
+#include "unity.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define THREAD_COUNT 4
+#define WRITE_COUNT  1000
+
+const char* success = "Expected success";
+const char* failure = "Expected failure";
+
+EnigmaScore score;
+
+void        setUp(void) {
+    memset(&score, 0, sizeof(EnigmaScore));
+    enigma_init_default_config(&score.enigma);
+}
+
+void       tearDown(void) {}
+
+static int sum_scores(EnigmaSink* sink, const EnigmaScore* s) {
+    *(float*) sink->data += s->score;
+    return ENIGMA_SUCCESS;
+}
+
+static void write_scores(void* arg, int index) {
+    EnigmaSink* sink = arg;
+    for (int i = 0; i < WRITE_COUNT; i++) {
+        enigma_sink_write(sink, &score);
+    }
+}
+
+void test_enigma_sink_new(void) {
+    float       total = 0.0f;
+    EnigmaSink* sink  = enigma_sink_new(sum_scores, &total);
+    TEST_ASSERT_NOT_NULL(sink);
+    TEST_ASSERT_EQUAL_PTR(&total, enigma_sink_get_data(sink));
+
+    score.score = 0.25f;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, enigma_sink_write(sink, &score), success);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, enigma_sink_write(sink, &score), success);
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, total);
+    TEST_ASSERT_EQUAL_UINT(2, enigma_sink_get_count(sink));
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, enigma_sink_free(sink), success);
+}
+
+void test_enigma_sink_new_count(void) {
+    EnigmaSink* sink = enigma_sink_new_count();
+    TEST_ASSERT_NOT_NULL(sink);
+
+    for (int i = 0; i < 3; i++) {
+        enigma_sink_write(sink, &score);
+    }
+    TEST_ASSERT_EQUAL_UINT(3, enigma_sink_get_count(sink));
+    enigma_sink_free(sink);
+}
+
+void test_enigma_sink_new_file(void) {
+    FILE*       file = tmpfile();
+    EnigmaSink* sink = enigma_sink_new_file(file, 0.5f);
+    char        line[128];
+    char        expected[128];
+    char        config[64];
+    TEST_ASSERT_NOT_NULL(sink);
+
+    // Only scores reaching the minimum are printed, but every score is counted
+    score.score = 0.25f;
+    enigma_sink_write(sink, &score);
+    score.score = 0.75f;
+    score.flags = ENIGMA_FLAG_DICTIONARY_MATCH;
+    enigma_sink_write(sink, &score);
+    TEST_ASSERT_EQUAL_UINT(2, enigma_sink_get_count(sink));
+
+    enigma_print_config(&score.enigma, config);
+    sprintf(expected, "0.750000\tD\t%s\n", config);
+    rewind(file);
+    TEST_ASSERT_NOT_NULL(fgets(line, sizeof(line), file));
+    TEST_ASSERT_EQUAL_STRING(expected, line);
+    TEST_ASSERT_NULL(fgets(line, sizeof(line), file));
+
+    enigma_sink_free(sink);
+    fclose(file);
+}
+
+void test_enigma_sink_new_file_WithInvalidArguments(void) {
+    TEST_ASSERT_NULL(enigma_sink_new_file(NULL, 0.0f));
+}
+
+void test_enigma_sink_new_top_k(void) {
+    EnigmaScoreList list = { 0 };
+    EnigmaSink*     sink = enigma_sink_new_top_k(&list, 3);
+    TEST_ASSERT_NOT_NULL(sink);
+    TEST_ASSERT_EQUAL_INT(3, list.top_k);
+
+    for (int i = 0; i < 10; i++) {
+        score.score = (float) ((i * 7) % 10);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_SUCCESS, enigma_sink_write(sink, &score), success);
+    }
+    TEST_ASSERT_EQUAL_UINT(10, enigma_sink_get_count(sink));
+    TEST_ASSERT_EQUAL_INT(3, list.score_count);
+
+    enigma_score_list_sort(&list);
+    TEST_ASSERT_EQUAL_FLOAT(9.0f, list.scores[0].score);
+    TEST_ASSERT_EQUAL_FLOAT(8.0f, list.scores[1].score);
+    TEST_ASSERT_EQUAL_FLOAT(7.0f, list.scores[2].score);
+
+    enigma_sink_free(sink);
+    free(list.scores);
+}
+
+void test_enigma_sink_new_top_k_WithInvalidArguments(void) {
+    EnigmaScoreList list = { 0 };
+    TEST_ASSERT_NULL(enigma_sink_new_top_k(NULL, 3));
+    TEST_ASSERT_NULL(enigma_sink_new_top_k(&list, 0));
+}
+
+void test_enigma_sink_write_WithExecutor(void) {
+    EnigmaExecutor* executor = enigma_executor_new(THREAD_COUNT);
+    float           total    = 0.0f;
+    EnigmaSink*     sink     = enigma_sink_new(sum_scores, &total);
+
+    score.score              = 1.0f;
+    enigma_executor_run(executor, write_scores, sink);
+    TEST_ASSERT_EQUAL_UINT(THREAD_COUNT * WRITE_COUNT, enigma_sink_get_count(sink));
+    TEST_ASSERT_EQUAL_FLOAT((float) (THREAD_COUNT * WRITE_COUNT), total);
+
+    enigma_sink_free(sink);
+    enigma_executor_free(executor);
+}
+
+void test_enigma_sink_write_WithInvalidArguments(void) {
+    EnigmaSink* sink = enigma_sink_new_count();
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_sink_write(NULL, &score), failure);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_sink_write(sink, NULL), failure);
+    TEST_ASSERT_EQUAL_UINT(0, enigma_sink_get_count(sink));
+    enigma_sink_free(sink);
+}
+
+void test_enigma_sink_free_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(ENIGMA_FAILURE, enigma_sink_free(NULL), failure);
+}
+
+void test_enigma_sink_get_count_WithInvalidArguments(void) {
+    TEST_ASSERT_EQUAL_UINT(0, enigma_sink_get_count(NULL));
+    TEST_ASSERT_NULL(enigma_sink_get_data(NULL));
+}
@@ -18,10 +18,15 @@ int         main(int argc, char* argv[]) {
 
     // Parse command line options
     char* rotorpos = NULL;
-    while ((opt = getopt(argc, argv, "s:p:u:w:rv")) != -1) {
+    char* rings    = NULL;
+    while ((opt = getopt(argc, argv, "g:s:p:u:w:rv")) != -1) {
         switch (opt) {
+        case 'g':
+            rings = optarg;
+            break;
         case 's':
-            strcpy(enigma.plugboard, optarg);
+            if (enigma_load_plugboard_config(&enigma, optarg))
+                print_usage(argv[0]);
             break;
         case 'p':
             rotorpos = optarg;
@@ -51,6 +56,11 @@ int         main(int argc, char* argv[]) {
         exit(EXIT_FAILURE);
     }
 
+    if (rings && enigma_load_ring_settings(&enigma, rings)) {
+        print_usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
     enigma_print_config(&enigma, buf);
     printf("%s\n", buf);
 
@@ -87,8 +97,11 @@ int         main(int argc, char* argv[]) {
  * @param argv0 The name of the program, typically `argv[0]`.
  */
 static void print_usage(const char* argv0) {
-    fprintf(stderr, "Usage: %s [-p positions] [-s plugboard] [-u reflector] [-w rotors]\n", argv0);
+    fprintf(stderr,
+            "Usage: %s [-g rings] [-p positions] [-s plugboard] [-u reflector] [-w rotors]\n",
+            argv0);
     fprintf(stderr, "Options:\n");
+    fprintf(stderr, "  -g rings       Set the ring settings (Ringstellung) (e.g., 'AAB')\n");
     fprintf(stderr, "  -p positions    Set the initial position of the rotors (e.g., 'ABC')\n");
     fprintf(stderr,
             "  -s plugboard   Set the plugboard (Steckerbrett) configuration (e.g., 'ABCDEF')\n");
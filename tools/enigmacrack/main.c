@@ -1,9 +1,14 @@
 #include "enigma/common.h"
 #include "enigma/crack.h"
 #include "enigma/enigma.h"
+#include "enigma/executor.h"
 #include "enigma/io.h"
 #include "enigma/ioc.h"
 #include "enigma/ngram.h"
+#include "enigma/plugboard.h"
+#include "enigma/process.h"
+#include "enigma/sink.h"
+#include "monitor.h"
 #include "shell.h"
 
 #include <ctype.h>
@@ -13,32 +18,70 @@
 #include <string.h>
 #include <unistd.h>
 
+#ifdef ENIGMA_PROCESSES
+#include <sys/mman.h>
+
+#define PROCESS_OPTION "P:"
+#define PROCESS_USAGE                                                                              \
+    "        -P processes   Number of processes to search on, each with -j threads (default 1,\n\
+                       requires -k)\n"
+#else
+#define PROCESS_OPTION ""
+#define PROCESS_USAGE  ""
+#endif
+
+#define OPTSTRING "w:p:g:u:s:b:c:d:i:j:k:l:m:M:n:o:f:" PROCESS_OPTION "S:t:x"
+
 #define USAGE                                                                                      \
     "Usage: %s method target [options] ciphertext\n\
     Tip: run this binary with 'shell' to start the interactive shell.\n\n\
     Methods:\n\
-      ioc              Use Index of Coincidence for cryptanalysis (target, -m/-M OR -l required)\n\
-      ngram            Use n-gram analysis for cryptanalysis (target, -n, -m/-M required)\n\
+      ioc              Use Index of Coincidence for cryptanalysis (target required)\n\
+      ngram            Use n-gram analysis for cryptanalysis (target, -n required)\n\
     Targets:\n\
       rotor[1-3]       Crack a rotor (Walzen) configuration\n\
       rotors           Crack all rotor (Walzen) configurations\n\
       position[1-3]    Crack an initial rotor position\n\
       positions        Crack all initial rotor positions\n\
       reflector        Crack the reflector (Umkehrwalze) configuration\n\
-      plugboard        Crack a plugboard (Steckerbrett) setting\n\n\
+      rings            Crack the ring settings (Ringstellung) of the two fast rotors and the\n\
+                       middle rotor position around -p/-g\n\
+      plugboard        Crack a plugboard (Steckerbrett) setting\n\
+      climb            Crack the whole plugboard (Steckerbrett) by hill climbing from -s\n\
+      anneal           Crack the whole plugboard (Steckerbrett) by simulated annealing from\n\
+                       -s, restarted on -j threads, printing the best of each restart\n\
+      auto             Crack every setting not given with -w/-p/-u/-s, in stages (the\n\
+                       plugboard is scored with -n if given, by IOC otherwise)\n\n\
     Options:\n\
       Enigma Settings:\n\
         -w rotors      Set the rotor (Walzen) configuration (e.g. 'I II III')\n\
         -p positions   Set the initial rotor positions (e.g. 'ABC')\n\
+        -g rings       Set the ring settings (Ringstellung) (e.g. 'ABC', default 'AAA')\n\
         -u reflector   Set the reflector (Umkehrwalze) (e.g. 'B')\n\
         -s plugboard   Set the plugboard (Steckerbrett) configuration (e.g. 'ABCDEF')\n\
       Cryptanalysis Settings:\n\
+        -b count       Number of configurations the auto target and -i keep (beam width,\n\
+                       default 10)\n\
         -c plaintext   Set the known plaintext\n\
         -d file        Set the dictionary file to use\n\
-        -l language    Language ('english' or 'german', for IOC method)\n\
-        -m float       Minimum score threshold\n\
-        -M float       Maximum score threshold\n\
+        -i file        Run the target from each configuration printed by a previous run,\n\
+                       instead of from -w/-p/-u/-s, keeping the best -b overall\n\
+        -j threads     Number of threads to search on (default 1)\n" PROCESS_USAGE "\
+        -k count       Only keep and print the best count configurations\n\
+        -l language    Language ('english' or 'german', IOC bounds for IOC method)\n\
+        -m float       Minimum score to keep (with -M)\n\
+        -M float       Maximum score to keep (with -m)\n\
         -n file        n-gram bank to load\n\
+        -o file        Write configurations to a file as they are found, instead of printing\n\
+                       them at the end\n\
+        -S file        Save the search progress to a file every minute, resuming from it if\n\
+                       it exists\n\
+        --shard i/N    Only search shard i of N (1 to N) of the keyspace, e.g. on one of N\n\
+                       machines (see enigmamerge)\n\
+        --restarts n   Number of anneal restarts (default 32)\n\
+        --steps n      Number of moves tried by each anneal restart (default 20000)\n\
+        --seed n       Seed of the anneal moves (default 0)\n\
+        -t float       Stop once a configuration reaches this score\n\
         -x             Assume X-separated words in plaintext\n\n\
     A file can be provided as the last argument to read the ciphertext from a file.\n\
     If no file is provided, the ciphertext will be read from standard input.\n\n\
@@ -46,13 +89,40 @@
     be all uppercase\n\n\
     Available languages: english, german\n\
     Available rotors: I, II, III, IV, V, VI, VII, VIII\n\
-    Available reflectors: A, B, C\n"
+    Available reflectors: A, B, C\n\n\
+    On a terminal, the search rate and estimated time left are shown on standard error.\n\
+    Interrupting the search (Ctrl-C) stops it and prints the configurations found so far\n\
+    (and saves them with -S); interrupt it again to exit at once.\n"
+
+/**
+ * @brief The crack function call selected on the command line.
+ */
+typedef struct {
+    int target; //!< One of the TARGET_ constants.
+    int param; //!< Rotor number of the rotor and position targets (1-3).
+    float (*score_func)(const EnigmaCrackParams*, const char*); //!< The method's score function.
+    int threads; //!< Number of threads to search on.
+    int defined; //!< Settings given on the command line, for the auto target.
+    int width; //!< Configurations kept by the auto target and by a beam search step.
+    const EnigmaScoreList* seeds; //!< Configurations to run the target from, or NULL.
+    EnigmaAnnealParams     anneal; //!< Settings of the anneal target.
+} CrackJob;
+
+static void             clean_exit(const char*, const char*, EnigmaCrackParams*, int);
+static void             free_dictionary_node(EnigmaTrie*);
+static void             load_frequencies(EnigmaCrackParams*, const char*);
+static int              load_language(const char*, float*, float*);
+static int              load_seeds(EnigmaScoreList*, const char*);
+static void             load_target(EnigmaCrackParams*, const char*);
+static int              run_crack(EnigmaCrackParams*, void*);
+static EnigmaCrackStage target_stage(int);
+
+#define CHECKPOINT_INTERVAL 60
 
-static void clean_exit(const char*, const char*, EnigmaCrackParams*, int);
-static void free_dictionary_node(EnigmaTrie*);
-static void load_frequencies(EnigmaCrackParams*, const char*);
-static int  load_language(EnigmaCrackParams*, const char*);
-static void load_target(EnigmaCrackParams*, const char*);
+#define OPT_SHARD    256
+#define OPT_RESTARTS 257
+#define OPT_STEPS    258
+#define OPT_SEED     259
 
 #define METHOD_IOC   1
 #define METHOD_NGRAM 2
@@ -69,6 +139,14 @@ static void load_target(EnigmaCrackParams*, const char*);
 #define TARGET_REFLECTOR_S "reflector"
 #define TARGET_PLUGBOARD   6
 #define TARGET_PLUGBOARD_S "plugboard"
+#define TARGET_AUTO        7
+#define TARGET_AUTO_S      "auto"
+#define TARGET_CLIMB       8
+#define TARGET_CLIMB_S     "climb"
+#define TARGET_ANNEAL      9
+#define TARGET_ANNEAL_S    "anneal"
+#define TARGET_RINGS       10
+#define TARGET_RINGS_S     "rings"
 
 #define IS_TARGET(s) (!strncmp(argv[2], s, strlen(s)))
 
@@ -85,12 +163,23 @@ int main(int argc, char* argv[]) {
 
     EnigmaCrackParams* cfg = calloc(1, sizeof(EnigmaCrackParams));
     enigma_init_default_config(&cfg->enigma);
-    cfg->ciphertext          = argv[argc - 1];
-    cfg->ciphertext_length   = strlen(cfg->ciphertext);
-    cfg->enigma.plugboard[0] = '\0';
-    int method               = 0;
-    int target               = 0;
-    int param                = 0;
+    cfg->ciphertext           = argv[argc - 1];
+    cfg->ciphertext_length    = strlen(cfg->ciphertext);
+    cfg->enigma.plugboard[0]  = '\0';
+    int method                = 0;
+    int target                = 0;
+    int param                 = 0;
+    int threads               = 1;
+    int processes             = 1;
+    int topK                  = 0;
+    int defined               = 0;
+    int width                 = ENIGMA_CRACK_BEAM_WIDTH;
+    EnigmaScoreList seeds     = { 0 };
+    EnigmaAnnealParams anneal = { 0 };
+    const char* output        = NULL;
+    const char* checkpoint    = NULL;
+    float languageMin         = 0.0f;
+    float languageMax         = 0.0f;
 
     // Convert ciphertext to uppercase
     for (size_t i = 0; i < cfg->ciphertext_length; i++) {
@@ -149,6 +238,14 @@ int main(int argc, char* argv[]) {
         target = TARGET_REFLECTOR;
     } else if (IS_TARGET(TARGET_PLUGBOARD_S)) {
         target = TARGET_PLUGBOARD;
+    } else if (IS_TARGET(TARGET_AUTO_S)) {
+        target = TARGET_AUTO;
+    } else if (IS_TARGET(TARGET_CLIMB_S)) {
+        target = TARGET_CLIMB;
+    } else if (IS_TARGET(TARGET_ANNEAL_S)) {
+        target = TARGET_ANNEAL;
+    } else if (IS_TARGET(TARGET_RINGS_S)) {
+        target = TARGET_RINGS;
     } else {
         fprintf(stderr, "Unknown target: %s\n", argv[2]);
         fprintf(stderr, USAGE, argv[0]);
@@ -157,20 +254,47 @@ int main(int argc, char* argv[]) {
     }
 
     optind += 2;
+    static const struct option longOptions[] = {
+        { "shard", required_argument, NULL, OPT_SHARD },
+        { "restarts", required_argument, NULL, OPT_RESTARTS },
+        { "steps", required_argument, NULL, OPT_STEPS },
+        { "seed", required_argument, NULL, OPT_SEED },
+        { NULL, 0, NULL, 0 },
+    };
     int opt;
-    while ((opt = getopt(argc, argv, "w:p:u:s:c:d:l:m:M:n:f:x")) != -1) {
+    int shard;
+    int shardCount;
+    while ((opt = getopt_long(argc, argv, OPTSTRING, longOptions, NULL)) != -1) {
         switch (opt) {
         case 'w':
             enigma_load_rotor_config(&cfg->enigma, optarg);
+            defined |= ENIGMA_ROTORS_DEFINED;
             break;
         case 'p':
             enigma_load_rotor_positions(&cfg->enigma, optarg);
+            defined |= ENIGMA_ROTOR_POSITIONS_DEFINED;
+            break;
+        case 'g':
+            if (enigma_load_ring_settings(&cfg->enigma, optarg)) {
+                clean_exit("Error: -g requires one letter per rotor\n", argv[0], cfg, 1);
+            }
             break;
         case 'u':
             enigma_load_reflector_config(&cfg->enigma, optarg);
+            defined |= ENIGMA_REFLECTOR_DEFINED;
             break;
         case 's':
-            strcpy(cfg->enigma.plugboard, optarg);
+            enigma_load_plugboard_config(&cfg->enigma, optarg);
+            defined |= ENIGMA_PLUGBOARD_DEFINED;
+            break;
+        case 'b':
+            width = atoi(optarg);
+            if (width < 1) {
+                clean_exit("Error: -b requires a positive number of configurations\n",
+                           argv[0],
+                           cfg,
+                           1);
+            }
             break;
         case 'c':
             cfg->flags |= ENIGMA_FLAG_KNOWN_PLAINTEXT;
@@ -182,8 +306,29 @@ int main(int argc, char* argv[]) {
                 clean_exit(NULL, argv[0], cfg, 1);
             }
             break;
+        case 'i':
+            if (load_seeds(&seeds, optarg)) {
+                fprintf(stderr, "Failed to load configurations from path: %s\n", optarg);
+                clean_exit(NULL, argv[0], cfg, 1);
+            }
+            break;
+        case 'j':
+            threads = atoi(optarg);
+            if (threads < 1) {
+                clean_exit("Error: -j requires a positive number of threads\n", argv[0], cfg, 1);
+            }
+            break;
+        case 'k':
+            topK = atoi(optarg);
+            if (topK < 1) {
+                clean_exit("Error: -k requires a positive number of configurations\n",
+                           argv[0],
+                           cfg,
+                           1);
+            }
+            break;
         case 'l':
-            if (load_language(cfg, optarg)) {
+            if (load_language(optarg, &languageMin, &languageMax)) {
                 fprintf(stderr, "Unknown language: %s\n", optarg);
                 clean_exit(NULL, argv[0], cfg, 1);
             }
@@ -197,103 +342,219 @@ int main(int argc, char* argv[]) {
         case 'n':
             enigma_load_ngrams(cfg, optarg);
             break;
+        case 'o':
+            output = optarg;
+            break;
         case 'f':
             load_frequencies(cfg, optarg);
             break;
+        case 'P':
+            processes = atoi(optarg);
+            if (processes < 1) {
+                clean_exit(
+                    "Error: -P requires a positive number of processes\n", argv[0], cfg, 1);
+            }
+            break;
+        case 'S':
+            checkpoint = optarg;
+            break;
+        case 't':
+            cfg->target_score = atof(optarg);
+            break;
         case 'x':
             cfg->flags |= ENIGMA_FLAG_X_SEPARATED;
             break;
+        case OPT_SHARD:
+            if (sscanf(optarg, "%d/%d", &shard, &shardCount) != 2
+                || enigma_crack_set_shard(cfg, shard - 1, shardCount)) {
+                clean_exit("Error: --shard requires a shard i/N with 1 <= i <= N\n",
+                           argv[0],
+                           cfg,
+                           1);
+            }
+            break;
+        case OPT_RESTARTS:
+        case OPT_STEPS:
+            if (atoi(optarg) < 1) {
+                clean_exit("Error: --restarts and --steps require a positive number\n",
+                           argv[0],
+                           cfg,
+                           1);
+            }
+            if (opt == OPT_RESTARTS) {
+                anneal.restarts = atoi(optarg);
+            } else {
+                anneal.steps = atoi(optarg);
+            }
+            break;
+        case OPT_SEED:
+            anneal.seed = strtoull(optarg, NULL, 10);
+            break;
         default:
             clean_exit("Error: Unknown option", argv[0], cfg, 1);
         }
     }
 
+    // The language ranges are IOC values that n-gram scores never fall in; -m/-M win over -l
+    if (languageMax > languageMin) {
+        if (method != METHOD_IOC) {
+            fprintf(stderr, "Warning: -l only applies to the IOC method, ignoring it\n");
+        } else if (cfg->max_score <= cfg->min_score) {
+            cfg->min_score = languageMin;
+            cfg->max_score = languageMax;
+        }
+    }
+
     cfg->score_list              = malloc(sizeof(EnigmaScoreList));
     cfg->score_list->scores      = malloc(100 * sizeof(EnigmaScore));
     cfg->score_list->score_count = 0;
     cfg->score_list->max_scores  = 100;
+    cfg->score_list->top_k       = topK;
 
-    if (method == METHOD_IOC) {
-        if (!cfg->min_score || !cfg->max_score) {
-            clean_exit("IOC method requires -m and -M options (or -l to set language)\n",
-                       argv[0],
-                       cfg,
-                       1);
+    // Line buffered, so that another process can follow the file while the search runs
+    FILE* outputFile = NULL;
+    if (output) {
+        outputFile = fopen(output, "w");
+        if (!outputFile) {
+            fprintf(stderr, "Failed to open output file: %s\n", output);
+            clean_exit(NULL, argv[0], cfg, 1);
         }
+        setvbuf(outputFile, NULL, _IOLBF, 0);
+        cfg->sink = enigma_sink_new_file(outputFile, cfg->min_score);
+    }
 
-        switch (target) {
-        case TARGET_ROTOR:
-            enigma_crack_rotor(cfg, param - 1, enigma_ioc_score);
-            break;
-        case TARGET_ROTORS:
-            enigma_crack_rotors(cfg, enigma_ioc_score);
-            break;
-        case TARGET_POSITION:
-            enigma_crack_rotor_position(cfg, param - 1, enigma_ioc_score);
-            break;
-        case TARGET_POSITIONS:
-            enigma_crack_rotor_positions(cfg, enigma_ioc_score);
-            break;
-        case TARGET_REFLECTOR:
-            enigma_crack_reflector(cfg, enigma_ioc_score);
-            break;
-        case TARGET_PLUGBOARD:
-            enigma_crack_plugboard(cfg, enigma_ioc_score);
-            break;
+    // An existing checkpoint resumes the search, which must have the same method and options
+    if (checkpoint) {
+        if (access(checkpoint, F_OK) == 0) {
+            cfg->checkpoint = enigma_checkpoint_load(checkpoint, CHECKPOINT_INTERVAL);
+        } else {
+            cfg->checkpoint = enigma_checkpoint_new(checkpoint, CHECKPOINT_INTERVAL);
+        }
+        if (!cfg->checkpoint) {
+            clean_exit(NULL, argv[0], cfg, 1);
         }
+    }
+
+    CrackJob job = { target, param, NULL, threads, defined, width, NULL, anneal };
+    if (seeds.score_count) {
+        job.seeds = &seeds;
+    }
+    if (method == METHOD_IOC) {
+        job.score_func = enigma_ioc_score;
     } else if (method == METHOD_NGRAM) {
         if (!cfg->ngrams) {
             clean_exit("N-gram method requires -n option\n", argv[0], cfg, 1);
         }
 
-        float (*scoreFunc)(const EnigmaCrackParams*, const char*) = NULL;
-
         switch (cfg->n) {
         case 2:
-            scoreFunc = enigma_bigram_score;
+            job.score_func = enigma_bigram_score;
             break;
         case 3:
-            scoreFunc = enigma_trigram_score;
+            job.score_func = enigma_trigram_score;
             break;
         case 4:
-            scoreFunc = enigma_quadgram_score;
+            job.score_func = enigma_quadgram_score;
             break;
         default:
             clean_exit("Invalid n-gram length. Must be between 2 and 4.\n", argv[0], cfg, 1);
         }
+    }
 
-        switch (target) {
-        case TARGET_ROTOR:
-            if (param < 1 || param > 3) {
-                clean_exit("Rotor target requires rotor number (1-3)\n", argv[0], cfg, 1);
-            }
-            enigma_crack_rotor(cfg, param - 1, scoreFunc);
-            break;
-        case TARGET_ROTORS:
-            enigma_crack_rotors(cfg, scoreFunc);
-            break;
-        case TARGET_POSITION:
-            if (param < 1 || param > 3) {
-                clean_exit("Position target requires rotor number (1-3)\n", argv[0], cfg, 1);
-            }
-            enigma_crack_rotor_position(cfg, param - 1, scoreFunc);
-            break;
-        case TARGET_POSITIONS:
-            enigma_crack_rotor_positions(cfg, scoreFunc);
-            break;
-        case TARGET_REFLECTOR:
-            enigma_crack_reflector(cfg, scoreFunc);
-            break;
-        case TARGET_PLUGBOARD:
-            enigma_crack_plugboard(cfg, scoreFunc);
-            break;
-        }
+    if (processes > 1 && (!topK || cfg->sink || cfg->checkpoint)) {
+        clean_exit(
+            "Error: -P requires -k, and cannot be used with -o or -S\n", argv[0], cfg, 1);
+    }
+    if ((target == TARGET_AUTO || target == TARGET_CLIMB || target == TARGET_ANNEAL)
+        && (processes > 1 || cfg->checkpoint || cfg->shard_count > 1)) {
+        clean_exit("Error: The auto, climb and anneal targets cannot be used with -P, -S or "
+                   "--shard\n",
+                   argv[0],
+                   cfg,
+                   1);
     }
+    if (job.seeds
+        && (!target_stage(target) || processes > 1 || cfg->checkpoint || cfg->shard_count > 1)) {
+        clean_exit("Error: -i requires the rotors, positions, reflector, rings, plugboard or "
+                   "climb target, and cannot be used with -P, -S or --shard\n",
+                   argv[0],
+                   cfg,
+                   1);
+    }
+
+#ifdef ENIGMA_PROCESSES
+    // Shared, so that the worker processes of -P update it and see its cancellation
+    EnigmaProgress* progress = mmap(NULL,
+                                    sizeof(EnigmaProgress),
+                                    PROT_READ | PROT_WRITE,
+                                    MAP_SHARED | MAP_ANONYMOUS,
+                                    -1,
+                                    0);
+    if (progress == MAP_FAILED) {
+        clean_exit("Failed to map the search progress\n", argv[0], cfg, 1);
+    }
+#else
+    EnigmaProgress* progress = malloc(sizeof(EnigmaProgress));
+    if (!progress) {
+        clean_exit("Failed to allocate the search progress\n", argv[0], cfg, 1);
+    }
+#endif
+    enigma_progress_reset(progress);
+    cfg->progress = progress;
+
+    Monitor monitor;
+    monitor_catch_interrupt(progress);
+    monitor_start(&monitor, progress);
+    if (processes > 1) {
+        enigma_process_crack(cfg, processes, run_crack, &job);
+    } else {
+        run_crack(cfg, &job);
+    }
+    monitor_stop(&monitor);
+    monitor_release_interrupt();
 
-    enigma_score_print(cfg->score_list);
+    int cancelled = enigma_progress_is_cancelled(progress);
+    if (cancelled) {
+        fprintf(stderr,
+                "Search interrupted after %zu of %zu candidates\n",
+                enigma_progress_get_searched(progress),
+                enigma_progress_get_total(progress));
+    }
 
+    // Bounds on the wrong scale drop every candidate, which would otherwise go unnoticed
+    size_t found = (size_t) cfg->score_list->score_count;
+    if (cfg->sink) {
+        found = enigma_sink_get_count(cfg->sink);
+    }
+    if (!found && !cancelled && target != TARGET_AUTO && cfg->max_score > cfg->min_score) {
+        fprintf(stderr,
+                "Warning: No configuration scored between %f and %f (-m/-M or -l)\n",
+                cfg->min_score,
+                cfg->max_score);
+    }
+
+    if (cfg->sink) {
+        fprintf(stderr, "%lu configurations found\n", enigma_sink_get_count(cfg->sink));
+        enigma_sink_free(cfg->sink);
+        fclose(outputFile);
+    } else {
+        if (topK || target == TARGET_AUTO || job.seeds) {
+            enigma_score_list_sort(cfg->score_list);
+        }
+        enigma_score_print(cfg->score_list);
+    }
+
+    if (cfg->checkpoint) {
+        enigma_checkpoint_free(cfg->checkpoint);
+    }
+#ifdef ENIGMA_PROCESSES
+    munmap(progress, sizeof(EnigmaProgress));
+#else
+    free(progress);
+#endif
+    free(seeds.scores);
     free(cfg);
-    return 0;
+    return cancelled ? 1 : 0;
 }
 
 static void clean_exit(const char* msg, const char* argv0, EnigmaCrackParams* cfg, int code) {
@@ -311,28 +572,168 @@ static void clean_exit(const char* msg, const char* argv0, EnigmaCrackParams* cf
 /**
  * @brief Load language settings.
  *
- * This function sets the minimum and maximum score thresholds based on the specified language.
- * Supports "english" and "german".
+ * This function gets the IOC range of the specified language, which main() uses as the score
+ * bounds of the IOC method unless -m and -M are given. Supports "english" and "german".
  *
- * @param config Pointer to the enigma_crack_config_t structure to update.
  * @param language The language to load settings for (e.g., "english").
+ * @param min Set to the minimum IOC of the language.
+ * @param max Set to the maximum IOC of the language.
  *
  * @return 0 on success, 1 if the language is not recognized.
  */
-static int load_language(EnigmaCrackParams* config, const char* language) {
+static int load_language(const char* language, float* min, float* max) {
     if (!strcmp(language, "english")) {
-        config->min_score = ENIGMA_IOC_ENGLISH_MIN;
-        config->max_score = ENIGMA_IOC_ENGLISH_MAX;
+        *min = ENIGMA_IOC_ENGLISH_MIN;
+        *max = ENIGMA_IOC_ENGLISH_MAX;
         return 0;
     } else if (!strcmp(language, "german")) {
-        config->min_score = ENIGMA_IOC_GERMAN_MIN;
-        config->max_score = ENIGMA_IOC_GERMAN_MAX;
+        *min = ENIGMA_IOC_GERMAN_MIN;
+        *max = ENIGMA_IOC_GERMAN_MAX;
         return 0;
     }
 
     return 1;
 }
 
+/**
+ * @brief Run the crack function selected on the command line.
+ *
+ * This is also the function run by each worker process with -P, so the executor for -j is
+ * created here, after the worker is forked.
+ *
+ * @param cfg The crack parameters.
+ * @param arg The CrackJob to run.
+ *
+ * @return The return value of the crack function.
+ */
+static int run_crack(EnigmaCrackParams* cfg, void* arg) {
+    const CrackJob* job = arg;
+    int             ret = 1;
+
+    if (job->threads > 1) {
+        cfg->executor = enigma_executor_new(job->threads);
+    }
+
+    if (job->seeds) {
+        ret = enigma_crack_beam(
+            cfg, job->seeds, job->width, target_stage(job->target), job->score_func);
+    } else {
+        switch (job->target) {
+        case TARGET_ROTOR:
+            ret = enigma_crack_rotor(cfg, job->param - 1, job->score_func);
+            break;
+        case TARGET_ROTORS:
+            ret = enigma_crack_rotors(cfg, job->score_func);
+            break;
+        case TARGET_POSITION:
+            ret = enigma_crack_rotor_position(cfg, job->param - 1, job->score_func);
+            break;
+        case TARGET_POSITIONS:
+            ret = enigma_crack_rotor_positions(cfg, job->score_func);
+            break;
+        case TARGET_REFLECTOR:
+            ret = enigma_crack_reflector(cfg, job->score_func);
+            break;
+        case TARGET_RINGS:
+            ret = enigma_crack_ring_settings(cfg, job->score_func);
+            break;
+        case TARGET_PLUGBOARD:
+            ret = enigma_crack_plugboard(cfg, job->score_func);
+            break;
+        case TARGET_AUTO:
+            ret = enigma_crack_auto(cfg, job->defined, job->width);
+            break;
+        case TARGET_CLIMB:
+            ret = enigma_crack_plugboard_climb(cfg, job->score_func);
+            break;
+        case TARGET_ANNEAL:
+            ret = enigma_crack_plugboard_anneal(cfg, &job->anneal, job->score_func);
+            break;
+        }
+    }
+
+    if (cfg->executor) {
+        enigma_executor_free(cfg->executor);
+        cfg->executor = NULL;
+    }
+    return ret;
+}
+
+/**
+ * @brief Load the configurations printed by a previous run, one per line after its score.
+ *
+ * Lines that do not start with a score, such as the summary of a run with -o, are skipped.
+ *
+ * @param seeds The list to append the configurations to.
+ * @param path The path of the file to read, or "-" for standard input.
+ *
+ * @return 0 on success, 1 on failure.
+ */
+static int load_seeds(EnigmaScoreList* seeds, const char* path) {
+    FILE* file = strcmp(path, "-") ? fopen(path, "r") : stdin;
+    if (!file) {
+        return 1;
+    }
+
+    char line[256];
+    int  ret = 0;
+    while (!ret && fgets(line, sizeof(line), file)) {
+        // Configuration lines are short; skip the rest of any line that does not fit
+        if (!strchr(line, '\n') && !feof(file)) {
+            int c;
+            while ((c = fgetc(file)) != '\n' && c != EOF) {
+            }
+            continue;
+        }
+
+        EnigmaScore seed = { 0 };
+        char*       end;
+        seed.score = strtof(line, &end);
+        if (end == line || *end != '\t') {
+            continue;
+        }
+
+        // The configuration is the last field, after the score and flags
+        char* config = strrchr(line, '\t') + 1;
+        config[strcspn(config, "\r\n")] = '\0';
+        enigma_init_default_config(&seed.enigma);
+        ret = enigma_load_config(&seed.enigma, config) || enigma_score_list_push(seeds, &seed);
+    }
+
+    if (ferror(file)) {
+        ret = 1;
+    }
+    if (file != stdin) {
+        fclose(file);
+    }
+    return ret;
+}
+
+/**
+ * @brief Get the crack function of a target that searches around the whole of `cfg->enigma`.
+ *
+ * @param target One of the TARGET_ constants.
+ *
+ * @return The crack function, or NULL for the targets that take a rotor number and auto.
+ */
+static EnigmaCrackStage target_stage(int target) {
+    switch (target) {
+    case TARGET_ROTORS:
+        return enigma_crack_rotors;
+    case TARGET_POSITIONS:
+        return enigma_crack_rotor_positions;
+    case TARGET_REFLECTOR:
+        return enigma_crack_reflector;
+    case TARGET_RINGS:
+        return enigma_crack_ring_settings;
+    case TARGET_PLUGBOARD:
+        return enigma_crack_plugboard;
+    case TARGET_CLIMB:
+        return enigma_crack_plugboard_climb;
+    }
+    return NULL;
+}
+
 static void load_frequencies(EnigmaCrackParams* config, const char* path) {
     // TODO Implement
     fprintf(stderr, "Frequency analysis not yet implemented.\n");
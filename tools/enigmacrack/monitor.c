@@ -0,0 +1,205 @@
+/**
+ * @file enigmacrack/monitor.c
+ *
+ * Live progress display and interrupt handling for enigmacrack searches.
+ *
+ * Windows has neither sigaction() nor the POSIX file descriptor calls, so there the handler is
+ * installed with signal(), which also resets it once it has run, and the line is written with
+ * the CRT's _write().
+ */
+#include "monitor.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <io.h>
+
+#define STDERR_FD    _fileno(stderr)
+#define isatty_fd(f) _isatty(f)
+#define write_fd     _write
+typedef void (*SignalHandler)(int);
+#else
+#include <unistd.h>
+
+#define STDERR_FD    STDERR_FILENO
+#define isatty_fd(f) isatty(f)
+#define write_fd     write
+typedef struct sigaction SignalHandler;
+#endif
+
+static void  format_count(double, char*, size_t);
+static void  format_duration(double, char*, size_t);
+static void  on_interrupt(int);
+static void  print_line(const EnigmaProgress*, int);
+static void* run_monitor(void*);
+
+static EnigmaProgress* g_interrupted;
+static SignalHandler   g_previous;
+
+void monitor_start(Monitor* monitor, EnigmaProgress* progress) {
+    monitor->progress = progress;
+    monitor->running  = 1;
+    monitor->active   = isatty_fd(STDERR_FD)
+                      && pthread_create(&monitor->thread, NULL, run_monitor, monitor) == 0;
+}
+
+void monitor_stop(Monitor* monitor) {
+    if (!monitor->active) {
+        return;
+    }
+
+    __atomic_store_n(&monitor->running, 0, __ATOMIC_RELAXED);
+    pthread_join(monitor->thread, NULL);
+    monitor->active = 0;
+    print_line(monitor->progress, 1);
+}
+
+void monitor_catch_interrupt(EnigmaProgress* progress) {
+    g_interrupted = progress;
+#ifdef _WIN32
+    g_previous = signal(SIGINT, on_interrupt);
+#else
+    struct sigaction action;
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = on_interrupt;
+    action.sa_flags   = SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, &g_previous);
+#endif
+}
+
+void monitor_release_interrupt(void) {
+#ifdef _WIN32
+    signal(SIGINT, g_previous == SIG_ERR ? SIG_DFL : g_previous);
+#else
+    sigaction(SIGINT, &g_previous, NULL);
+#endif
+    g_interrupted = NULL;
+}
+
+/**
+ * @brief Cancel the search on the first SIGINT; SA_RESETHAND lets the next one exit.
+ *
+ * @param sig The signal number.
+ */
+static void on_interrupt(int sig) {
+    if (g_interrupted) {
+        enigma_progress_cancel(g_interrupted);
+    }
+}
+
+/**
+ * @brief Print the progress line every MONITOR_INTERVAL_MS until the monitor is stopped.
+ *
+ * @param arg The Monitor.
+ * @return NULL.
+ */
+static void* run_monitor(void* arg) {
+    Monitor*        monitor = arg;
+    struct timespec tick    = { 0, 100 * 1000000L };
+    int             elapsed = 0;
+
+    while (__atomic_load_n(&monitor->running, __ATOMIC_RELAXED)) {
+        nanosleep(&tick, NULL);
+        elapsed += 100;
+        if (elapsed >= MONITOR_INTERVAL_MS) {
+            print_line(monitor->progress, 0);
+            elapsed = 0;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Overwrite the progress line on standard error.
+ *
+ * @param progress The progress to print.
+ * @param last 1 to end the line, for the final update.
+ */
+static void print_line(const EnigmaProgress* progress, int last) {
+    size_t total    = enigma_progress_get_total(progress);
+    size_t searched = enigma_progress_get_searched(progress);
+    double elapsed  = enigma_progress_get_elapsed(progress);
+    double percent  = total ? 100.0 * searched / total : 0.0;
+    char   rate[16];
+    char   chars[16];
+    char   duration[32];
+    char   line[160];
+
+    format_count(enigma_progress_get_rate(progress), rate, sizeof(rate));
+    format_count(elapsed > 0.0 ? enigma_progress_get_characters(progress) / elapsed : 0.0,
+                 chars,
+                 sizeof(chars));
+    if (last) {
+        format_duration(elapsed, duration, sizeof(duration));
+    } else {
+        format_duration(enigma_progress_get_eta(progress), duration, sizeof(duration));
+    }
+
+    int length = snprintf(line,
+                          sizeof(line),
+                          "\r%5.1f%%  %s candidates/s  %s chars/s  %s %s%s\033[K%s",
+                          percent,
+                          rate,
+                          chars,
+                          last ? "elapsed" : "ETA",
+                          duration,
+                          enigma_progress_is_cancelled(progress) ? "  (cancelled)" : "",
+                          last ? "\n" : "");
+    if (length < 0) {
+        return;
+    }
+
+    size_t written = 0;
+    size_t size    = (size_t) length < sizeof(line) ? (size_t) length : sizeof(line) - 1;
+    while (written < size) {
+        long n = write_fd(STDERR_FD, line + written, size - written);
+        if (n <= 0) {
+            break;
+        }
+        written += n;
+    }
+}
+
+/**
+ * @brief Format a count with a k, M or G suffix.
+ *
+ * @param value The count.
+ * @param buf The buffer to write to.
+ * @param size The size of the buffer.
+ */
+static void format_count(double value, char* buf, size_t size) {
+    const char* suffixes = " kMG";
+    int         i        = 0;
+
+    while (value >= 1000.0 && i < 3) {
+        value /= 1000.0;
+        i++;
+    }
+    if (i == 0) {
+        snprintf(buf, size, "%.0f", value);
+    } else {
+        snprintf(buf, size, "%.2f%c", value, suffixes[i]);
+    }
+}
+
+/**
+ * @brief Format a number of seconds as h:mm:ss.
+ *
+ * @param seconds The number of seconds, or a negative value if unknown.
+ * @param buf The buffer to write to.
+ * @param size The size of the buffer.
+ */
+static void format_duration(double seconds, char* buf, size_t size) {
+    if (seconds < 0.0) {
+        snprintf(buf, size, "-:--:--");
+        return;
+    }
+
+    long s = (long) (seconds + 0.5);
+    snprintf(buf, size, "%ld:%02ld:%02ld", s / 3600, s / 60 % 60, s % 60);
+}
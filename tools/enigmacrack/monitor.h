@@ -0,0 +1,61 @@
+/**
+ * @file enigmacrack/monitor.h
+ *
+ * Live progress display and interrupt handling for enigmacrack searches.
+ */
+#ifndef ENIGMA_CRACK_MONITOR_H
+#define ENIGMA_CRACK_MONITOR_H
+
+#include "enigma/progress.h"
+
+#include <pthread.h>
+
+/** Milliseconds between two updates of the progress line. */
+#define MONITOR_INTERVAL_MS 500
+
+/**
+ * @brief A thread printing the rate and ETA of a search to standard error.
+ *
+ * The line is only printed if standard error is a terminal.
+ */
+typedef struct {
+    EnigmaProgress* progress; //!< The progress of the search being displayed.
+    pthread_t       thread; //!< The display thread.
+    int             running; //!< Cleared to stop the display thread.
+    int             active; //!< 1 if the display thread was started.
+} Monitor;
+
+/**
+ * @brief Start displaying the progress of a search.
+ *
+ * The progress line is written with write(2) rather than stdio, so the display thread never
+ * holds a stdio lock that a forked worker process could inherit.
+ *
+ * @param monitor The monitor to start.
+ * @param progress The progress of the search.
+ */
+void monitor_start(Monitor* monitor, EnigmaProgress* progress);
+
+/**
+ * @brief Stop displaying the progress of a search, and print its final line.
+ *
+ * @param monitor The monitor to stop.
+ */
+void monitor_stop(Monitor* monitor);
+
+/**
+ * @brief Cancel a search on SIGINT instead of exiting.
+ *
+ * The first SIGINT cancels the search, which then returns the scores found so far; a second
+ * one exits as usual.
+ *
+ * @param progress The progress of the search to cancel.
+ */
+void monitor_catch_interrupt(EnigmaProgress* progress);
+
+/**
+ * @brief Restore the SIGINT handler replaced by monitor_catch_interrupt().
+ */
+void monitor_release_interrupt(void);
+
+#endif /* ENIGMA_CRACK_MONITOR_H */
@@ -16,11 +16,12 @@
  *   set cipher  <text>             Set ciphertext inline
  *   set rotors  <I II III>         Set rotor configuration
  *   set positions <ABC>            Set rotor starting positions
+ *   set rings <ABC>                Set ring settings
  *   set reflector <A|B|C>          Set reflector
  *   set plugboard <ABCD>           Set plugboard pairs
  *   attribute <name> on|off  attr  Toggle analysis attribute
  *     Names: r0 r1 r2 r3  r0p r1p r2p r3p  reflector  plugboard
- *   analyze                  an    Run analysis over varied attributes
+ *   analyze                  an    Run analysis over varied attributes (Ctrl-C stops it)
  *   show config              cfg   Show current Enigma + shell state
  *   show vary                vars  Show which attributes are varied
  *   show scores                    Same as 'score'
@@ -36,6 +37,7 @@
 #include "enigma/ioc.h"
 #include "enigma/ngram.h"
 #include "enigma/score.h"
+#include "monitor.h"
 
 #include <ctype.h>
 #include <stdio.h>
@@ -58,6 +60,8 @@ static char              g_cipher[SHELL_CIPHER_MAX];
 static int               g_method      = SHELL_METHOD_IOC;
 static int               g_vary        = 0;
 static int               g_freq_loaded = 0;
+static EnigmaProgress    g_progress;
+static Monitor           g_monitor;
 
 /* ─────────────────────────────────────────────────────────────────────────
  * Forward declarations
@@ -74,6 +78,9 @@ static void        cmd_show(const char*);
 static void        cmd_clear(const char*);
 static void        cmd_help(void);
 
+static void        stage_begin(void);
+static void        stage_end(void);
+
 static void        set_cipher_str(const char*);
 static void        set_cipher_file(const char*);
 static void        print_scores_top(int);
@@ -94,6 +101,7 @@ int start_shell(void) {
     g_cfg.score_list->scores      = malloc(INITIAL_SCORES * sizeof(EnigmaScore));
     g_cfg.score_list->score_count = 0;
     g_cfg.score_list->max_scores  = INITIAL_SCORES;
+    g_cfg.score_list->top_k       = SHELL_DISPLAY_SCORES;
 
     g_method                      = SHELL_METHOD_IOC;
     g_vary                        = 0;
@@ -282,7 +290,7 @@ static void cmd_set(const char* args) {
     if (!args || !*args) {
         printf("Usage: set <attribute> [value]\n");
         printf("Attributes: method, lang, minscore, maxscore, cipher, rotors,\n");
-        printf("            positions, reflector, plugboard\n");
+        printf("            positions, rings, reflector, plugboard\n");
         return;
     }
 
@@ -378,6 +386,17 @@ static void cmd_set(const char* args) {
             printf("Rotor positions set to: %s\n", val);
         }
 
+    } else if (!strcmp(attr, "rings") || !strcmp(attr, "g")) {
+        if (!val || !*val) {
+            printf("Usage: set rings <ABC>  (one letter per rotor, e.g. 'AAA')\n");
+            return;
+        }
+        if (enigma_load_ring_settings(&g_cfg.enigma, val)) {
+            printf("Error: invalid rings '%s'. Must be one alpha char per rotor.\n", val);
+        } else {
+            printf("Ring settings set to: %s\n", val);
+        }
+
     } else if (!strcmp(attr, "reflector") || !strcmp(attr, "refl") || !strcmp(attr, "u")) {
         if (!val || !*val) {
             printf("Usage: set reflector <A|B|C>\n");
@@ -404,7 +423,7 @@ static void cmd_set(const char* args) {
     } else {
         printf("Unknown attribute '%s'.\n", attr);
         printf("Valid: method, lang, minscore, maxscore, cipher, rotors, positions,\n");
-        printf("       reflector, plugboard\n");
+        printf("       rings, reflector, plugboard\n");
     }
 }
 
@@ -491,8 +510,21 @@ static void cmd_analyze(void) {
 
     g_cfg.score_list->score_count = 0;
 
-    int rotor_count               = g_cfg.enigma.rotor_count;
-    int analyzed                  = 0;
+    /* The score range is an IOC range, so it must not drop n-gram scores */
+    float min_score               = g_cfg.min_score;
+    float max_score               = g_cfg.max_score;
+    if (g_method == SHELL_METHOD_NGRAM) {
+        g_cfg.min_score = 0.0f;
+        g_cfg.max_score = 0.0f;
+    }
+
+    int rotor_count = g_cfg.enigma.rotor_count;
+    int analyzed    = 0;
+
+    /* Ctrl-C stops the analysis and keeps the scores found so far */
+    enigma_progress_reset(&g_progress);
+    g_cfg.progress = &g_progress;
+    monitor_catch_interrupt(&g_progress);
 
     /* ── Rotor identity ── */
     int r_on[4] = {
@@ -513,12 +545,16 @@ static void cmd_analyze(void) {
     if (any_rotor) {
         if (all_rotors_on) {
             printf("  Cracking all %d rotor slots (exhaustive)...\n", rotor_count);
+            stage_begin();
             enigma_crack_rotors(&g_cfg, scoreFunc);
+            stage_end();
         } else {
             for (int i = 0; i < 4; i++) {
                 if (r_on[i]) {
                     printf("  Cracking rotor in slot %d...\n", i);
+                    stage_begin();
                     enigma_crack_rotor(&g_cfg, i, scoreFunc);
+                    stage_end();
                 }
             }
         }
@@ -544,12 +580,16 @@ static void cmd_analyze(void) {
     if (any_pos) {
         if (all_pos_on) {
             printf("  Cracking all %d rotor positions (exhaustive)...\n", rotor_count);
+            stage_begin();
             enigma_crack_rotor_positions(&g_cfg, scoreFunc);
+            stage_end();
         } else {
             for (int i = 0; i < 4; i++) {
                 if (rp_on[i]) {
                     printf("  Cracking starting position of slot %d...\n", i);
+                    stage_begin();
                     enigma_crack_rotor_position(&g_cfg, i, scoreFunc);
+                    stage_end();
                 }
             }
         }
@@ -559,23 +599,36 @@ static void cmd_analyze(void) {
     /* ── Reflector ── */
     if (g_vary & SHELL_VARY_REFLECTOR) {
         printf("  Cracking reflector...\n");
+        stage_begin();
         enigma_crack_reflector(&g_cfg, scoreFunc);
+        stage_end();
         analyzed = 1;
     }
 
     /* ── Plugboard ── */
     if (g_vary & SHELL_VARY_PLUGBOARD) {
         printf("  Cracking plugboard...\n");
+        stage_begin();
         enigma_crack_plugboard(&g_cfg, scoreFunc);
+        stage_end();
         analyzed = 1;
     }
 
+    g_cfg.min_score = min_score;
+    g_cfg.max_score = max_score;
+    g_cfg.progress  = NULL;
+    monitor_release_interrupt();
+
     if (!analyzed) {
         printf("Nothing to analyze.\n");
         return;
     }
 
-    printf("Analysis complete. %d configuration(s) evaluated.\n\n", g_cfg.score_list->score_count);
+    if (enigma_progress_is_cancelled(&g_progress)) {
+        printf("Analysis interrupted.\n\n");
+    } else {
+        printf("Analysis complete.\n\n");
+    }
     print_scores_top(SHELL_DISPLAY_SCORES);
 }
 
@@ -667,6 +720,7 @@ static void cmd_help(void) {
            "  set cipher  <text>                       Ciphertext (inline)\n"
            "  set rotors  <I II III>                   Rotor configuration\n"
            "  set positions <ABC>                      Rotor starting positions\n"
+           "  set rings   <ABC>                        Ring settings (Ringstellung)\n"
            "  set reflector <A|B|C>                    Reflector (UKW)\n"
            "  set plugboard <ABCD>                     Plugboard pairs\n\n"
            "Vary attributes  (attribute / attr):\n"
@@ -677,7 +731,8 @@ static void cmd_help(void) {
            "  When ALL slots for the current rotor count are ON, an exhaustive\n"
            "  combined search is used; otherwise each slot is cracked independently.\n\n"
            "Analysis:\n"
-           "  analyze  an   Crack all varied attributes; show top 10 results\n\n"
+           "  analyze  an   Crack all varied attributes; show top 10 results\n"
+           "                (Ctrl-C stops the analysis and keeps its results)\n\n"
            "Display:\n"
            "  score    sc              Top 10 scores from last analysis\n"
            "  show config    cfg       Enigma + shell state\n"
@@ -689,6 +744,32 @@ static void cmd_help(void) {
            "  exit  quit q Quit\n");
 }
 
+/* ─────────────────────────────────────────────────────────────────────────
+ * Analysis stages
+ * ───────────────────────────────────────────────────────────────────────── */
+
+/**
+ * @brief Display the progress of a crack function call of 'analyze'.
+ *
+ * The counters start over for each stage, so the rate and ETA are those of the stage. A stage
+ * started after Ctrl-C was pressed runs nothing.
+ */
+static void stage_begin(void) {
+    int cancelled = enigma_progress_is_cancelled(&g_progress);
+
+    fflush(stdout);
+    enigma_progress_reset(&g_progress);
+    if (cancelled) {
+        enigma_progress_cancel(&g_progress);
+    }
+    monitor_start(&g_monitor, &g_progress);
+}
+
+/**
+ * @brief Stop displaying the progress of a stage started with stage_begin().
+ */
+static void stage_end(void) { monitor_stop(&g_monitor); }
+
 /* ─────────────────────────────────────────────────────────────────────────
  * Internal helpers
  * ───────────────────────────────────────────────────────────────────────── */
@@ -0,0 +1,196 @@
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define USAGE                                                                                      \
+    "Usage: %s [-k count] file...\n\
+    Merge the configurations printed by enigmacrack runs, e.g. one per --shard, into a single\n\
+    list sorted by score. Lines that do not start with a score are skipped.\n\n\
+    Options:\n\
+      -k count       Only print the best count configurations\n"
+
+/**
+ * @brief A configuration line read from an enigmacrack output.
+ */
+typedef struct {
+    char*  text; //!< The line, including its newline.
+    float  score; //!< The score the line starts with.
+    size_t order; //!< Index of the line among all the lines read, to keep the sort stable.
+} MergeLine;
+
+/**
+ * @brief The lines read from every input.
+ */
+typedef struct {
+    MergeLine* lines; //!< The lines read.
+    size_t     count; //!< Number of lines read.
+    size_t     capacity; //!< Number of lines allocated.
+} MergeList;
+
+static int  compare_lines(const void*, const void*);
+static int  read_line(char**, size_t*, FILE*);
+static int  read_lines(MergeList*, FILE*);
+static void print_usage(const char*);
+
+int         main(int argc, char* argv[]) {
+    MergeList list = { 0 };
+    long      topK = 0;
+    int       opt;
+
+    while ((opt = getopt(argc, argv, "k:")) != -1) {
+        switch (opt) {
+        case 'k':
+            topK = atol(optarg);
+            if (topK < 1) {
+                fprintf(stderr, "Error: -k requires a positive number of configurations\n");
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        default:
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (optind >= argc) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int ret = EXIT_SUCCESS;
+    for (int i = optind; i < argc && ret == EXIT_SUCCESS; i++) {
+        FILE* file = strcmp(argv[i], "-") ? fopen(argv[i], "r") : stdin;
+        if (!file) {
+            fprintf(stderr, "Failed to open file: %s\n", argv[i]);
+            ret = EXIT_FAILURE;
+            break;
+        }
+        if (read_lines(&list, file)) {
+            fprintf(stderr, "Failed to read file: %s\n", argv[i]);
+            ret = EXIT_FAILURE;
+        }
+        if (file != stdin) {
+            fclose(file);
+        }
+    }
+
+    if (ret == EXIT_SUCCESS) {
+        qsort(list.lines, list.count, sizeof(MergeLine), compare_lines);
+        size_t count = topK && (size_t) topK < list.count ? (size_t) topK : list.count;
+        for (size_t i = 0; i < count; i++) {
+            const char* text = list.lines[i].text;
+            fputs(text, stdout);
+            if (text[strlen(text) - 1] != '\n') {
+                fputc('\n', stdout);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < list.count; i++) {
+        free(list.lines[i].text);
+    }
+    free(list.lines);
+    return ret;
+}
+
+/**
+ * @brief Order lines by descending score, then in the order they were read.
+ *
+ * @param a The first MergeLine.
+ * @param b The second MergeLine.
+ * @return Negative if a comes first, positive if b comes first.
+ */
+static int compare_lines(const void* a, const void* b) {
+    const MergeLine* la = a;
+    const MergeLine* lb = b;
+
+    if (la->score != lb->score) {
+        return la->score > lb->score ? -1 : 1;
+    }
+    return la->order < lb->order ? -1 : 1;
+}
+
+/**
+ * @brief Read a whole line, growing the buffer as needed.
+ *
+ * This reads with fgets() rather than getline(), which the Windows C runtime does not have.
+ *
+ * @param line The buffer, reallocated as needed (NULL to allocate one).
+ * @param capacity The size of the buffer.
+ * @param file The file to read.
+ * @return 1 if a line was read, 0 at the end of the file, -1 on failure.
+ */
+static int read_line(char** line, size_t* capacity, FILE* file) {
+    size_t length = 0;
+
+    while (1) {
+        if (*capacity - length < 2) {
+            size_t grown  = *capacity ? *capacity * 2 : 256;
+            char*  buffer = realloc(*line, grown);
+            if (!buffer) {
+                return -1;
+            }
+            *line     = buffer;
+            *capacity = grown;
+        }
+
+        if (!fgets(*line + length, (int) (*capacity - length), file)) {
+            return length ? 1 : 0;
+        }
+        length += strlen(*line + length);
+        if ((*line)[length - 1] == '\n') {
+            return 1;
+        }
+    }
+}
+
+/**
+ * @brief Read the configuration lines of an enigmacrack output.
+ *
+ * @param list The list to append the lines to.
+ * @param file The file to read.
+ * @return 0 on success, 1 on failure.
+ */
+static int read_lines(MergeList* list, FILE* file) {
+    char*  line     = NULL;
+    size_t capacity = 0;
+    int    ret;
+
+    while ((ret = read_line(&line, &capacity, file)) == 1) {
+        char* end;
+        float score = strtof(line, &end);
+        if (end == line || *end != '\t') {
+            continue;
+        }
+
+        if (list->count == list->capacity) {
+            size_t     grown = list->capacity ? list->capacity * 2 : 256;
+            MergeLine* lines = realloc(list->lines, grown * sizeof(MergeLine));
+            if (!lines) {
+                free(line);
+                return 1;
+            }
+            list->lines    = lines;
+            list->capacity = grown;
+        }
+
+        MergeLine* merged = &list->lines[list->count];
+        merged->text      = line;
+        merged->score     = score;
+        merged->order     = list->count++;
+        line              = NULL;
+        capacity          = 0;
+    }
+
+    free(line);
+    return ret < 0 || ferror(file) ? 1 : 0;
+}
+
+/**
+ * @brief Print usage information for enigmamerge.
+ *
+ * @param argv0 The name of the program, typically `argv[0]`.
+ */
+static void print_usage(const char* argv0) { fprintf(stderr, USAGE, argv0); }
@@ -0,0 +1,107 @@
+/**
+ * @file kernelgen/main.c
+ *
+ * Build-time generator for the encode kernels in enigma/kernel.c.
+ *
+ * This program reads the rotor tables in enigma/rotor.h and writes a header with each rotor's
+ * wiring expanded for every rotor position, the turnover masks, and the list of rotor orders
+ * to build a kernel for. It is run by the build, so the kernels always match the rotors.
+ */
+#include "enigma/rotor.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static void print_table(FILE*, const char*, int);
+static int  pass(const int*, int, int);
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s output_file\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    FILE* out = fopen(argv[1], "w");
+    if (!out) {
+        perror(argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    fprintf(out, "/* Generated by kernelgen from enigma/rotor.h. Do not edit. */\n");
+    fprintf(out, "#ifndef ENIGMA_KERNEL_TABLES_H\n#define ENIGMA_KERNEL_TABLES_H\n\n");
+    fprintf(out, "#include <stdint.h>\n\n");
+
+    print_table(out, "enigma_kernel_fwd", 0);
+    print_table(out, "enigma_kernel_rev", 1);
+
+    fprintf(out, "static const uint32_t enigma_kernel_turnovers[%d] = {", ENIGMA_ROTOR_COUNT);
+    for (int r = 0; r < ENIGMA_ROTOR_COUNT; r++) {
+        fprintf(out, "%s0x%08x", r ? ", " : " ", (unsigned int) enigma_rotors[r]->turnovers);
+    }
+    fprintf(out, " };\n\n");
+
+    // Rotor orders for the three stepping rotors; a rotor is only used once per machine
+    fprintf(out, "#define ENIGMA_KERNEL_ORDERS");
+    for (int a = 0; a < ENIGMA_ROTOR_COUNT; a++) {
+        for (int b = 0; b < ENIGMA_ROTOR_COUNT; b++) {
+            for (int c = 0; c < ENIGMA_ROTOR_COUNT; c++) {
+                if (a != b && a != c && b != c) {
+                    fprintf(out, " \\\n    ENIGMA_KERNEL_ORDER(%d, %d, %d)", a, b, c);
+                }
+            }
+        }
+    }
+    fprintf(out, "\n\n#endif\n");
+
+    if (fclose(out)) {
+        perror(argv[1]);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Print the wiring of every rotor at every position.
+ *
+ * Entry [r][p][c] is the letter index that `c` leaves rotor `r` at position `p` as.
+ *
+ * @param out The file to print to.
+ * @param name The name of the table.
+ * @param reverse Whether to print the reverse (reflector to entry wheel) wiring.
+ */
+static void print_table(FILE* out, const char* name, int reverse) {
+    fprintf(out,
+            "static const uint8_t %s[%d][%d][%d] = {\n",
+            name,
+            ENIGMA_ROTOR_COUNT,
+            ENIGMA_ALPHA_SIZE,
+            ENIGMA_ALPHA_SIZE);
+    for (int r = 0; r < ENIGMA_ROTOR_COUNT; r++) {
+        const int* indices
+            = reverse ? enigma_rotors[r]->rev_indices : enigma_rotors[r]->fwd_indices;
+
+        fprintf(out, "    { /* %s */\n", enigma_rotors[r]->name);
+        for (int p = 0; p < ENIGMA_ALPHA_SIZE; p++) {
+            fprintf(out, "        {");
+            for (int c = 0; c < ENIGMA_ALPHA_SIZE; c++) {
+                fprintf(out, "%s%2d", c ? ", " : " ", pass(indices, p, c));
+            }
+            fprintf(out, " },\n");
+        }
+        fprintf(out, "    },\n");
+    }
+    fprintf(out, "};\n\n");
+}
+
+/**
+ * @brief Pass a letter index through rotor wiring at a position.
+ *
+ * @param indices The rotor wiring.
+ * @param position The rotor position.
+ * @param c The letter index entering the rotor.
+ * @return The letter index leaving the rotor.
+ */
+static int pass(const int* indices, int position, int c) {
+    return (indices[(c + position) % ENIGMA_ALPHA_SIZE] - position + ENIGMA_ALPHA_SIZE)
+         % ENIGMA_ALPHA_SIZE;
+}